@@ -20,6 +20,8 @@
 #define _CGPR_NET_CINTERFACE_H_
 
 #include <cgpr/util/list.h>
+#include <cgpr/util/mutex.h>
+#include <cgpr/util/rwlock.h>
 #include <cgpr/util/string.h>
 
 #include <cgpr/net/typedef.h>
@@ -45,6 +47,8 @@ extern "C" {
 #define CG_NET_IPV6_LOOPBACK "fixmelater"
 #define CG_NET_MACADDR_SIZE 6
 
+#define CG_NET_ADDRSTRING_MAXSIZE 64
+
 /****************************************
  * Data Type
  ****************************************/
@@ -59,6 +63,23 @@ typedef struct {
   int index;
 } CGNetworkInterface, CGNetworkInterfaceList;
 
+struct _CGNetworkPrefixTrie;
+
+/**
+ * \brief A longest-prefix-match table over the address/netmask pairs of
+ * the local interfaces.
+ *
+ * Lookups answer which local address faces a remote address in
+ * O(prefix length) without any string conversion. The table is rebuilt
+ * into a new trie and swapped in under the write lock, so readers always
+ * see either the old or the new interface set and never wait for each
+ * other.
+ */
+typedef struct {
+  CGRWLock* rwlock;
+  struct _CGNetworkPrefixTrie* trie;
+} CGNetworkPrefixTable;
+
 /****************************************
  * Function (NetworkInterface)
  ****************************************/
@@ -77,6 +98,7 @@ char* cg_net_interface_getaddress(CGNetworkInterface* netIf);
 void cg_net_interface_setnetmask(CGNetworkInterface* netIf, char* ipaddr);
 char* cg_net_interface_getnetmask(CGNetworkInterface* netIf);
 char* cg_net_selectaddr(struct sockaddr* remoteaddr);
+bool cg_net_selectaddrto(struct sockaddr* remoteaddr, char* addrBuf, size_t addrBufLen);
 
 #define cg_net_interface_setmacaddress(netIf, value) memcpy(netIf->macaddr, value, CG_NET_MACADDR_SIZE)
 #define cg_net_interface_getmacaddress(netIf, buf) memcpy(buf, netIf->macaddr, CG_NET_MACADDR_SIZE)
@@ -96,6 +118,19 @@ void cg_net_interfacelist_delete(CGNetworkInterfaceList* netIfList);
 #define cg_net_interfacelist_gets(netIfList) (CGNetworkInterface*)cg_list_next((CGList*)netIfList)
 #define cg_net_interfacelist_add(netIfList, netIf) cg_list_add((CGList*)netIfList, (CGList*)netIf)
 
+/****************************************
+ * Function (NetworkPrefixTable)
+ ****************************************/
+
+CGNetworkPrefixTable* cg_net_prefixtable_new(void);
+void cg_net_prefixtable_delete(CGNetworkPrefixTable* table);
+
+bool cg_net_prefixtable_setinterfaces(CGNetworkPrefixTable* table, CGNetworkInterfaceList* netIfList);
+bool cg_net_prefixtable_update(CGNetworkPrefixTable* table);
+size_t cg_net_prefixtable_size(CGNetworkPrefixTable* table);
+
+bool cg_net_prefixtable_lookup(CGNetworkPrefixTable* table, const struct sockaddr* remoteAddr, char* addrBuf, size_t addrBufLen, int* ifIndex);
+
 /****************************************
  * Function
  ****************************************/
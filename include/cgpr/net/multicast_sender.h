@@ -0,0 +1,78 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _CGPR_NET_MULTICAST_SENDER_H_
+#define _CGPR_NET_MULTICAST_SENDER_H_
+
+#include <cgpr/net/interface.h>
+#include <cgpr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct {
+  CGSocket* sock;
+  int family;
+  int ifIndex;
+} CGMulticastSenderInterface;
+
+/**
+ * \brief Sends one payload to a multicast group on many interfaces.
+ *
+ * Every interface gets its own datagram socket which is bound to the
+ * interface address and has the outgoing multicast interface, TTL and
+ * loopback preset once, so a send only costs one sendto() per interface.
+ */
+typedef struct {
+  CGMulticastSenderInterface* ifs;
+  size_t ifCnt;
+  size_t ifCapacity;
+  int ttl;
+  bool loop;
+} CGMulticastSender;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGMulticastSender* cg_multicast_sender_new(void);
+void cg_multicast_sender_delete(CGMulticastSender* sender);
+
+bool cg_multicast_sender_addinterface(CGMulticastSender* sender, CGNetworkInterface* netIf);
+size_t cg_multicast_sender_addinterfaces(CGMulticastSender* sender, CGNetworkInterfaceList* netIfList);
+void cg_multicast_sender_clear(CGMulticastSender* sender);
+
+bool cg_multicast_sender_setttl(CGMulticastSender* sender, int ttl);
+bool cg_multicast_sender_setloop(CGMulticastSender* sender, bool flag);
+
+#define cg_multicast_sender_size(sender) ((sender)->ifCnt)
+#define cg_multicast_sender_getttl(sender) ((sender)->ttl)
+#define cg_multicast_sender_isloop(sender) ((sender)->loop)
+
+size_t cg_multicast_sender_sendto(CGMulticastSender* sender, const char* mcastAddr, int port, const byte* data, size_t dataLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_MULTICAST_SENDER_H_
@@ -23,8 +23,12 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <stdint.h>
+
+#include <cgpr/net/interface.h>
 #include <cgpr/net/socket_opt.h>
 #include <cgpr/net/typedef.h>
+#include <cgpr/util/ring_buffer.h>
 #include <cgpr/util/string.h>
 
 #ifdef __cplusplus
@@ -57,6 +61,7 @@ typedef int SOCKET;
 #define CG_NET_SOCKET_MULTICAST_DEFAULT_TTL 4
 #define CG_NET_SOCKET_AUTO_IP_NET 0xa9fe0000
 #define CG_NET_SOCKET_AUTO_IP_MASK 0xffff0000
+#define CG_NET_SOCKET_ZEROCOPY_DEFAULT_THRESHOLD 16384
 
 /****************************************
  * Data Type
@@ -64,34 +69,150 @@ typedef int SOCKET;
 
 #include <cgpr/util/list.h>
 
+/**
+ * \brief I/O counters of a socket.
+ *
+ * The *Cnt members count system calls, the *Bytes members transferred
+ * payload bytes and the *Errors members failed calls. The counters are
+ * updated with relaxed atomics and are only meant for monitoring.
+ */
+typedef struct {
+  uint64_t readCnt;
+  uint64_t readBytes;
+  uint64_t readErrors;
+  uint64_t writeCnt;
+  uint64_t writeBytes;
+  uint64_t writeErrors;
+  uint64_t writeShortCnt;
+  uint64_t writeRetryCnt;
+  uint64_t sendtoCnt;
+  uint64_t sendtoBytes;
+  uint64_t sendtoErrors;
+  uint64_t recvCnt;
+  uint64_t recvBytes;
+  uint64_t recvErrors;
+  uint64_t recvTruncatedCnt;
+  uint64_t acceptCnt;
+  uint64_t acceptErrors;
+  uint64_t connectCnt;
+  uint64_t connectErrors;
+  uint64_t zerocopyCnt;
+  uint64_t zerocopyCopiedCnt;
+} CGSocketStats;
+
+/**
+ * \brief Snapshot of the kernel TCP state of a connection (TCP_INFO).
+ *
+ * Times are in microseconds, rates in bytes per second and windows in
+ * segments. Members which the running kernel does not report are zero.
+ */
+typedef struct {
+  uint8_t state;
+  uint8_t caState;
+  uint8_t retransmits;
+  uint8_t probes;
+  uint8_t backoff;
+  uint32_t rto;
+  uint32_t sndMss;
+  uint32_t rcvMss;
+  uint32_t pmtu;
+  uint32_t rtt;
+  uint32_t rttVar;
+  uint32_t minRtt;
+  uint32_t sndCwnd;
+  uint32_t sndSsthresh;
+  uint32_t unacked;
+  uint32_t sacked;
+  uint32_t lost;
+  uint32_t retrans;
+  uint32_t totalRetrans;
+  uint32_t reordering;
+  uint32_t notsentBytes;
+  uint64_t pacingRate;
+  uint64_t deliveryRate;
+  uint64_t bytesAcked;
+  uint64_t bytesReceived;
+  uint64_t busyTime;
+  uint64_t rwndLimited;
+  uint64_t sndbufLimited;
+} CGSocketTcpInfo;
+
+/**
+ * \brief Token bucket which paces outbound datagrams of a socket.
+ *
+ * The bucket is kept as the theoretical arrival time (tat) of the next
+ * byte in monotonic nanoseconds, so a send reserves its slot with one
+ * compare-and-swap and no lock.
+ */
+typedef struct {
+  uint64_t rate;
+  uint64_t burst;
+  uint64_t tat;
+} CGSocketPacer;
+
+/**
+ * \brief MSG_ZEROCOPY state of a stream socket.
+ *
+ * Every zero-copy send gets the next sequence number (starting at 1) and
+ * its buffer must not be modified until the kernel reported the number
+ * as completed on the error queue. Sends below the threshold are copied.
+ */
+typedef struct {
+  bool enabled;
+  size_t threshold;
+  uint64_t sentCnt;
+  uint64_t completedCnt;
+} CGSocketZeroCopy;
+
 typedef struct {
   SOCKET id;
   int type;
   int direction;
-  CGString* ipaddr;
+  char ipaddr[CG_NET_ADDRSTRING_MAXSIZE];
   int port;
+  int timeout;
 #if defined(CG_USE_OPENSSL)
   SSL_CTX* ctx;
   SSL* ssl;
 #endif
+  CGSocketStats stats;
+  CGSocketPacer pacer;
+  CGSocketZeroCopy zerocopy;
+  struct _CGSocketImpairment* impairment;
 } CGSocket;
 
 typedef struct {
   byte* data;
   size_t dataLen;
+  size_t dataCapacity;
 
   CGString* localAddr;
   int localPort;
 
   CGString* remoteAddr;
   int remotePort;
+
+  CGString* destAddr;
+  int ifIndex;
+
+  uint64_t timestamp;
 } CGDatagramPacket;
 
 /****************************************
  * Function (Socket)
  ****************************************/
 
+/**
+ * Initialize the socket layer. The initialization runs once per process,
+ * cg_socket_new() calls this itself and further calls do nothing.
+ */
 void cg_socket_startup(void);
+
+/**
+ * Release the recycled sockets and, on WIN32, call WSACleanup(). It is
+ * not reference counted, so call it once when the process is done with
+ * sockets and do not use the socket layer afterwards.
+ */
 void cg_socket_cleanup(void);
 
 CGSocket* cg_socket_new(int type);
@@ -112,8 +233,8 @@ void cg_socket_setid(CGSocket* socket, SOCKET value);
 #define cg_socket_isclient(socket) ((socket->direction == CG_NET_SOCKET_CLIENT) ? true : false)
 #define cg_socket_isserver(socket) ((socket->direction == CG_NET_SOCKET_SERVER) ? true : false)
 
-#define cg_socket_setaddress(socket, value) cg_string_setvalue(socket->ipaddr, value)
-#define cg_socket_getaddress(socket) cg_string_getvalue(socket->ipaddr)
+void cg_socket_setaddress(CGSocket* socket, const char* addr);
+#define cg_socket_getaddress(socket) (socket->ipaddr)
 bool cg_socket_isboundaddress(CGSocket* socket, const char* addr);
 
 #define cg_socket_setport(socket, value) (socket->port = value)
@@ -125,11 +246,23 @@ bool cg_socket_close(CGSocket* socket);
 bool cg_socket_listen(CGSocket* socket);
 
 bool cg_socket_bind(CGSocket* sock, int bindPort, const char* bindAddr, CGSocketOption* opt);
+bool cg_socket_pair(CGSocket* sock, CGSocket* peerSock);
 bool cg_socket_accept(CGSocket* sock, CGSocket* clientSock);
+size_t cg_socket_acceptbatch(CGSocket* sock, CGSocket** clientSocks, size_t clientSockCnt);
 bool cg_socket_connect(CGSocket* sock, const char* addr, int port);
 ssize_t cg_socket_read(CGSocket* sock, char* buffer, size_t bufferLen);
 size_t cg_socket_write(CGSocket* sock, const char* buffer, size_t bufferLen);
+size_t cg_socket_writev(CGSocket* sock, const byte** bufs, const size_t* bufLens, size_t bufCnt);
 ssize_t cg_socket_readline(CGSocket* sock, char* buffer, size_t bufferLen);
+
+/**
+ * Read like cg_socket_read() and report the kernel receive time of the
+ * data in nanoseconds. The timestamp is 0 when the kernel attached none,
+ * e.g. for segments queued before timestamping took effect.
+ */
+ssize_t cg_socket_readtimestamp(CGSocket* sock, char* buffer, size_t bufferLen, uint64_t* timestamp);
+ssize_t cg_socket_readring(CGSocket* sock, CGRingBuffer* ring);
+ssize_t cg_socket_writering(CGSocket* sock, CGRingBuffer* ring);
 size_t cg_socket_skip(CGSocket* sock, size_t skipLen);
 
 size_t cg_socket_sendto(CGSocket* sock, const char* addr, int port, const byte* data, size_t dataeLen);
@@ -140,6 +273,7 @@ ssize_t cg_socket_recv(CGSocket* sock, CGDatagramPacket* dgmPkt);
  ****************************************/
 
 bool cg_socket_joingroup(CGSocket* sock, const char* mcastAddr, const char* ifAddr);
+size_t cg_socket_joingroups(CGSocket* sock, const char* mcastAddr, CGNetworkInterfaceList* netIfList);
 
 /****************************************
  * Function (Option)
@@ -149,6 +283,58 @@ bool cg_socket_setreuseaddress(CGSocket* socket, bool flag);
 bool cg_socket_setmulticastloop(CGSocket* sock, bool flag);
 bool cg_socket_setmulticastttl(CGSocket* sock, int ttl);
 bool cg_socket_settimeout(CGSocket* sock, int sec);
+bool cg_socket_setnonblocking(CGSocket* sock, bool flag);
+bool cg_socket_setpktinfo(CGSocket* sock, bool flag);
+bool cg_socket_settimestamp(CGSocket* sock, bool flag);
+
+/****************************************
+ * Function (Statistics)
+ ****************************************/
+
+void cg_socket_getstats(CGSocket* sock, CGSocketStats* stats);
+void cg_socket_resetstats(CGSocket* sock);
+
+/**
+ * The totals over all sockets. Every thread counts into one of a few
+ * shards which are summed here, so the result is not an atomic snapshot.
+ */
+void cg_socket_getglobalstats(CGSocketStats* stats);
+void cg_socket_resetglobalstats(void);
+
+/****************************************
+ * Function (Pacing)
+ ****************************************/
+
+bool cg_socket_setpacingrate(CGSocket* sock, uint64_t bytesPerSec, size_t burstBytes);
+#define cg_socket_getpacingrate(sock) ((sock)->pacer.rate)
+#define cg_socket_getpacingburst(sock) ((sock)->pacer.burst)
+#define cg_socket_ispaced(sock) ((0 < (sock)->pacer.rate) ? true : false)
+
+/****************************************
+ * Function (Zero Copy)
+ ****************************************/
+
+bool cg_socket_setzerocopy(CGSocket* sock, bool flag, size_t threshold);
+#define cg_socket_iszerocopy(sock) ((sock)->zerocopy.enabled)
+#define cg_socket_getzerocopythreshold(sock) ((sock)->zerocopy.threshold)
+
+size_t cg_socket_writezerocopy(CGSocket* sock, const byte* data, size_t dataLen, uint64_t* sendId);
+size_t cg_socket_readzerocopycompletions(CGSocket* sock);
+bool cg_socket_iszerocopycompleted(CGSocket* sock, uint64_t sendId);
+bool cg_socket_waitzerocopy(CGSocket* sock, uint64_t sendId, clock_t timeout);
+
+/****************************************
+ * Function (Impairment)
+ ****************************************/
+
+#define cg_socket_setimpairment(sock, value) ((sock)->impairment = value)
+#define cg_socket_getimpairment(sock) ((sock)->impairment)
+
+/****************************************
+ * Function (TCP Info)
+ ****************************************/
+
+bool cg_socket_gettcpinfo(CGSocket* sock, CGSocketTcpInfo* info);
 
 /****************************************
  * Function (DatagramPacket)
@@ -170,6 +356,12 @@ bool cg_socket_datagram_packet_clear(CGDatagramPacket* dgmPkt);
 #define cg_socket_datagram_packet_getremoteAddr(dgmPkt) cg_string_getvalue(dgmPkt->remoteAddr)
 #define cg_socket_datagram_packet_setremoteport(dgmPkt, port) (dgmPkt->remotePort = port)
 #define cg_socket_datagram_packet_getremoteport(dgmPkt) (dgmPkt->remotePort)
+#define cg_socket_datagram_packet_setdestAddr(dgmPkt, addr) cg_string_setvalue(dgmPkt->destAddr, addr)
+#define cg_socket_datagram_packet_getdestAddr(dgmPkt) cg_string_getvalue(dgmPkt->destAddr)
+#define cg_socket_datagram_packet_setifindex(dgmPkt, idx) (dgmPkt->ifIndex = idx)
+#define cg_socket_datagram_packet_getifindex(dgmPkt) (dgmPkt->ifIndex)
+#define cg_socket_datagram_packet_settimestamp(dgmPkt, ts) (dgmPkt->timestamp = ts)
+#define cg_socket_datagram_packet_gettimestamp(dgmPkt) (dgmPkt->timestamp)
 
 bool cg_socket_datagram_packet_copy(CGDatagramPacket* dstDgmPkt, CGDatagramPacket* srcDgmPkt);
 
@@ -0,0 +1,92 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _CGPR_NET_SOCKET_FRAMER_H_
+#define _CGPR_NET_SOCKET_FRAMER_H_
+
+#include <cgpr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_FRAMER_VARINT 0
+#define CG_NET_SOCKET_FRAMER_UINT16 2
+#define CG_NET_SOCKET_FRAMER_UINT32 4
+
+#define CG_NET_SOCKET_FRAMER_DEFAULT_MAXFRAMESIZE 65536
+#define CG_NET_SOCKET_FRAMER_DEFAULT_SENDBUFSIZE 16384
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+/**
+ * \brief Length-prefixed message framing over a stream socket.
+ *
+ * Frames carry a big-endian 2 or 4 byte length, or an unsigned LEB128
+ * varint length. Received bytes are kept in one buffer and returned
+ * frames point into it, so reading does not allocate per frame. Written
+ * frames are coalesced into one send buffer until it is flushed.
+ */
+typedef struct {
+  CGSocket* sock;
+  int lengthType;
+  size_t maxFrameSize;
+  byte* recvBuf;
+  size_t recvBufSize;
+  size_t recvBegin;
+  size_t recvEnd;
+  byte* sendBuf;
+  size_t sendBufSize;
+  size_t sendLen;
+} CGSocketFramer;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGSocketFramer* cg_socket_framer_new(CGSocket* sock, int lengthType);
+void cg_socket_framer_delete(CGSocketFramer* framer);
+
+bool cg_socket_framer_setmaxframesize(CGSocketFramer* framer, size_t maxFrameSize);
+bool cg_socket_framer_setsendbuffersize(CGSocketFramer* framer, size_t bufSize);
+
+#define cg_socket_framer_getsocket(framer) ((framer)->sock)
+#define cg_socket_framer_getlengthtype(framer) ((framer)->lengthType)
+#define cg_socket_framer_getmaxframesize(framer) ((framer)->maxFrameSize)
+#define cg_socket_framer_getbufferedsize(framer) ((framer)->recvEnd - (framer)->recvBegin)
+#define cg_socket_framer_getpendingsize(framer) ((framer)->sendLen)
+
+size_t cg_socket_framer_encodeheader(CGSocketFramer* framer, byte* buf, size_t frameLen);
+
+bool cg_socket_framer_nextframe(CGSocketFramer* framer, const byte** frame, size_t* frameLen);
+ssize_t cg_socket_framer_read(CGSocketFramer* framer, const byte** frame);
+
+bool cg_socket_framer_write(CGSocketFramer* framer, const byte* data, size_t dataLen);
+bool cg_socket_framer_flush(CGSocketFramer* framer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_SOCKET_FRAMER_H_
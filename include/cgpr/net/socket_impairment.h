@@ -0,0 +1,130 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_NET_SOCKET_IMPAIRMENT_H_
+#define _CGPR_NET_SOCKET_IMPAIRMENT_H_
+
+#include <cgpr/net/socket.h>
+#include <cgpr/util/list.h>
+#include <cgpr/util/mutex.h>
+#include <cgpr/util/thread.h>
+
+#if !defined(WIN32)
+#include <sys/socket.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_IMPAIRMENT_DEFAULT_SEED 1
+#define CG_NET_SOCKET_IMPAIRMENT_DEFAULT_QUEUE_LIMIT (1024 * 1024)
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct _CGSocketImpairmentPacket {
+  CG_LIST_STRUCT_MEMBERS
+
+  CGSocket* sock;
+  uint64_t deliveryTime;
+  struct sockaddr_storage toAddr;
+  socklen_t toAddrLen;
+  size_t dataLen;
+  byte* data;
+} CGSocketImpairmentPacket, CGSocketImpairmentPacketList;
+
+/**
+ * \brief Emulates a lossy, slow link on the send path of sockets.
+ *
+ * Writes and sends of a socket attached with cg_socket_setimpairment()
+ * are queued with a delivery time and performed by the impairment thread,
+ * so the peer observes the delay, jitter (usec), bandwidth cap (bytes per
+ * second), loss and reorder probabilities. Loss and reordering only apply
+ * to datagram sockets; stream data is delayed in order. The random source
+ * is seeded, so a run can be repeated exactly. Attached sockets must be
+ * detached or the impairment stopped before they are deleted.
+ *
+ * The queue holds at most queueLimit bytes (0 for no limit), like the
+ * buffer of a real bottleneck. Datagrams which do not fit are dropped and
+ * counted as dropped, stream writes wait until the link has drained or
+ * fail with EAGAIN on a non-blocking socket. The impairment thread sends
+ * without blocking, so a peer which does not read only holds back its own
+ * data.
+ */
+typedef struct _CGSocketImpairment {
+  CGMutex* mutex;
+  CGSocketImpairmentPacketList* pktList;
+  uint64_t delay;
+  uint64_t jitter;
+  uint64_t rate;
+  double loss;
+  double reorder;
+  uint64_t randState;
+  uint64_t linkFreeTime;
+  uint64_t lastStreamTime;
+  size_t queueLimit;
+  size_t queuedBytes;
+  size_t sentCnt;
+  size_t droppedCnt;
+  size_t reorderedCnt;
+  int wakePipe[2];
+  CGThread* thread;
+} CGSocketImpairment;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGSocketImpairment* cg_socket_impairment_new(void);
+void cg_socket_impairment_delete(CGSocketImpairment* imp);
+
+#define cg_socket_impairment_setdelay(imp, usec) ((imp)->delay = usec)
+#define cg_socket_impairment_getdelay(imp) ((imp)->delay)
+#define cg_socket_impairment_setjitter(imp, usec) ((imp)->jitter = usec)
+#define cg_socket_impairment_getjitter(imp) ((imp)->jitter)
+#define cg_socket_impairment_setrate(imp, bytesPerSec) ((imp)->rate = bytesPerSec)
+#define cg_socket_impairment_getrate(imp) ((imp)->rate)
+#define cg_socket_impairment_setloss(imp, prob) ((imp)->loss = prob)
+#define cg_socket_impairment_getloss(imp) ((imp)->loss)
+#define cg_socket_impairment_setreorder(imp, prob) ((imp)->reorder = prob)
+#define cg_socket_impairment_getreorder(imp) ((imp)->reorder)
+#define cg_socket_impairment_setqueuelimit(imp, bytes) ((imp)->queueLimit = bytes)
+#define cg_socket_impairment_getqueuelimit(imp) ((imp)->queueLimit)
+void cg_socket_impairment_setseed(CGSocketImpairment* imp, uint64_t seed);
+
+#define cg_socket_impairment_getsentcount(imp) ((imp)->sentCnt)
+#define cg_socket_impairment_getdroppedcount(imp) ((imp)->droppedCnt)
+#define cg_socket_impairment_getreorderedcount(imp) ((imp)->reorderedCnt)
+size_t cg_socket_impairment_getpendingsize(CGSocketImpairment* imp);
+
+bool cg_socket_impairment_start(CGSocketImpairment* imp);
+bool cg_socket_impairment_stop(CGSocketImpairment* imp);
+bool cg_socket_impairment_isrunning(CGSocketImpairment* imp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_SOCKET_IMPAIRMENT_H_
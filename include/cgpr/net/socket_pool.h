@@ -0,0 +1,94 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _CGPR_NET_SOCKET_POOL_H_
+#define _CGPR_NET_SOCKET_POOL_H_
+
+#include <cgpr/net/socket.h>
+#include <cgpr/util/list.h>
+#include <cgpr/util/mutex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_POOL_DEFAULT_MAXIDLE 16
+#define CG_NET_SOCKET_POOL_DEFAULT_MAXPERHOST 8
+#define CG_NET_SOCKET_POOL_DEFAULT_IDLETIMEOUT 60000
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct _CGSocketPoolConnection {
+  CG_LIST_STRUCT_MEMBERS
+
+  CGSocket* sock;
+  char host[CG_NET_SOCKET_MAXHOST];
+  int port;
+  bool ssl;
+  uint64_t idleTime;
+} CGSocketPoolConnection, CGSocketPoolConnectionList;
+
+/**
+ * \brief Keeps connected stream sockets for reuse, keyed by (host, port, ssl).
+ *
+ * Idle connections are reused most recently used first and are checked
+ * for a closed peer on checkout. maxPerHost bounds the idle and checked
+ * out connections of one key, maxIdle the idle connections of the pool
+ * and idleTimeout (msec) the idle time of a connection.
+ */
+typedef struct {
+  CGMutex* mutex;
+  CGSocketPoolConnectionList* idleList;
+  CGSocketPoolConnectionList* busyList;
+  size_t maxIdle;
+  size_t maxPerHost;
+  clock_t idleTimeout;
+} CGSocketPool;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGSocketPool* cg_socket_pool_new(void);
+void cg_socket_pool_delete(CGSocketPool* pool);
+
+#define cg_socket_pool_setmaxidle(pool, value) ((pool)->maxIdle = value)
+#define cg_socket_pool_getmaxidle(pool) ((pool)->maxIdle)
+#define cg_socket_pool_setmaxperhost(pool, value) ((pool)->maxPerHost = value)
+#define cg_socket_pool_getmaxperhost(pool) ((pool)->maxPerHost)
+#define cg_socket_pool_setidletimeout(pool, value) ((pool)->idleTimeout = value)
+#define cg_socket_pool_getidletimeout(pool) ((pool)->idleTimeout)
+
+CGSocket* cg_socket_pool_checkout(CGSocketPool* pool, const char* host, int port, bool ssl);
+bool cg_socket_pool_checkin(CGSocketPool* pool, CGSocket* sock, bool isReusable);
+
+size_t cg_socket_pool_getidlesize(CGSocketPool* pool);
+size_t cg_socket_pool_getbusysize(CGSocketPool* pool);
+void cg_socket_pool_clear(CGSocketPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_SOCKET_POOL_H_
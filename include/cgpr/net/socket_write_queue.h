@@ -0,0 +1,111 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _CGPR_NET_SOCKET_WRITE_QUEUE_H_
+#define _CGPR_NET_SOCKET_WRITE_QUEUE_H_
+
+#include <cgpr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_WRITE_QUEUE_SEGMENT_SIZE 4096
+#define CG_NET_SOCKET_WRITE_QUEUE_IOV_MAX 64
+#define CG_NET_SOCKET_WRITE_QUEUE_SPARE_MAX 4
+
+#define CG_NET_SOCKET_WRITE_QUEUE_DEFAULT_LOW_WATERMARK (64 * 1024)
+#define CG_NET_SOCKET_WRITE_QUEUE_DEFAULT_HIGH_WATERMARK (256 * 1024)
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct _CGSocketWriteQueueSegment {
+  struct _CGSocketWriteQueueSegment* next;
+  size_t offset;
+  size_t len;
+  size_t capacity;
+  byte* data;
+} CGSocketWriteQueueSegment;
+
+struct _CGSocketWriteQueue;
+
+typedef void (*CG_NET_SOCKET_WRITE_QUEUE_LISTENER)(struct _CGSocketWriteQueue*, bool isHigh);
+
+/**
+ * \brief Queued, non-blocking writes for one connection.
+ *
+ * Enqueued bytes are copied into segments, and small writes share the
+ * tail segment. A flush sends as many segments as the socket accepts
+ * with a single vectored send and never blocks. The listener is called
+ * once when the queued size rises above the high watermark and once
+ * when it drains back to the low watermark. A queue is not thread-safe
+ * and belongs to the thread which drives the connection.
+ *
+ * On an SSL socket only the head segment is written per call, and a write
+ * which wants to be retried is repeated with the same length, as
+ * SSL_write() requires.
+ */
+typedef struct _CGSocketWriteQueue {
+  CGSocket* sock;
+  CGSocketWriteQueueSegment* head;
+  CGSocketWriteQueueSegment* tail;
+  CGSocketWriteQueueSegment* spares;
+  size_t spareCnt;
+  size_t size;
+  size_t lowWatermark;
+  size_t highWatermark;
+  bool isHigh;
+  size_t sslRetryLen;
+  CG_NET_SOCKET_WRITE_QUEUE_LISTENER listener;
+  void* userData;
+} CGSocketWriteQueue;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGSocketWriteQueue* cg_socket_write_queue_new(CGSocket* sock);
+void cg_socket_write_queue_delete(CGSocketWriteQueue* queue);
+void cg_socket_write_queue_clear(CGSocketWriteQueue* queue);
+
+bool cg_socket_write_queue_setwatermarks(CGSocketWriteQueue* queue, size_t lowWatermark, size_t highWatermark);
+
+#define cg_socket_write_queue_getsocket(queue) ((queue)->sock)
+#define cg_socket_write_queue_getsize(queue) ((queue)->size)
+#define cg_socket_write_queue_isempty(queue) (((queue)->size == 0) ? true : false)
+#define cg_socket_write_queue_ishigh(queue) ((queue)->isHigh)
+#define cg_socket_write_queue_getlowwatermark(queue) ((queue)->lowWatermark)
+#define cg_socket_write_queue_gethighwatermark(queue) ((queue)->highWatermark)
+#define cg_socket_write_queue_setlistener(queue, func) ((queue)->listener = func)
+#define cg_socket_write_queue_setuserdata(queue, data) ((queue)->userData = data)
+#define cg_socket_write_queue_getuserdata(queue) ((queue)->userData)
+
+bool cg_socket_write_queue_enqueue(CGSocketWriteQueue* queue, const byte* data, size_t dataLen);
+ssize_t cg_socket_write_queue_flush(CGSocketWriteQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_SOCKET_WRITE_QUEUE_H_
@@ -0,0 +1,105 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_NET_STREAM_SERVER_H_
+#define _CGPR_NET_STREAM_SERVER_H_
+
+#include <cgpr/net/socket.h>
+#include <cgpr/util/mutex.h>
+#include <cgpr/util/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_STREAM_SERVER_DEFAULT_WORKERS 4
+#define CG_STREAM_SERVER_DEFAULT_ACCEPT_BATCH 32
+#define CG_STREAM_SERVER_DEFAULT_QUEUE_CAPACITY 256
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+struct _CGStreamServer;
+
+typedef void (*CG_STREAM_SERVER_LISTENER)(struct _CGStreamServer*, CGSocket*);
+
+/**
+ * \brief Accepts stream connections and hands them to a fixed worker pool.
+ *
+ * One accept thread drains the non-blocking listener in batches into a
+ * bounded queue using pre-allocated client sockets, and the worker threads
+ * created by cg_stream_server_start() call the listener for each queued
+ * connection. The client socket is closed and deleted by the server when
+ * the listener returns. Connections are left in the kernel backlog while
+ * the queue is full.
+ */
+typedef struct _CGStreamServer {
+  CGSocket* sock;
+  CGMutex* mutex;
+  CGSocket** queue;
+  size_t queueHead;
+  size_t queueCnt;
+  size_t queueCapacity;
+  CGSocket** spareSocks;
+  size_t spareCnt;
+  size_t acceptBatch;
+  int readyPipe[2];
+  CGThread* acceptThread;
+  CGThread** workers;
+  size_t workerCnt;
+  CG_STREAM_SERVER_LISTENER listener;
+  void* userData;
+} CGStreamServer;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGStreamServer* cg_stream_server_new(void);
+void cg_stream_server_delete(CGStreamServer* server);
+
+bool cg_stream_server_open(CGStreamServer* server, int port, const char* addr);
+bool cg_stream_server_close(CGStreamServer* server);
+
+#define cg_stream_server_getsocket(server) ((server)->sock)
+#define cg_stream_server_getport(server) cg_socket_getport((server)->sock)
+#define cg_stream_server_setworkercount(server, value) ((server)->workerCnt = value)
+#define cg_stream_server_getworkercount(server) ((server)->workerCnt)
+#define cg_stream_server_setacceptbatch(server, value) ((server)->acceptBatch = value)
+#define cg_stream_server_getacceptbatch(server) ((server)->acceptBatch)
+#define cg_stream_server_setqueuecapacity(server, value) ((server)->queueCapacity = value)
+#define cg_stream_server_getqueuecapacity(server) ((server)->queueCapacity)
+#define cg_stream_server_setlistener(server, func) ((server)->listener = func)
+#define cg_stream_server_setuserdata(server, data) ((server)->userData = data)
+#define cg_stream_server_getuserdata(server) ((server)->userData)
+
+bool cg_stream_server_start(CGStreamServer* server);
+bool cg_stream_server_stop(CGStreamServer* server);
+bool cg_stream_server_isrunning(CGStreamServer* server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_STREAM_SERVER_H_
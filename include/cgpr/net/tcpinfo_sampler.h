@@ -0,0 +1,90 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _CGPR_NET_TCPINFO_SAMPLER_H_
+#define _CGPR_NET_TCPINFO_SAMPLER_H_
+
+#include <cgpr/net/socket.h>
+#include <cgpr/util/mutex.h>
+#include <cgpr/util/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_TCPINFO_SAMPLER_DEFAULT_INTERVAL 1000
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+struct _CGTcpInfoSampler;
+
+typedef void (*CG_TCPINFO_SAMPLER_LISTENER)(struct _CGTcpInfoSampler*, CGSocket*, CGSocketTcpInfo*);
+
+/**
+ * \brief Periodically reads TCP_INFO of registered stream sockets.
+ *
+ * The listener is called from the sampler thread for every socket whose
+ * snapshot could be read while the sampler lock is held, so the listener
+ * must not add or remove sockets. Sockets must be removed before they are
+ * deleted.
+ */
+typedef struct _CGTcpInfoSampler {
+  CGMutex* mutex;
+  CGSocket** socks;
+  size_t sockCnt;
+  size_t sockCapacity;
+  clock_t interval;
+  CG_TCPINFO_SAMPLER_LISTENER listener;
+  void* userData;
+  CGThread* thread;
+} CGTcpInfoSampler;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGTcpInfoSampler* cg_tcpinfo_sampler_new(void);
+void cg_tcpinfo_sampler_delete(CGTcpInfoSampler* sampler);
+
+bool cg_tcpinfo_sampler_addsocket(CGTcpInfoSampler* sampler, CGSocket* sock);
+bool cg_tcpinfo_sampler_removesocket(CGTcpInfoSampler* sampler, CGSocket* sock);
+size_t cg_tcpinfo_sampler_size(CGTcpInfoSampler* sampler);
+
+#define cg_tcpinfo_sampler_setinterval(sampler, value) ((sampler)->interval = value)
+#define cg_tcpinfo_sampler_getinterval(sampler) ((sampler)->interval)
+#define cg_tcpinfo_sampler_setlistener(sampler, func) ((sampler)->listener = func)
+#define cg_tcpinfo_sampler_setuserdata(sampler, data) ((sampler)->userData = data)
+#define cg_tcpinfo_sampler_getuserdata(sampler) ((sampler)->userData)
+
+size_t cg_tcpinfo_sampler_sample(CGTcpInfoSampler* sampler);
+
+bool cg_tcpinfo_sampler_start(CGTcpInfoSampler* sampler);
+bool cg_tcpinfo_sampler_stop(CGTcpInfoSampler* sampler);
+bool cg_tcpinfo_sampler_isrunning(CGTcpInfoSampler* sampler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_NET_TCPINFO_SAMPLER_H_
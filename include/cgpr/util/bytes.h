@@ -21,16 +21,28 @@
 
 #include <cgpr/util/typedef.h>
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_BYTES_VARINT_MAXSIZE 10
+
 /****************************************
  * Function
  ****************************************/
 
 int cg_bytes_toint(byte* byteData, size_t byteSize);
 byte* cg_bytes_fromint(int val, size_t bytesSize);
+byte* cg_bytes_setint(byte* bytesData, int val, size_t bytesSize);
+
+size_t cg_bytes_setvarint(byte* bytesData, uint64_t val);
+size_t cg_bytes_getvarint(const byte* bytesData, size_t bytesSize, uint64_t* val);
 
 #ifdef __cplusplus
 }
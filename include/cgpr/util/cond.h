@@ -54,6 +54,7 @@ bool cg_cond_delete(CGCond* cond);
 bool cg_cond_wait(CGCond* cond);
 bool cg_cond_timedwait(CGCond* cond, clock_t mtime);
 bool cg_cond_signal(CGCond* cond);
+bool cg_cond_broadcast(CGCond* cond);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,133 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_CPU_H_
+#define _CGPR_UTIL_CPU_H_
+
+#include <stdint.h>
+
+#include <cgpr/util/typedef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_CPU_SET_MAXSIZE 1024
+#define CG_CPU_NODE_NONE (-1)
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+/**
+ * \brief Fixed size bit set of logical CPU numbers.
+ */
+typedef struct {
+  uint64_t bits[CG_CPU_SET_MAXSIZE / 64];
+} CGCpuSet;
+
+typedef struct {
+  int cpu;
+  int core;
+  int package;
+  int node;
+} CGCpuInfo;
+
+/**
+ * \brief Snapshot of the online logical CPUs and where they live.
+ *
+ * Every logical CPU records its physical core and package and its NUMA
+ * node (CG_CPU_NODE_NONE when the platform does not report one). On Linux
+ * the layout is read from sysfs, elsewhere every CPU counts as a core.
+ */
+typedef struct {
+  CGCpuInfo* cpus;
+  size_t cpuCnt;
+  size_t cpuCapacity;
+  size_t coreCnt;
+  size_t packageCnt;
+  size_t nodeCnt;
+} CGCpuTopology;
+
+/****************************************
+ * Function (CPU Set)
+ ****************************************/
+
+void cg_cpuset_clear(CGCpuSet* cpuSet);
+bool cg_cpuset_add(CGCpuSet* cpuSet, int cpu);
+bool cg_cpuset_remove(CGCpuSet* cpuSet, int cpu);
+bool cg_cpuset_contains(const CGCpuSet* cpuSet, int cpu);
+size_t cg_cpuset_size(const CGCpuSet* cpuSet);
+
+/**
+ * Add the CPUs of a kernel style list such as "0-3,8,10-11".
+ *
+ * \return false if the list is malformed
+ */
+bool cg_cpuset_parselist(CGCpuSet* cpuSet, const char* cpuList);
+
+/****************************************
+ * Function
+ ****************************************/
+
+size_t cg_cpu_getonlinecount(void);
+int cg_cpu_getcurrent(void);
+
+/**
+ * Get the CPUs which belong to a NUMA node.
+ *
+ * \return false if the node is unknown or NUMA is not supported
+ */
+bool cg_cpu_getnodecpus(int node, CGCpuSet* cpuSet);
+
+/****************************************
+ * Function (Topology)
+ ****************************************/
+
+CGCpuTopology* cg_cpu_topology_new(void);
+void cg_cpu_topology_delete(CGCpuTopology* topology);
+bool cg_cpu_topology_update(CGCpuTopology* topology);
+
+#define cg_cpu_topology_size(topology) ((topology)->cpuCnt)
+#define cg_cpu_topology_getcpu(topology, n) (&(topology)->cpus[n])
+#define cg_cpu_topology_getcorecount(topology) ((topology)->coreCnt)
+#define cg_cpu_topology_getpackagecount(topology) ((topology)->packageCnt)
+#define cg_cpu_topology_getnodecount(topology) ((topology)->nodeCnt)
+
+/**
+ * Pick one logical CPU per physical core, the lowest numbered sibling,
+ * so that workers laid out on them never share a core.
+ *
+ * \param topology The topology in question
+ * \param cpus Array receiving the CPU numbers
+ * \param cpuCnt Size of the array
+ *
+ * \return Number of CPUs stored
+ */
+size_t cg_cpu_topology_getcorecpus(CGCpuTopology* topology, int* cpus, size_t cpuCnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_CPU_H_
@@ -0,0 +1,175 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_FIBER_H_
+#define _CGPR_UTIL_FIBER_H_
+
+#include <stdint.h>
+#include <ucontext.h>
+
+#include <cgpr/util/list.h>
+#include <cgpr/util/time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_FIBER_DEFAULT_STACK_SIZE (64 * 1024)
+#define CG_FIBER_WAIT_INFINITE ((clock_t)-1)
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+struct _CGFiber;
+struct _CGFiberScheduler;
+
+typedef void (*CG_FIBER_FUNC)(struct _CGFiber*);
+
+/**
+ * \brief Stackful coroutine run by a CGFiberScheduler.
+ *
+ * A fiber runs until it yields, sleeps or waits for a descriptor, and the
+ * scheduler then switches to the next ready fiber on the same thread. The
+ * stack is mapped lazily with a guard page below it, so a small stack
+ * costs little until it is used.
+ */
+typedef struct _CGFiber {
+  CG_LIST_STRUCT_MEMBERS
+
+  ucontext_t context;
+  void* stack;
+  size_t stackSize;
+  struct _CGFiberScheduler* scheduler;
+  CG_FIBER_FUNC func;
+  void* userData;
+  int waitFd;
+  short waitEvents;
+  short readyEvents;
+  uint64_t deadline;
+  bool finished;
+#if defined(__linux__)
+  struct _CGFiber* nextFdWaiter;
+#endif
+} CGFiber;
+
+#if defined(__linux__)
+/**
+ * \brief epoll registration of a descriptor fibers have waited on.
+ *
+ * A descriptor stays registered once added and is re-armed one-shot for
+ * the union of the events its current waiters want.
+ */
+typedef struct {
+  CGFiber* waiters;
+  bool registered;
+} CGFiberFd;
+#endif
+
+/**
+ * \brief Per-thread fiber scheduler.
+ *
+ * Ready fibers run in FIFO order. When none is ready the scheduler polls
+ * the descriptors the waiting fibers are blocked on, with the nearest
+ * sleep deadline as the timeout. Inside a fiber, CGSocket reads, writes,
+ * accepts and connects wait here instead of blocking the thread.
+ *
+ * On Linux the descriptors are registered with epoll, so a round costs
+ * one epoll_ctl() per new wait and nothing per idle waiter. Elsewhere
+ * the scheduler rebuilds a poll() set over every waiter each round, which
+ * is fine for a few hundred fibers but grows linearly beyond that.
+ */
+typedef struct _CGFiberScheduler {
+  ucontext_t context;
+  CGList readyList;
+  CGList waitList;
+  CGFiber* current;
+  size_t fiberCnt;
+  size_t stackSize;
+#if defined(__linux__)
+  CGList ioWaitList;
+  int epollFd;
+  CGFiberFd* fds;
+  size_t fdCapacity;
+#else
+  struct pollfd* pollFds;
+  CGFiber** pollFibers;
+  size_t pollCapacity;
+#endif
+} CGFiberScheduler;
+
+/****************************************
+ * Function (Scheduler)
+ ****************************************/
+
+CGFiberScheduler* cg_fiber_scheduler_new(void);
+void cg_fiber_scheduler_delete(CGFiberScheduler* scheduler);
+
+/**
+ * Run the fibers on the calling thread until all of them have finished.
+ */
+bool cg_fiber_scheduler_run(CGFiberScheduler* scheduler);
+
+#define cg_fiber_scheduler_setstacksize(scheduler, value) ((scheduler)->stackSize = value)
+#define cg_fiber_scheduler_getstacksize(scheduler) ((scheduler)->stackSize)
+#define cg_fiber_scheduler_size(scheduler) ((scheduler)->fiberCnt)
+
+/****************************************
+ * Function (Fiber)
+ ****************************************/
+
+/**
+ * Create a fiber and queue it on the scheduler. The scheduler deletes the
+ * fiber when its function returns.
+ */
+CGFiber* cg_fiber_new(CGFiberScheduler* scheduler, CG_FIBER_FUNC func, void* userData);
+
+#define cg_fiber_getuserdata(fiber) ((fiber)->userData)
+#define cg_fiber_getscheduler(fiber) ((fiber)->scheduler)
+
+/**
+ * Get the fiber running on the calling thread, NULL outside of fibers.
+ */
+CGFiber* cg_fiber_current(void);
+#define cg_fiber_isactive() (cg_fiber_current() != NULL)
+
+bool cg_fiber_yield(void);
+bool cg_fiber_sleep(clock_t mtime);
+
+/**
+ * Suspend the current fiber until the descriptor is ready.
+ *
+ * \param fd Descriptor to wait for
+ * \param events poll() events
+ * \param mtime Timeout in milliseconds or CG_FIBER_WAIT_INFINITE
+ *
+ * \return The ready events, 0 on timeout, -1 outside of fibers or when
+ * the descriptor cannot be watched
+ */
+int cg_fiber_waitfd(int fd, int events, clock_t mtime);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_FIBER_H_
@@ -0,0 +1,179 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_FUTURE_H_
+#define _CGPR_UTIL_FUTURE_H_
+
+#include <pthread.h>
+
+#include <cgpr/util/thread_pool.h>
+#include <cgpr/util/time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_FUTURE_PENDING 0
+#define CG_FUTURE_FULFILLED 1
+#define CG_FUTURE_REJECTED 2
+
+#define CG_FUTURE_ERROR_NONE 0
+#define CG_FUTURE_ERROR_BROKEN -1
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+struct _CGFuture;
+
+typedef void* (*CG_FUTURE_FUNC)(void* userData);
+typedef void* (*CG_FUTURE_THEN_FUNC)(struct _CGFuture* future, void* userData);
+typedef void (*CG_FUTURE_CALLBACK)(struct _CGFuture* future, void* userData);
+
+typedef struct _CGFutureCallback {
+  struct _CGFutureCallback* next;
+  struct _CGFuture* future;
+  CG_FUTURE_CALLBACK func;
+  void* userData;
+} CGFutureCallback;
+
+/**
+ * \brief Result of an asynchronous operation which is settled only once.
+ *
+ * A future is either fulfilled with a value or rejected with an error
+ * code. The state is guarded by its own mutex, so a waiter checks it
+ * before sleeping and a settle which happens first is never missed.
+ * Callbacks run on the pool of the future, or on the settling thread when
+ * it has no pool. Futures are reference counted: cg_future_delete()
+ * releases the caller's reference.
+ */
+typedef struct _CGFuture {
+  pthread_mutex_t mutexId;
+  pthread_cond_t condId;
+  int state;
+  void* value;
+  int error;
+  int refCnt;
+  int waiterCnt;
+  CGFutureCallback* callbacks;
+  CGThreadPool* pool;
+} CGFuture;
+
+/**
+ * \brief Producer side of a future.
+ */
+typedef struct {
+  CGFuture* future;
+} CGPromise;
+
+/****************************************
+ * Function (Promise)
+ ****************************************/
+
+CGPromise* cg_promise_new(CGThreadPool* pool);
+
+/**
+ * Delete the promise. A future which has not been settled yet is rejected
+ * with CG_FUTURE_ERROR_BROKEN so that its waiters do not hang.
+ */
+void cg_promise_delete(CGPromise* promise);
+
+/**
+ * Get the future of the promise.
+ *
+ * \return A new reference which the caller releases with cg_future_delete()
+ */
+CGFuture* cg_promise_getfuture(CGPromise* promise);
+
+bool cg_promise_setvalue(CGPromise* promise, void* value);
+bool cg_promise_seterror(CGPromise* promise, int error);
+
+/****************************************
+ * Function (Future)
+ ****************************************/
+
+/**
+ * Run a function on the pool and get a future of its return value.
+ */
+CGFuture* cg_future_run(CGThreadPool* pool, CG_FUTURE_FUNC func, void* userData);
+
+CGFuture* cg_future_retain(CGFuture* future);
+void cg_future_delete(CGFuture* future);
+
+/**
+ * Wait until the future is settled. Waiting on a pool worker for a future
+ * of the same pool can deadlock, so use cg_future_then() there.
+ */
+bool cg_future_wait(CGFuture* future);
+
+/**
+ * Wait until the future is settled or the timeout expires.
+ *
+ * \param future The future in question
+ * \param mtime Timeout in milliseconds
+ *
+ * \return true if the future is settled
+ */
+bool cg_future_timedwait(CGFuture* future, clock_t mtime);
+
+int cg_future_getstate(CGFuture* future);
+bool cg_future_isready(CGFuture* future);
+#define cg_future_isfulfilled(future) (cg_future_getstate(future) == CG_FUTURE_FULFILLED)
+#define cg_future_isrejected(future) (cg_future_getstate(future) == CG_FUTURE_REJECTED)
+
+/**
+ * Wait for the future and get its value, NULL if it was rejected.
+ */
+void* cg_future_getvalue(CGFuture* future);
+int cg_future_geterror(CGFuture* future);
+
+/**
+ * Call a function once the future is settled, at once if it already is.
+ */
+bool cg_future_addcallback(CGFuture* future, CG_FUTURE_CALLBACK func, void* userData);
+
+/**
+ * Chain a continuation. The function runs with the fulfilled future and
+ * its return value fulfills the returned future; a rejection is passed on
+ * without calling it.
+ */
+CGFuture* cg_future_then(CGFuture* future, CG_FUTURE_THEN_FUNC func, void* userData);
+
+/**
+ * Get a future which is fulfilled when all futures are fulfilled, or
+ * rejected with the first error.
+ */
+CGFuture* cg_future_whenall(CGFuture** futures, size_t futureCnt, CGThreadPool* pool);
+
+/**
+ * Get a future which is fulfilled as soon as any future is settled. Its
+ * value is the settled future, which stays valid while the caller holds
+ * its own reference.
+ */
+CGFuture* cg_future_whenany(CGFuture** futures, size_t futureCnt, CGThreadPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_FUTURE_H_
@@ -0,0 +1,90 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_PARALLEL_H_
+#define _CGPR_UTIL_PARALLEL_H_
+
+#include <cgpr/util/thread_pool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_PARALLEL_GRAIN_AUTO 0
+#define CG_PARALLEL_CHUNKS_PER_WORKER 4
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef void (*CG_PARALLEL_FOR_FUNC)(size_t begin, size_t end, void* userData);
+typedef void (*CG_PARALLEL_REDUCE_FUNC)(size_t begin, size_t end, void* partial, void* userData);
+typedef void (*CG_PARALLEL_JOIN_FUNC)(void* result, const void* partial, void* userData);
+
+/****************************************
+ * Function
+ ****************************************/
+
+/**
+ * Get the pool shared by the parallel helpers when no pool is given. It is
+ * created and started on first use with one worker per online CPU.
+ */
+CGThreadPool* cg_parallel_getdefaultpool(void);
+
+/**
+ * Call a function on chunks of the range [begin, end) in parallel and
+ * return when all chunks are done.
+ *
+ * Chunks are claimed with one atomic increment, and the calling thread
+ * works on them too, so a call made from inside a pool task (nested
+ * parallelism) only waits for chunks other threads are already running.
+ *
+ * \param pool Pool to run on, NULL for the default pool
+ * \param begin First index
+ * \param end One past the last index
+ * \param grainSize Indices per chunk, CG_PARALLEL_GRAIN_AUTO to split the
+ * range into CG_PARALLEL_CHUNKS_PER_WORKER chunks per worker
+ * \param func Function called with each chunk
+ * \param userData Data passed to the function
+ */
+bool cg_parallel_for(CGThreadPool* pool, size_t begin, size_t end, size_t grainSize, CG_PARALLEL_FOR_FUNC func, void* userData);
+
+/**
+ * Reduce the range [begin, end) in parallel. Every participating thread
+ * accumulates its chunks into a private partial result which starts as a
+ * copy of the identity, and the partials are joined into the result by
+ * the calling thread at the end.
+ *
+ * \param result Result which the partials are joined into
+ * \param identity Initial value of each partial
+ * \param resultSize Size of the result, the identity and each partial
+ * \param func Function accumulating a chunk into a partial
+ * \param joinFunc Function joining a partial into the result
+ */
+bool cg_parallel_reduce(CGThreadPool* pool, size_t begin, size_t end, size_t grainSize, void* result, const void* identity, size_t resultSize, CG_PARALLEL_REDUCE_FUNC func, CG_PARALLEL_JOIN_FUNC joinFunc, void* userData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_PARALLEL_H_
@@ -0,0 +1,101 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _CGPR_UTIL_RING_BUFFER_H_
+#define _CGPR_UTIL_RING_BUFFER_H_
+
+#include <cgpr/util/typedef.h>
+
+#include <stdint.h>
+
+#if !defined(WIN32)
+#include <sys/uio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_RING_BUFFER_CAPACITY_MAX ((SIZE_MAX >> 1) + 1)
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+/**
+ * \brief Byte queue with a power-of-two capacity.
+ *
+ * The head and tail are free-running counters masked on access, so the
+ * full capacity is usable. A mirrored buffer maps the same pages twice
+ * back to back, which makes every readable or writable region contiguous
+ * even when it wraps.
+ */
+typedef struct {
+  byte* buf;
+  size_t capacity;
+  size_t mask;
+  size_t head;
+  size_t tail;
+  bool mirrored;
+} CGRingBuffer;
+
+/****************************************
+ * Function
+ ****************************************/
+
+/**
+ * The capacity is rounded up to a power of two, so NULL is returned for
+ * a capacity above CG_RING_BUFFER_CAPACITY_MAX.
+ */
+CGRingBuffer* cg_ring_buffer_new(size_t capacity);
+CGRingBuffer* cg_ring_buffer_mirrored_new(size_t capacity);
+void cg_ring_buffer_delete(CGRingBuffer* ring);
+void cg_ring_buffer_clear(CGRingBuffer* ring);
+
+#define cg_ring_buffer_getcapacity(ring) ((ring)->capacity)
+#define cg_ring_buffer_getsize(ring) ((ring)->tail - (ring)->head)
+#define cg_ring_buffer_getfreesize(ring) ((ring)->capacity - cg_ring_buffer_getsize(ring))
+#define cg_ring_buffer_isempty(ring) (((ring)->tail == (ring)->head) ? true : false)
+#define cg_ring_buffer_isfull(ring) ((cg_ring_buffer_getsize(ring) == (ring)->capacity) ? true : false)
+#define cg_ring_buffer_ismirrored(ring) ((ring)->mirrored)
+
+size_t cg_ring_buffer_write(CGRingBuffer* ring, const byte* data, size_t dataLen);
+size_t cg_ring_buffer_read(CGRingBuffer* ring, byte* buf, size_t bufLen);
+size_t cg_ring_buffer_peek(CGRingBuffer* ring, byte* buf, size_t bufLen);
+
+byte* cg_ring_buffer_getreadregion(CGRingBuffer* ring, size_t* regionLen);
+void cg_ring_buffer_consume(CGRingBuffer* ring, size_t len);
+byte* cg_ring_buffer_getwriteregion(CGRingBuffer* ring, size_t* regionLen);
+void cg_ring_buffer_commit(CGRingBuffer* ring, size_t len);
+
+#if !defined(WIN32)
+int cg_ring_buffer_getreadvec(CGRingBuffer* ring, struct iovec* iov);
+int cg_ring_buffer_getwritevec(CGRingBuffer* ring, struct iovec* iov);
+ssize_t cg_ring_buffer_readfd(CGRingBuffer* ring, int fd);
+ssize_t cg_ring_buffer_writefd(CGRingBuffer* ring, int fd);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_RING_BUFFER_H_
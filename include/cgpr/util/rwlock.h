@@ -0,0 +1,106 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_RWLOCK_H_
+#define _CGPR_UTIL_RWLOCK_H_
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cgpr/util/typedef.h>
+
+#if defined(WIN32) && !defined(ITRON)
+#include <winsock2.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Data Types
+ ****************************************/
+
+/**
+ * \brief A reader-writer lock.
+ *
+ * Any number of readers hold the lock together while a writer holds it
+ * alone, so read-mostly tables do not serialize their lookups. A writer
+ * preferring lock blocks new readers as soon as a writer waits, which
+ * keeps a steady stream of readers from starving updates.
+ */
+typedef struct _CGRWLock {
+#if defined(WIN32) && !defined(ITRON)
+  SRWLOCK lockId;
+#else
+  pthread_rwlock_t lockId;
+#endif
+  bool writerPreferred;
+} CGRWLock;
+
+/****************************************
+ * Functions
+ ****************************************/
+
+/**
+ * Create a new reader-writer lock with the platform default policy
+ */
+CGRWLock* cg_rwlock_new(void);
+
+/**
+ * Create a new reader-writer lock which prefers writers where the
+ * platform allows to choose
+ */
+CGRWLock* cg_rwlock_writerpreferred_new(void);
+
+/**
+ * Destroy a reader-writer lock
+ *
+ * \param lock The lock to destroy
+ */
+bool cg_rwlock_delete(CGRWLock* lock);
+
+/**
+ * Acquire and release the lock shared with other readers
+ *
+ * \param lock The lock in question
+ */
+bool cg_rwlock_readlock(CGRWLock* lock);
+bool cg_rwlock_tryreadlock(CGRWLock* lock);
+bool cg_rwlock_readunlock(CGRWLock* lock);
+
+/**
+ * Acquire and release the lock exclusively
+ *
+ * \param lock The lock in question
+ */
+bool cg_rwlock_writelock(CGRWLock* lock);
+bool cg_rwlock_trywritelock(CGRWLock* lock);
+bool cg_rwlock_writeunlock(CGRWLock* lock);
+
+#define cg_rwlock_iswriterpreferred(lock) ((lock)->writerPreferred)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CGPR_UTIL_RWLOCK_H_ */
@@ -0,0 +1,181 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_SCHEDULER_H_
+#define _CGPR_UTIL_SCHEDULER_H_
+
+#include <pthread.h>
+
+#include <cgpr/util/list.h>
+#include <cgpr/util/thread.h>
+#include <cgpr/util/time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_SCHEDULER_WHEEL_BITS 8
+#define CG_SCHEDULER_WHEEL_SIZE (1 << CG_SCHEDULER_WHEEL_BITS)
+#define CG_SCHEDULER_WHEEL_MASK (CG_SCHEDULER_WHEEL_SIZE - 1)
+#define CG_SCHEDULER_WHEEL_LEVELS 4
+
+#define CG_SCHEDULER_DEFAULT_RESOLUTION 1
+
+#define CG_SCHEDULER_TIMER_IDLE 0
+#define CG_SCHEDULER_TIMER_PENDING 1
+#define CG_SCHEDULER_TIMER_RUNNING 2
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+struct _CGScheduler;
+struct _CGSchedulerTimer;
+
+typedef void (*CG_SCHEDULER_TIMER_FUNC)(struct _CGSchedulerTimer* timer, void* userData);
+
+/**
+ * \brief A delayed or periodic task.
+ *
+ * Timers are intrusive list nodes which are linked straight into a slot
+ * of the timing wheel, so scheduling and cancelling never allocate. A
+ * timer belongs to one scheduler while it is pending or running.
+ */
+typedef struct _CGSchedulerTimer {
+  CG_LIST_STRUCT_MEMBERS
+
+  struct _CGScheduler* scheduler;
+  uint64_t expireTick;
+  uint64_t periodTicks;
+  int state;
+  CG_SCHEDULER_TIMER_FUNC func;
+  void* userData;
+} CGSchedulerTimer;
+
+/**
+ * \brief Runs many timers on one thread with a hierarchical timing wheel.
+ *
+ * Time is counted in ticks of the scheduler resolution. Every wheel level
+ * has CG_SCHEDULER_WHEEL_SIZE slots and each level covers the whole range
+ * of the level below it, so a timer is inserted in O(1) and moves down at
+ * most CG_SCHEDULER_WHEEL_LEVELS - 1 times before it expires. Timers which
+ * are due later than the whole wheel wait in the last level and are
+ * placed again whenever their slot comes round.
+ *
+ * Callbacks run on the scheduler thread without the scheduler lock held,
+ * so they may schedule, reschedule or cancel any timer.
+ */
+typedef struct _CGScheduler {
+  pthread_mutex_t mutexId;
+  pthread_cond_t condId;
+  CGList wheel[CG_SCHEDULER_WHEEL_LEVELS][CG_SCHEDULER_WHEEL_SIZE];
+  uint64_t startTime;
+  uint64_t resolution;
+  uint64_t currentTick;
+  uint64_t wakeTick;
+  size_t timerCnt;
+  CGSchedulerTimer* runningTimer;
+  bool runnable;
+  CGThread* thread;
+} CGScheduler;
+
+/****************************************
+ * Function (Timer)
+ ****************************************/
+
+CGSchedulerTimer* cg_scheduler_timer_new(CG_SCHEDULER_TIMER_FUNC func, void* userData);
+
+/**
+ * Delete a timer. A pending timer is cancelled first and a running
+ * callback on another thread is waited for.
+ */
+void cg_scheduler_timer_delete(CGSchedulerTimer* timer);
+
+/**
+ * Initialize a timer which is embedded in another structure.
+ */
+void cg_scheduler_timer_init(CGSchedulerTimer* timer, CG_SCHEDULER_TIMER_FUNC func, void* userData);
+
+#define cg_scheduler_timer_setuserdata(timer, value) ((timer)->userData = value)
+#define cg_scheduler_timer_getuserdata(timer) ((timer)->userData)
+#define cg_scheduler_timer_ispending(timer) (((timer)->state == CG_SCHEDULER_TIMER_PENDING) ? true : false)
+#define cg_scheduler_timer_isperiodic(timer) ((0 < (timer)->periodTicks) ? true : false)
+
+/****************************************
+ * Function (Scheduler)
+ ****************************************/
+
+CGScheduler* cg_scheduler_new(void);
+void cg_scheduler_delete(CGScheduler* sched);
+
+bool cg_scheduler_start(CGScheduler* sched);
+bool cg_scheduler_stop(CGScheduler* sched);
+
+#define cg_scheduler_isrunning(sched) (((sched)->thread != NULL) ? true : false)
+
+/**
+ * Set the tick length in milliseconds. It can only be changed while no
+ * timer is pending.
+ */
+bool cg_scheduler_setresolution(CGScheduler* sched, clock_t mtime);
+clock_t cg_scheduler_getresolution(CGScheduler* sched);
+
+size_t cg_scheduler_size(CGScheduler* sched);
+
+/**
+ * Run the timer once after the delay. A pending timer is moved.
+ */
+bool cg_scheduler_scheduleonce(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay);
+
+/**
+ * Run the timer after the delay and then every period. The period is
+ * kept at a fixed rate, missed runs are skipped rather than queued.
+ */
+bool cg_scheduler_scheduleevery(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay, clock_t period);
+
+/**
+ * Move the next run of the timer, keeping its period.
+ */
+bool cg_scheduler_reschedule(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay);
+
+/**
+ * Cancel the timer. A callback which is already running is not waited
+ * for, but a periodic timer is not armed again.
+ *
+ * \return true if a future run was cancelled
+ */
+bool cg_scheduler_cancel(CGScheduler* sched, CGSchedulerTimer* timer);
+
+/**
+ * Run the timers which are due. The scheduler thread calls this, a
+ * scheduler which is not started can be driven from any loop instead.
+ *
+ * \return Number of callbacks which have been run
+ */
+size_t cg_scheduler_poll(CGScheduler* sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_SCHEDULER_H_
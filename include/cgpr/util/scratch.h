@@ -0,0 +1,95 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_SCRATCH_H_
+#define _CGPR_UTIL_SCRATCH_H_
+
+#include <cgpr/util/typedef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_SCRATCH_BLOCK_DEFAULT_SIZE 4096
+#define CG_SCRATCH_ALIGNMENT 16
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct _CGScratchBlock {
+  struct _CGScratchBlock* next;
+  size_t size;
+  size_t used;
+} CGScratchBlock;
+
+/**
+ * \brief Bump allocator for short-lived temporaries.
+ *
+ * Memory comes from a chain of blocks which are kept when the arena is
+ * rewound, so a steady workload stops touching the heap after warm-up.
+ * Callers take a mark before their allocations and restore it when
+ * done; nested users of the same arena therefore never disturb each
+ * other as long as the marks are restored in reverse order.
+ */
+typedef struct {
+  CGScratchBlock* blocks;
+  CGScratchBlock* current;
+  size_t blockSize;
+} CGScratch;
+
+typedef struct {
+  CGScratchBlock* block;
+  size_t used;
+} CGScratchMark;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGScratch* cg_scratch_new(void);
+void cg_scratch_delete(CGScratch* scratch);
+
+/**
+ * Get the arena of the calling thread. It is created on first use and
+ * released when the thread exits.
+ */
+CGScratch* cg_scratch_get(void);
+
+void* cg_scratch_alloc(CGScratch* scratch, size_t size);
+char* cg_scratch_strdup(CGScratch* scratch, const char* str);
+
+CGScratchMark cg_scratch_mark(CGScratch* scratch);
+void cg_scratch_restore(CGScratch* scratch, CGScratchMark mark);
+void cg_scratch_reset(CGScratch* scratch);
+
+size_t cg_scratch_getcapacity(CGScratch* scratch);
+
+#define cg_scratch_setblocksize(scratch, value) ((scratch)->blockSize = value)
+#define cg_scratch_getblocksize(scratch) ((scratch)->blockSize)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_SCRATCH_H_
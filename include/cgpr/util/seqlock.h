@@ -0,0 +1,101 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_SEQLOCK_H_
+#define _CGPR_UTIL_SEQLOCK_H_
+
+#include <cgpr/util/typedef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Data Types
+ ****************************************/
+
+/**
+ * \brief A sequence lock for small plain-data snapshots.
+ *
+ * Writers make the sequence odd, update the data and make it even again.
+ * Readers never block or write shared memory: they copy the data and
+ * retry when the sequence was odd or has moved meanwhile. Writers are
+ * serialized by the sequence itself, so the lock suits rarely updated
+ * data which many threads read, such as counters or configuration
+ * snapshots. The data must not contain pointers which a writer frees.
+ */
+typedef struct _CGSeqLock {
+  unsigned int seq;
+} CGSeqLock;
+
+/****************************************
+ * Functions
+ ****************************************/
+
+CGSeqLock* cg_seqlock_new(void);
+bool cg_seqlock_delete(CGSeqLock* lock);
+
+/**
+ * Initialize a sequence lock which is embedded in another structure.
+ */
+void cg_seqlock_init(CGSeqLock* lock);
+
+/**
+ * Begin and end an update. Updates from other threads wait in between.
+ */
+void cg_seqlock_writebegin(CGSeqLock* lock);
+void cg_seqlock_writeend(CGSeqLock* lock);
+
+/**
+ * Begin a read section.
+ *
+ * \return Sequence to pass to cg_seqlock_readretry()
+ */
+unsigned int cg_seqlock_readbegin(CGSeqLock* lock);
+
+/**
+ * Check whether the data read since cg_seqlock_readbegin() may be torn.
+ *
+ * \return true if the read section has to be repeated
+ */
+bool cg_seqlock_readretry(CGSeqLock* lock, unsigned int seq);
+
+/**
+ * Copy shared data inside a read or write section. Plain memcpy() would
+ * race with the writer, these copies are made of relaxed atomic accesses.
+ */
+void cg_seqlock_copy(void* dst, const void* src, size_t size);
+
+/**
+ * Store a snapshot as one update.
+ */
+void cg_seqlock_write(CGSeqLock* lock, void* data, const void* value, size_t size);
+
+/**
+ * Load a consistent snapshot, retrying while it is updated.
+ */
+void cg_seqlock_read(CGSeqLock* lock, const void* data, void* value, size_t size);
+
+#define cg_seqlock_getsequence(lock) ((lock)->seq)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CGPR_UTIL_SEQLOCK_H_ */
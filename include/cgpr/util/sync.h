@@ -0,0 +1,145 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_SYNC_H_
+#define _CGPR_UTIL_SYNC_H_
+
+#include <cgpr/util/time.h>
+#include <cgpr/util/typedef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Data Types
+ ****************************************/
+
+/**
+ * \brief An event which threads wait for until it is set.
+ *
+ * A manual reset event stays set and releases every waiter until it is
+ * reset. An auto reset event releases one waiter and is reset by it.
+ *
+ * All primitives in this header keep their state in one word which is
+ * changed with atomic operations, so they only enter the kernel when a
+ * thread really has to sleep or a sleeping thread has to be woken. On
+ * Linux the word is waited on with futex(2), elsewhere with a table of
+ * condition variables hashed by address.
+ */
+typedef struct _CGEvent {
+  int state;
+  int waiterCnt;
+  bool manualReset;
+} CGEvent;
+
+/**
+ * \brief A counting semaphore.
+ */
+typedef struct _CGSemaphore {
+  int count;
+  int waiterCnt;
+} CGSemaphore;
+
+/**
+ * \brief A reusable barrier for a fixed number of threads.
+ */
+typedef struct _CGBarrier {
+  int threshold;
+  int arrivedCnt;
+  int generation;
+} CGBarrier;
+
+/**
+ * \brief Waits until a group of tasks is done.
+ */
+typedef struct _CGWaitGroup {
+  int count;
+  int waiterCnt;
+} CGWaitGroup;
+
+/****************************************
+ * Function (Event)
+ ****************************************/
+
+CGEvent* cg_event_new(bool manualReset);
+bool cg_event_delete(CGEvent* ev);
+
+bool cg_event_set(CGEvent* ev);
+bool cg_event_reset(CGEvent* ev);
+bool cg_event_wait(CGEvent* ev);
+bool cg_event_timedwait(CGEvent* ev, clock_t mtime);
+bool cg_event_isset(CGEvent* ev);
+
+#define cg_event_ismanualreset(ev) ((ev)->manualReset)
+
+/****************************************
+ * Function (Semaphore)
+ ****************************************/
+
+CGSemaphore* cg_semaphore_new(int count);
+bool cg_semaphore_delete(CGSemaphore* sem);
+
+bool cg_semaphore_post(CGSemaphore* sem, int count);
+bool cg_semaphore_wait(CGSemaphore* sem);
+bool cg_semaphore_trywait(CGSemaphore* sem);
+bool cg_semaphore_timedwait(CGSemaphore* sem, clock_t mtime);
+int cg_semaphore_getcount(CGSemaphore* sem);
+
+/****************************************
+ * Function (Barrier)
+ ****************************************/
+
+CGBarrier* cg_barrier_new(int threshold);
+bool cg_barrier_delete(CGBarrier* barrier);
+
+/**
+ * Wait until the threshold of threads has arrived. The barrier is ready
+ * for the next round as soon as it opens.
+ *
+ * \return true for exactly one of the threads of a round
+ */
+bool cg_barrier_wait(CGBarrier* barrier);
+
+#define cg_barrier_getthreshold(barrier) ((barrier)->threshold)
+
+/****************************************
+ * Function (WaitGroup)
+ ****************************************/
+
+CGWaitGroup* cg_waitgroup_new(void);
+bool cg_waitgroup_delete(CGWaitGroup* wg);
+
+/**
+ * Add to the number of tasks, a negative value marks tasks as done.
+ *
+ * \return false if the count would become negative
+ */
+bool cg_waitgroup_add(CGWaitGroup* wg, int count);
+bool cg_waitgroup_wait(CGWaitGroup* wg);
+bool cg_waitgroup_timedwait(CGWaitGroup* wg, clock_t mtime);
+int cg_waitgroup_getcount(CGWaitGroup* wg);
+
+#define cg_waitgroup_done(wg) cg_waitgroup_add(wg, -1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CGPR_UTIL_SYNC_H_ */
@@ -24,6 +24,7 @@
 #endif
 
 #include <cgpr/util/cond.h>
+#include <cgpr/util/cpu.h>
 #include <cgpr/util/list.h>
 
 #include <cgpr/util/time.h>
@@ -61,6 +62,10 @@ extern "C" {
 /* ADD END Fabrice Fontaine Orange 24/04/2007 */
 #endif
 
+#define CG_THREAD_SCHED_OTHER 0
+#define CG_THREAD_SCHED_FIFO 1
+#define CG_THREAD_SCHED_RR 2
+
 /****************************************
  * Data Type
  ****************************************/
@@ -103,8 +108,37 @@ typedef struct _CGThread {
   /** The POSIX thread handle */
   pthread_t pThread;
 
+  /** Stop token which becomes readable when the thread is asked to stop (eventfd or pipe) */
+  int stopFds[2];
+
+  /** Kernel thread id, published by the thread itself so that its nice value can be changed */
+  pid_t tid;
+
 #endif
 
+  /** Whether the thread is created joinable instead of detached */
+  bool joinable;
+
+  /** Whether a joinable thread still has to be joined */
+  bool joinPending;
+
+  /** Set by the thread itself as the last step of the worker function */
+  bool exitFlag;
+
+  /** CPUs the thread may run on, NULL for no restriction */
+  CGCpuSet* affinity;
+
+  /** Preferred NUMA node for memory allocations, CG_CPU_NODE_NONE for the default policy */
+  int numaNode;
+
+  /** Nice value, applied only when niceFlag is set */
+  int niceValue;
+  bool niceFlag;
+
+  /** Scheduling policy (CG_THREAD_SCHED_*) and its real-time priority */
+  int schedPolicy;
+  int schedPriority;
+
   /** Thread's worker function */
   void (*action)(struct _CGThread*);
 
@@ -117,6 +151,26 @@ typedef struct _CGThread {
  */
 typedef void (*CG_THREAD_FUNC)(CGThread*);
 
+/**
+ * Prototype for the destructors of thread-local values
+ */
+typedef void (*CG_THREAD_KEY_DESTRUCTORFUNC)(void*);
+
+/**
+ * \brief A thread-local storage slot.
+ *
+ * Every thread sees its own value for the same key. When a thread exits
+ * with a non-NULL value the destructor of the key is called with it.
+ */
+typedef struct {
+#if defined(WIN32) && !defined(ITRON)
+  DWORD index;
+#else
+  pthread_key_t key;
+#endif
+  CG_THREAD_KEY_DESTRUCTORFUNC destructor;
+} CGThreadKey;
+
 /****************************************
  * Function
  ****************************************/
@@ -153,6 +207,53 @@ bool cg_thread_start(CGThread* thread);
  */
 bool cg_thread_stop(CGThread* thread);
 
+/**
+ * Ask a running thread to stop without waiting for it. Clears the
+ * runnable flag and signals the stop token.
+ *
+ * \param thread Thread to signal
+ */
+bool cg_thread_signalstop(CGThread* thread);
+
+/**
+ * Wait until the thread has left its worker function, joining it when it
+ * is joinable.
+ *
+ * \param thread Thread to wait for
+ * \param timeout Maximum wait in milliseconds
+ *
+ * \return true if the thread has exited, false on timeout
+ */
+bool cg_thread_join(CGThread* thread, clock_t timeout);
+
+/**
+ * Sleep in a worker function until the timeout expires or the thread is
+ * asked to stop, whichever comes first.
+ *
+ * \param thread The calling thread
+ * \param mtime Maximum sleep in milliseconds
+ *
+ * \return true if the thread should stop
+ */
+bool cg_thread_waitstop(CGThread* thread, clock_t mtime);
+
+/**
+ * Get the stop token, a descriptor which becomes readable when the thread
+ * is asked to stop, so that it can be polled with other descriptors.
+ *
+ * \param thread Thread struct
+ *
+ * \return The descriptor, or -1 before the thread has been started
+ */
+int cg_thread_getstopfd(CGThread* thread);
+
+/**
+ * Create the thread joinable so that it is joined instead of waited for.
+ * Must be set before cg_thread_start().
+ */
+#define cg_thread_setjoinable(thread, flag) ((thread)->joinable = flag)
+#define cg_thread_isjoinable(thread) ((thread)->joinable)
+
 /**
  * Stop the running thread and signal the given CGCond.
  */
@@ -206,6 +307,62 @@ void cg_thread_monitor(CGThread* thread);
 #define cg_thread_next(thread) (CGThread*)cg_list_next((CGList*)thread)
 #define cg_thread_remove(thread) cg_list_remove((CGList*)thread)
 
+/****************************************
+ * Function (Placement and Scheduling)
+ ****************************************/
+
+/**
+ * Restrict the thread to a set of CPUs. May be called before the thread is
+ * started or while it runs.
+ *
+ * \param thread Thread struct
+ * \param cpuSet CPUs to run on, NULL to allow every CPU
+ *
+ * \return false if the set is rejected or affinity is not supported
+ */
+bool cg_thread_setaffinity(CGThread* thread, const CGCpuSet* cpuSet);
+
+/**
+ * Pin the thread to a single CPU.
+ */
+bool cg_thread_setcpu(CGThread* thread, int cpu);
+
+/**
+ * Get the CPUs the thread may run on.
+ */
+bool cg_thread_getaffinity(CGThread* thread, CGCpuSet* cpuSet);
+
+/**
+ * Place the thread on a NUMA node: it is restricted to the CPUs of the node
+ * and its memory is preferably allocated there. The memory preference is
+ * applied when the thread starts, or at once when a thread sets it on itself.
+ *
+ * \param thread Thread struct
+ * \param node NUMA node, CG_CPU_NODE_NONE to clear the placement
+ */
+bool cg_thread_setnumanode(CGThread* thread, int node);
+
+/**
+ * Set the nice value of the thread, before or after it is started.
+ */
+bool cg_thread_setnice(CGThread* thread, int niceValue);
+
+/**
+ * Set the scheduling policy. CG_THREAD_SCHED_FIFO and CG_THREAD_SCHED_RR
+ * are real-time policies and usually need privileges; when they are set
+ * before the start, cg_thread_start() fails if they are refused.
+ *
+ * \param thread Thread struct
+ * \param policy CG_THREAD_SCHED_OTHER, CG_THREAD_SCHED_FIFO or CG_THREAD_SCHED_RR
+ * \param priority Real-time priority, ignored for CG_THREAD_SCHED_OTHER
+ */
+bool cg_thread_setschedpolicy(CGThread* thread, int policy, int priority);
+
+#define cg_thread_getnumanode(thread) ((thread)->numaNode)
+#define cg_thread_getnice(thread) ((thread)->niceValue)
+#define cg_thread_getschedpolicy(thread) ((thread)->schedPolicy)
+#define cg_thread_getschedpriority(thread) ((thread)->schedPriority)
+
 /****************************************
  * Function (Thread List)
  ****************************************/
@@ -270,12 +427,51 @@ void cg_threadlist_delete(CGThreadList* threadList);
 bool cg_threadlist_start(CGThreadList* threadList);
 
 /**
- * Stop all threads in the thread list
+ * Stop all threads in the thread list. Every thread is signalled first
+ * and then waited for, so the threads shut down in parallel.
  *
  * \param threadList The thread list in question
  */
 bool cg_threadlist_stop(CGThreadList* threadList);
 
+/****************************************
+ * Function (Thread Key)
+ ****************************************/
+
+/**
+ * Create a new thread-local key
+ *
+ * \param destructor Called with the value of every exiting thread, may be NULL
+ *
+ * \return Thread key, NULL on failure
+ */
+CGThreadKey* cg_thread_key_new(CG_THREAD_KEY_DESTRUCTORFUNC destructor);
+
+/**
+ * Destroy a thread-local key. The destructor is not called for values
+ * which are still set, as with pthread_key_delete().
+ *
+ * \param key The key in question
+ */
+void cg_thread_key_delete(CGThreadKey* key);
+
+/**
+ * Set the value of the calling thread
+ *
+ * \param key The key in question
+ * \param value The new value
+ */
+bool cg_thread_key_setvalue(CGThreadKey* key, void* value);
+
+/**
+ * Get the value of the calling thread
+ *
+ * \param key The key in question
+ *
+ * \return The value, NULL if the thread has not set one
+ */
+void* cg_thread_key_getvalue(CGThreadKey* key);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,126 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#ifndef _CGPR_UTIL_THREAD_POOL_H_
+#define _CGPR_UTIL_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <cgpr/util/cpu.h>
+#include <cgpr/util/mutex.h>
+#include <cgpr/util/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_THREAD_POOL_DEQUE_INITIAL_CAPACITY 256
+#define CG_THREAD_POOL_QUEUE_INITIAL_CAPACITY 256
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef void (*CG_THREAD_POOL_FUNC)(void*);
+
+typedef struct {
+  CG_THREAD_POOL_FUNC func;
+  void* userData;
+} CGThreadPoolTask;
+
+typedef struct _CGThreadPoolTaskArray {
+  int64_t capacity;
+  struct _CGThreadPoolTaskArray* retired;
+  CGThreadPoolTask tasks[1];
+} CGThreadPoolTaskArray;
+
+/**
+ * \brief Chase-Lev work-stealing deque of a worker.
+ *
+ * The owner pushes and takes at the bottom without a lock while other
+ * workers steal from the top with one compare-and-swap. Grown arrays are
+ * retired instead of freed because a thief may still read them.
+ */
+typedef struct {
+  int64_t top;
+  int64_t bottom;
+  CGThreadPoolTaskArray* array;
+} CGThreadPoolDeque;
+
+typedef struct {
+  CGThreadPoolDeque deque;
+  struct _CGThreadPool* pool;
+  CGThread* thread;
+  uint64_t randState;
+} CGThreadPoolWorker;
+
+/**
+ * \brief Fixed set of worker threads running short tasks.
+ *
+ * Tasks submitted from a worker go to its own deque, tasks from other
+ * threads to a shared injection queue, and idle workers steal from each
+ * other before they sleep. Submitting only signals a worker when one is
+ * asleep, so the common case costs a few atomic operations. With core
+ * pinning the workers are laid out one per physical core.
+ */
+typedef struct _CGThreadPool {
+  CGThreadPoolWorker* workers;
+  size_t workerCnt;
+  CGMutex* mutex;
+  CGThreadPoolTask* queue;
+  size_t queueHead;
+  size_t queueCnt;
+  size_t queueCapacity;
+  int64_t pendingCnt;
+  int sleeperCnt;
+  int waiterCnt;
+  int wakePipe[2];
+  int donePipe[2];
+  bool running;
+  bool corePinned;
+} CGThreadPool;
+
+/****************************************
+ * Function
+ ****************************************/
+
+CGThreadPool* cg_thread_pool_new(size_t workerCnt);
+void cg_thread_pool_delete(CGThreadPool* pool);
+
+#define cg_thread_pool_getworkercount(pool) ((pool)->workerCnt)
+#define cg_thread_pool_setcorepinned(pool, flag) ((pool)->corePinned = flag)
+#define cg_thread_pool_iscorepinned(pool) ((pool)->corePinned)
+size_t cg_thread_pool_getpendingcount(CGThreadPool* pool);
+
+bool cg_thread_pool_start(CGThreadPool* pool);
+bool cg_thread_pool_stop(CGThreadPool* pool);
+bool cg_thread_pool_isrunning(CGThreadPool* pool);
+
+bool cg_thread_pool_submit(CGThreadPool* pool, CG_THREAD_POOL_FUNC func, void* userData);
+void cg_thread_pool_wait(CGThreadPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CGPR_UTIL_THREAD_POOL_H_
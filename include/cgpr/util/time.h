@@ -23,6 +23,7 @@
 #include "config.h"
 #endif
 
+#include <stdint.h>
 #include <time.h>
 
 #ifdef __cplusplus
@@ -43,6 +44,9 @@ void cg_waitrandom(clock_t mtime);
 
 clock_t cg_getcurrentsystemtime(void);
 
+uint64_t cg_getmonotonicnanotime(void);
+void cg_waitnano(uint64_t nsec);
+
 #ifdef __cplusplus
 }
 #endif
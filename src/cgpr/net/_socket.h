@@ -0,0 +1,95 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef __CGPR_NET_SOCKET_H_
+#define __CGPR_NET_SOCKET_H_
+
+#include <cgpr/net/socket.h>
+#include <cgpr/net/socket_impairment.h>
+#include <cgpr/util/_atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_SEND_RETRY_CNT 10
+#define CG_NET_SOCKET_SEND_RETRY_WAIT_MSEC 20
+#define CG_NET_SOCKET_WRITEV_MAX 16
+
+/****************************************
+ * Statistics
+ ****************************************/
+
+#define CG_NET_SOCKET_STATS_SHARD_CNT 16
+
+#if defined(WIN32)
+#define CG_NET_SOCKET_STATS_TLS __declspec(thread)
+#define CG_NET_SOCKET_STATS_ALIGNED __declspec(align(64))
+#else
+#define CG_NET_SOCKET_STATS_TLS __thread
+#define CG_NET_SOCKET_STATS_ALIGNED __attribute__((aligned(64)))
+#endif
+
+/* The global totals are split over cache line aligned shards and every thread bumps only its own shard */
+typedef struct CG_NET_SOCKET_STATS_ALIGNED {
+  CGSocketStats stats;
+} CGSocketStatsShard;
+
+extern CGSocketStatsShard _gSocketStatsShards[CG_NET_SOCKET_STATS_SHARD_CNT];
+extern CG_NET_SOCKET_STATS_TLS CGSocketStats* _gSocketStatsShard;
+
+CGSocketStats* cg_socket_stats_assignshard(void);
+
+#define cg_socket_stats_getshard() (_gSocketStatsShard ? _gSocketStatsShard : cg_socket_stats_assignshard())
+
+#define cg_socket_stats_add(sock, member, val)                          \
+  do {                                                                  \
+    cg_atomic_add(&(sock)->stats.member, (uint64_t)(val));              \
+    cg_atomic_add(&cg_socket_stats_getshard()->member, (uint64_t)(val)); \
+  } while (0)
+
+#define cg_socket_stats_inc(sock, member) cg_socket_stats_add(sock, member, 1)
+
+/****************************************
+ * Pacing
+ ****************************************/
+
+bool cg_socket_pacer_apply(CGSocket* sock);
+void cg_socket_pacer_wait(CGSocket* sock, size_t dataLen);
+
+/****************************************
+ * Zero Copy
+ ****************************************/
+
+bool cg_socket_zerocopy_apply(CGSocket* sock);
+
+/****************************************
+ * Impairment
+ ****************************************/
+
+ssize_t cg_socket_impairment_enqueue(CGSocketImpairment* imp, CGSocket* sock, const void* data, size_t dataLen, const struct sockaddr* toAddr, socklen_t toAddrLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CGPR_NET_SOCKET_H_
@@ -35,6 +35,7 @@ CGDatagramPacket* cg_socket_datagram_packet_new(void)
 
   dgmPkt->data = NULL;
   dgmPkt->dataLen = 0;
+  dgmPkt->dataCapacity = 0;
 
   dgmPkt->localAddr = cg_string_new();
   cg_socket_datagram_packet_setlocalport(dgmPkt, 0);
@@ -42,6 +43,10 @@ CGDatagramPacket* cg_socket_datagram_packet_new(void)
   dgmPkt->remoteAddr = cg_string_new();
   cg_socket_datagram_packet_setremoteport(dgmPkt, 0);
 
+  dgmPkt->destAddr = cg_string_new();
+  cg_socket_datagram_packet_setifindex(dgmPkt, 0);
+  cg_socket_datagram_packet_settimestamp(dgmPkt, 0);
+
   return dgmPkt;
 }
 
@@ -58,6 +63,7 @@ void cg_socket_datagram_packet_delete(CGDatagramPacket* dgmPkt)
 
   cg_string_delete(dgmPkt->localAddr);
   cg_string_delete(dgmPkt->remoteAddr);
+  cg_string_delete(dgmPkt->destAddr);
 
   free(dgmPkt);
 }
@@ -68,17 +74,24 @@ void cg_socket_datagram_packet_delete(CGDatagramPacket* dgmPkt)
 
 bool cg_socket_datagram_packet_setdata(CGDatagramPacket* dgmPkt, const byte* data, size_t dataLen)
 {
+  byte* buf;
+
   if (!dgmPkt)
     return false;
 
-  cg_socket_datagram_packet_clear(dgmPkt);
-
   if (!data || (dataLen <= 0))
-    return true;
-
-  dgmPkt->data = malloc(dataLen);
-  if (!dgmPkt->data)
-    return false;
+    return cg_socket_datagram_packet_clear(dgmPkt);
+
+  /* A packet reused for receiving keeps its buffer, it only grows for a larger datagram */
+  if (dgmPkt->dataCapacity < dataLen) {
+    buf = (byte*)realloc(dgmPkt->data, dataLen);
+    if (!buf) {
+      cg_socket_datagram_packet_clear(dgmPkt);
+      return false;
+    }
+    dgmPkt->data = buf;
+    dgmPkt->dataCapacity = dataLen;
+  }
 
   memcpy(dgmPkt->data, data, dataLen);
   dgmPkt->dataLen = dataLen;
@@ -100,6 +113,7 @@ bool cg_socket_datagram_packet_clear(CGDatagramPacket* dgmPkt)
     dgmPkt->data = NULL;
   }
   dgmPkt->dataLen = 0;
+  dgmPkt->dataCapacity = 0;
 
   return true;
 }
@@ -118,6 +132,9 @@ bool cg_socket_datagram_packet_copy(CGDatagramPacket* dstDgmPkt, CGDatagramPacke
   cg_socket_datagram_packet_setlocalport(dstDgmPkt, cg_socket_datagram_packet_getlocalport(srcDgmPkt));
   cg_socket_datagram_packet_setremoteAddr(dstDgmPkt, cg_socket_datagram_packet_getremoteAddr(srcDgmPkt));
   cg_socket_datagram_packet_setremoteport(dstDgmPkt, cg_socket_datagram_packet_getremoteport(srcDgmPkt));
+  cg_socket_datagram_packet_setdestAddr(dstDgmPkt, cg_socket_datagram_packet_getdestAddr(srcDgmPkt));
+  cg_socket_datagram_packet_setifindex(dstDgmPkt, cg_socket_datagram_packet_getifindex(srcDgmPkt));
+  cg_socket_datagram_packet_settimestamp(dstDgmPkt, cg_socket_datagram_packet_gettimestamp(srcDgmPkt));
 
   return true;
 }
@@ -362,29 +362,36 @@ size_t cg_net_gethostinterfaces(CGNetworkInterfaceList* netIf_list)
 #endif
 
 /****************************************
- * cg_net_selectaddr
+ * cg_net_selectaddrto
  ****************************************/
 
 #if !defined(HAVE_IFADDRS_H) || defined(TARGET_OS_IPHONE) || defined(TARGET_IPHONE_SIMULATOR)
 
-char* cg_net_selectaddr(struct sockaddr* remoteaddr)
+bool cg_net_selectaddrto(struct sockaddr* remoteaddr, char* addrBuf, size_t addrBufLen)
 {
   CGNetworkInterfaceList* netIfList;
   CGNetworkInterface* netIf;
   CGNetworkInterface* selectNetIf;
-  char* selectNetIfAddr;
   u_long laddr, lmask, raddr;
   struct addrinfo hints;
   struct addrinfo* netIfAddrInfo;
   struct addrinfo* netMaskAddrInfo;
 
+  if (!addrBuf || (addrBufLen <= 0))
+    return false;
+
   netIfList = cg_net_interfacelist_new();
-  if (!netIfList)
-    return cg_strdup("127.0.0.1");
+  if (!netIfList) {
+    cg_strncpy(addrBuf, "127.0.0.1", addrBufLen - 1);
+    addrBuf[addrBufLen - 1] = '\0';
+    return true;
+  }
 
   if (cg_net_gethostinterfaces(netIfList) <= 0) {
     cg_net_interfacelist_delete(netIfList);
-    return cg_strdup("127.0.0.1");
+    cg_strncpy(addrBuf, "127.0.0.1", addrBufLen - 1);
+    addrBuf[addrBufLen - 1] = '\0';
+    return true;
   }
 
   raddr = ntohl(((struct sockaddr_in*)remoteaddr)->sin_addr.s_addr);
@@ -415,26 +422,36 @@ char* cg_net_selectaddr(struct sockaddr* remoteaddr)
   if (!selectNetIf)
     selectNetIf = cg_net_interfacelist_gets(netIfList);
 
-  selectNetIfAddr = cg_strdup(cg_net_interface_getaddress(selectNetIf));
+  cg_strncpy(addrBuf, cg_net_interface_getaddress(selectNetIf), addrBufLen - 1);
+  addrBuf[addrBufLen - 1] = '\0';
 
   cg_net_interfacelist_delete(netIfList);
 
-  return selectNetIfAddr;
+  return true;
 }
 #else
 
-char* cg_net_selectaddr(struct sockaddr* remoteaddr)
+bool cg_net_selectaddrto(struct sockaddr* remoteaddr, char* addrBuf, size_t addrBufLen)
 {
   struct ifaddrs *ifaddrs, *ifaddr;
   uint32_t laddr, lmask, raddr;
-  char *address_candidate = NULL, *auto_ip_address_candidate = NULL;
+  char addrCandidate[CG_NET_ADDRSTRING_MAXSIZE];
+  char autoIpAddrCandidate[CG_NET_ADDRSTRING_MAXSIZE];
+  const char* selectAddr;
+
+  if (!addrBuf || (addrBufLen <= 0))
+    return false;
 
   raddr = ntohl(((struct sockaddr_in*)remoteaddr)->sin_addr.s_addr);
 
   if (0 != getifaddrs(&ifaddrs)) {
-    return NULL;
+    return false;
   }
 
+  /* Candidates are formatted into fixed buffers, no heap copies are made per interface */
+  addrCandidate[0] = '\0';
+  autoIpAddrCandidate[0] = '\0';
+
   for (ifaddr = ifaddrs; NULL != ifaddr; ifaddr = ifaddr->ifa_next) {
     if (ifaddr->ifa_addr == NULL)
       continue;
@@ -454,43 +471,47 @@ char* cg_net_selectaddr(struct sockaddr* remoteaddr)
 
     /* Checking if we have an exact subnet match */
     if ((laddr & lmask) == (raddr & lmask)) {
-      if (NULL != address_candidate)
-        free(address_candidate);
-      address_candidate = cg_strdup(inet_ntoa((struct in_addr)((struct sockaddr_in*)ifaddr->ifa_addr)->sin_addr));
+      inet_ntop(AF_INET, &((struct sockaddr_in*)ifaddr->ifa_addr)->sin_addr, addrCandidate, sizeof(addrCandidate));
       break;
     }
 
     /* Checking if we have and auto ip address */
     if ((laddr & lmask) == CG_NET_SOCKET_AUTO_IP_NET) {
-      if (NULL != auto_ip_address_candidate)
-        free(auto_ip_address_candidate);
-      auto_ip_address_candidate = cg_strdup(
-          inet_ntoa((struct in_addr)((struct sockaddr_in*)ifaddr->ifa_addr)->sin_addr));
+      inet_ntop(AF_INET, &((struct sockaddr_in*)ifaddr->ifa_addr)->sin_addr, autoIpAddrCandidate, sizeof(autoIpAddrCandidate));
     }
     /* Good. We have others than auto ips present. */
     else {
-      if (NULL != address_candidate)
-        free(address_candidate);
-      address_candidate = cg_strdup(
-          inet_ntoa((struct in_addr)((struct sockaddr_in*)ifaddr->ifa_addr)->sin_addr));
+      inet_ntop(AF_INET, &((struct sockaddr_in*)ifaddr->ifa_addr)->sin_addr, addrCandidate, sizeof(addrCandidate));
     }
   }
 
   freeifaddrs(ifaddrs);
 
-  if (NULL != address_candidate) {
-    if (NULL != auto_ip_address_candidate)
-      free(auto_ip_address_candidate);
-    return address_candidate;
-  }
+  if (0 < cg_strlen(addrCandidate))
+    selectAddr = addrCandidate;
+  else if (0 < cg_strlen(autoIpAddrCandidate))
+    selectAddr = autoIpAddrCandidate;
+  else
+    selectAddr = "127.0.0.1";
 
-  if (NULL != auto_ip_address_candidate) {
-    if (NULL != address_candidate)
-      free(address_candidate);
-    return auto_ip_address_candidate;
-  }
+  cg_strncpy(addrBuf, selectAddr, addrBufLen - 1);
+  addrBuf[addrBufLen - 1] = '\0';
 
-  return cg_strdup("127.0.0.1");
+  return true;
 }
 
 #endif
+
+/****************************************
+ * cg_net_selectaddr
+ ****************************************/
+
+char* cg_net_selectaddr(struct sockaddr* remoteaddr)
+{
+  char addrBuf[CG_NET_ADDRSTRING_MAXSIZE];
+
+  if (!cg_net_selectaddrto(remoteaddr, addrBuf, sizeof(addrBuf)))
+    return NULL;
+
+  return cg_strdup(addrBuf);
+}
@@ -0,0 +1,342 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <string.h>
+
+#include <cgpr/net/_socket.h>
+#include <cgpr/net/multicast_sender.h>
+#include <cgpr/util/logs.h>
+
+#if defined(WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <net/if.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_MULTICAST_SENDER_INITIAL_CAPACITY 4
+
+/****************************************
+ * cg_multicast_sender_applyttl
+ ****************************************/
+
+static bool cg_multicast_sender_applyttl(CGMulticastSenderInterface* mif, int ttl)
+{
+  int hops;
+  unsigned char ttlVal;
+
+  if (mif->family == AF_INET6) {
+    hops = ttl;
+    return (setsockopt(cg_socket_getid(mif->sock), IPPROTO_IPV6, IPV6_MULTICAST_HOPS, (const char*)&hops, sizeof(hops)) == 0) ? true : false;
+  }
+
+  ttlVal = (unsigned char)ttl;
+  return (setsockopt(cg_socket_getid(mif->sock), IPPROTO_IP, IP_MULTICAST_TTL, (const char*)&ttlVal, sizeof(ttlVal)) == 0) ? true : false;
+}
+
+/****************************************
+ * cg_multicast_sender_applyloop
+ ****************************************/
+
+static bool cg_multicast_sender_applyloop(CGMulticastSenderInterface* mif, bool flag)
+{
+  unsigned int loop6;
+  unsigned char loop;
+
+  if (mif->family == AF_INET6) {
+    loop6 = flag ? 1 : 0;
+    return (setsockopt(cg_socket_getid(mif->sock), IPPROTO_IPV6, IPV6_MULTICAST_LOOP, (const char*)&loop6, sizeof(loop6)) == 0) ? true : false;
+  }
+
+  loop = flag ? 1 : 0;
+  return (setsockopt(cg_socket_getid(mif->sock), IPPROTO_IP, IP_MULTICAST_LOOP, (const char*)&loop, sizeof(loop)) == 0) ? true : false;
+}
+
+/****************************************
+ * cg_multicast_sender_new
+ ****************************************/
+
+CGMulticastSender* cg_multicast_sender_new(void)
+{
+  CGMulticastSender* sender;
+
+  sender = (CGMulticastSender*)malloc(sizeof(CGMulticastSender));
+  if (!sender)
+    return NULL;
+
+  sender->ifs = NULL;
+  sender->ifCnt = 0;
+  sender->ifCapacity = 0;
+  sender->ttl = CG_NET_SOCKET_MULTICAST_DEFAULT_TTL;
+  sender->loop = false;
+
+  return sender;
+}
+
+/****************************************
+ * cg_multicast_sender_delete
+ ****************************************/
+
+void cg_multicast_sender_delete(CGMulticastSender* sender)
+{
+  if (!sender)
+    return;
+
+  cg_multicast_sender_clear(sender);
+  free(sender->ifs);
+  free(sender);
+}
+
+/****************************************
+ * cg_multicast_sender_clear
+ ****************************************/
+
+void cg_multicast_sender_clear(CGMulticastSender* sender)
+{
+  size_t n;
+
+  if (!sender)
+    return;
+
+  for (n = 0; n < sender->ifCnt; n++)
+    cg_socket_delete(sender->ifs[n].sock);
+  sender->ifCnt = 0;
+}
+
+/****************************************
+ * cg_multicast_sender_addinterface
+ ****************************************/
+
+bool cg_multicast_sender_addinterface(CGMulticastSender* sender, CGNetworkInterface* netIf)
+{
+  CGMulticastSenderInterface* mif;
+  CGMulticastSenderInterface* ifs;
+  struct addrinfo hints;
+  struct addrinfo* ifAddrInfo;
+  const char* ifAddr;
+  const char* ifName;
+  size_t ifCapacity;
+  int sockOptRet;
+  SOCKET sockId;
+
+  if (!sender || !netIf)
+    return false;
+
+  ifAddr = cg_net_interface_getaddress(netIf);
+  if (cg_strlen(ifAddr) <= 0)
+    return false;
+
+  if (sender->ifCapacity <= sender->ifCnt) {
+    ifCapacity = (0 < sender->ifCapacity) ? (sender->ifCapacity * 2) : CG_MULTICAST_SENDER_INITIAL_CAPACITY;
+    ifs = (CGMulticastSenderInterface*)realloc(sender->ifs, ifCapacity * sizeof(CGMulticastSenderInterface));
+    if (!ifs)
+      return false;
+    sender->ifs = ifs;
+    sender->ifCapacity = ifCapacity;
+  }
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_flags = AI_NUMERICHOST | AI_PASSIVE;
+  hints.ai_socktype = SOCK_DGRAM;
+  if (getaddrinfo(ifAddr, NULL, &hints, &ifAddrInfo) != 0)
+    return false;
+
+  mif = &sender->ifs[sender->ifCnt];
+  mif->family = ifAddrInfo->ai_family;
+  mif->ifIndex = netIf->index;
+#if !defined(WIN32)
+  ifName = cg_net_interface_getname(netIf);
+  if ((mif->ifIndex <= 0) && (0 < cg_strlen(ifName)))
+    mif->ifIndex = (int)if_nametoindex(ifName);
+#endif
+  if ((mif->ifIndex <= 0) && (mif->family == AF_INET6))
+    mif->ifIndex = (int)((struct sockaddr_in6*)ifAddrInfo->ai_addr)->sin6_scope_id;
+
+  mif->sock = cg_socket_dgram_new();
+  if (!mif->sock) {
+    freeaddrinfo(ifAddrInfo);
+    return false;
+  }
+
+  sockId = socket(ifAddrInfo->ai_family, SOCK_DGRAM, 0);
+  cg_socket_setid(mif->sock, sockId);
+  if (!cg_socket_isbound(mif->sock)) {
+    freeaddrinfo(ifAddrInfo);
+    cg_socket_delete(mif->sock);
+    return false;
+  }
+
+  /* Bind to an ephemeral port on the interface so that the source address is stable */
+  sockOptRet = bind(sockId, ifAddrInfo->ai_addr, ifAddrInfo->ai_addrlen);
+
+  if (sockOptRet == 0) {
+    if (mif->family == AF_INET6) {
+      unsigned int ifIndex = (unsigned int)mif->ifIndex;
+      sockOptRet = setsockopt(sockId, IPPROTO_IPV6, IPV6_MULTICAST_IF, (const char*)&ifIndex, sizeof(ifIndex));
+    }
+    else {
+      struct in_addr ifInAddr = ((struct sockaddr_in*)ifAddrInfo->ai_addr)->sin_addr;
+      sockOptRet = setsockopt(sockId, IPPROTO_IP, IP_MULTICAST_IF, (const char*)&ifInAddr, sizeof(ifInAddr));
+    }
+  }
+
+  freeaddrinfo(ifAddrInfo);
+
+  if ((sockOptRet != 0) || !cg_multicast_sender_applyttl(mif, sender->ttl) || !cg_multicast_sender_applyloop(mif, sender->loop)) {
+    cg_socket_delete(mif->sock);
+    return false;
+  }
+
+  cg_socket_setdirection(mif->sock, CG_NET_SOCKET_CLIENT);
+  cg_socket_setaddress(mif->sock, ifAddr);
+  cg_socket_setport(mif->sock, 0);
+
+  sender->ifCnt++;
+
+  return true;
+}
+
+/****************************************
+ * cg_multicast_sender_addinterfaces
+ ****************************************/
+
+size_t cg_multicast_sender_addinterfaces(CGMulticastSender* sender, CGNetworkInterfaceList* netIfList)
+{
+  CGNetworkInterface* netIf;
+  size_t addedCnt;
+
+  if (!sender || !netIfList)
+    return 0;
+
+  addedCnt = 0;
+  for (netIf = cg_net_interfacelist_gets(netIfList); netIf; netIf = cg_net_interface_next(netIf)) {
+    if (cg_multicast_sender_addinterface(sender, netIf))
+      addedCnt++;
+  }
+
+  return addedCnt;
+}
+
+/****************************************
+ * cg_multicast_sender_setttl
+ ****************************************/
+
+bool cg_multicast_sender_setttl(CGMulticastSender* sender, int ttl)
+{
+  bool isSuccess;
+  size_t n;
+
+  if (!sender)
+    return false;
+
+  sender->ttl = ttl;
+
+  isSuccess = true;
+  for (n = 0; n < sender->ifCnt; n++) {
+    if (!cg_multicast_sender_applyttl(&sender->ifs[n], ttl))
+      isSuccess = false;
+  }
+
+  return isSuccess;
+}
+
+/****************************************
+ * cg_multicast_sender_setloop
+ ****************************************/
+
+bool cg_multicast_sender_setloop(CGMulticastSender* sender, bool flag)
+{
+  bool isSuccess;
+  size_t n;
+
+  if (!sender)
+    return false;
+
+  sender->loop = flag;
+
+  isSuccess = true;
+  for (n = 0; n < sender->ifCnt; n++) {
+    if (!cg_multicast_sender_applyloop(&sender->ifs[n], flag))
+      isSuccess = false;
+  }
+
+  return isSuccess;
+}
+
+/****************************************
+ * cg_multicast_sender_sendto
+ ****************************************/
+
+size_t cg_multicast_sender_sendto(CGMulticastSender* sender, const char* mcastAddr, int port, const byte* data, size_t dataLen)
+{
+  CGMulticastSenderInterface* mif;
+  struct sockaddr_storage toAddr;
+  socklen_t toAddrLen;
+  int family;
+  ssize_t sentLen;
+  size_t sentCnt;
+  size_t n;
+
+  if (!sender || !mcastAddr || !data || (dataLen <= 0))
+    return 0;
+
+  /* Resolve the group once for all interfaces */
+  memset(&toAddr, 0, sizeof(toAddr));
+  if (inet_pton(AF_INET, mcastAddr, &((struct sockaddr_in*)&toAddr)->sin_addr) == 1) {
+    family = AF_INET;
+    ((struct sockaddr_in*)&toAddr)->sin_family = AF_INET;
+    ((struct sockaddr_in*)&toAddr)->sin_port = htons((unsigned short)port);
+    toAddrLen = sizeof(struct sockaddr_in);
+  }
+  else if (inet_pton(AF_INET6, mcastAddr, &((struct sockaddr_in6*)&toAddr)->sin6_addr) == 1) {
+    family = AF_INET6;
+    ((struct sockaddr_in6*)&toAddr)->sin6_family = AF_INET6;
+    ((struct sockaddr_in6*)&toAddr)->sin6_port = htons((unsigned short)port);
+    toAddrLen = sizeof(struct sockaddr_in6);
+  }
+  else {
+    return 0;
+  }
+
+  sentCnt = 0;
+  for (n = 0; n < sender->ifCnt; n++) {
+    mif = &sender->ifs[n];
+    if (mif->family != family)
+      continue;
+    if (family == AF_INET6)
+      ((struct sockaddr_in6*)&toAddr)->sin6_scope_id = (uint32_t)mif->ifIndex;
+    sentLen = sendto(cg_socket_getid(mif->sock), (const char*)data, dataLen, 0, (struct sockaddr*)&toAddr, toAddrLen);
+    cg_net_socket_debug(CG_LOG_NET_PREFIX_SEND, cg_socket_getaddress(mif->sock), mcastAddr, data, dataLen);
+    cg_socket_stats_inc(mif->sock, sendtoCnt);
+    if (0 <= sentLen)
+      cg_socket_stats_add(mif->sock, sendtoBytes, sentLen);
+    else
+      cg_socket_stats_inc(mif->sock, sendtoErrors);
+    if (sentLen == (ssize_t)dataLen)
+      sentCnt++;
+  }
+
+  return sentCnt;
+}
@@ -0,0 +1,521 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cgpr/net/interface.h>
+#include <cgpr/net/socket.h>
+
+#if !defined(WIN32)
+#include <net/if.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_PREFIXTABLE_IPV4_ADDRLEN 4
+#define CG_NET_PREFIXTABLE_IPV6_ADDRLEN 16
+#define CG_NET_PREFIXTABLE_NONE -1
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct {
+  char addr[CG_NET_ADDRSTRING_MAXSIZE];
+  int index;
+} CGNetworkPrefixEntry;
+
+typedef struct {
+  byte prefix[CG_NET_PREFIXTABLE_IPV6_ADDRLEN];
+  int prefixLen;
+  int child[2];
+  int entry;
+} CGNetworkPrefixNode;
+
+typedef struct _CGNetworkPrefixTrie {
+  CGNetworkPrefixEntry* entries;
+  size_t entryCnt;
+  CGNetworkPrefixNode* nodes;
+  size_t nodeCnt;
+  int root[2];
+  int fallback[2];
+  uint32_t fingerprint;
+} CGNetworkPrefixTrie;
+
+/****************************************
+ * cg_net_prefix_getbit
+ ****************************************/
+
+static int cg_net_prefix_getbit(const byte* key, int n)
+{
+  return (key[n >> 3] >> (7 - (n & 7))) & 0x01;
+}
+
+/****************************************
+ * cg_net_prefix_commonlen
+ ****************************************/
+
+static int cg_net_prefix_commonlen(const byte* key1, const byte* key2, int maxLen)
+{
+  int n;
+
+  for (n = 0; n < maxLen; n++) {
+    if (cg_net_prefix_getbit(key1, n) != cg_net_prefix_getbit(key2, n))
+      break;
+  }
+
+  return n;
+}
+
+/****************************************
+ * cg_net_prefix_parseaddr
+ ****************************************/
+
+static int cg_net_prefix_parseaddr(const char* addr, byte* key)
+{
+  char addrBuf[CG_NET_ADDRSTRING_MAXSIZE];
+  ssize_t scopeIdx;
+
+  if (!addr || (cg_strlen(addr) <= 0))
+    return 0;
+
+  cg_strncpy(addrBuf, addr, sizeof(addrBuf) - 1);
+  addrBuf[sizeof(addrBuf) - 1] = '\0';
+
+  if (cg_net_isipv6address(addrBuf) == true) {
+    scopeIdx = cg_strchr(addrBuf, "%", 1);
+    if (0 <= scopeIdx)
+      addrBuf[scopeIdx] = '\0';
+    if (inet_pton(AF_INET6, addrBuf, key) != 1)
+      return 0;
+    return AF_INET6;
+  }
+
+  if (inet_pton(AF_INET, addrBuf, key) != 1)
+    return 0;
+
+  return AF_INET;
+}
+
+/****************************************
+ * cg_net_prefix_masklen
+ ****************************************/
+
+static int cg_net_prefix_masklen(const char* netmask, int family)
+{
+  byte mask[CG_NET_PREFIXTABLE_IPV6_ADDRLEN];
+  int maxLen;
+  int n;
+
+  maxLen = (family == AF_INET6) ? (CG_NET_PREFIXTABLE_IPV6_ADDRLEN * 8) : (CG_NET_PREFIXTABLE_IPV4_ADDRLEN * 8);
+
+  /* An interface without a netmask only matches its own address */
+  if (cg_net_prefix_parseaddr(netmask, mask) != family)
+    return maxLen;
+
+  for (n = 0; n < maxLen; n++) {
+    if (cg_net_prefix_getbit(mask, n) == 0)
+      break;
+  }
+
+  return n;
+}
+
+/****************************************
+ * cg_net_prefix_fingerprint
+ ****************************************/
+
+static uint32_t cg_net_prefix_fingerprint(uint32_t hash, const char* str)
+{
+  /* FNV-1a */
+  if (str) {
+    for (; *str; str++) {
+      hash ^= (byte)*str;
+      hash *= 16777619U;
+    }
+  }
+  hash ^= 0xFF;
+  hash *= 16777619U;
+  return hash;
+}
+
+/****************************************
+ * cg_net_prefix_listfingerprint
+ ****************************************/
+
+static uint32_t cg_net_prefix_listfingerprint(CGNetworkInterfaceList* netIfList)
+{
+  CGNetworkInterface* netIf;
+  uint32_t hash = 2166136261U;
+
+  for (netIf = cg_net_interfacelist_gets(netIfList); netIf; netIf = cg_net_interface_next(netIf)) {
+    hash = cg_net_prefix_fingerprint(hash, cg_net_interface_getname(netIf));
+    hash = cg_net_prefix_fingerprint(hash, cg_net_interface_getaddress(netIf));
+    hash = cg_net_prefix_fingerprint(hash, cg_net_interface_getnetmask(netIf));
+  }
+
+  return hash;
+}
+
+/****************************************
+ * cg_net_prefixtrie_newnode
+ ****************************************/
+
+static int cg_net_prefixtrie_newnode(CGNetworkPrefixTrie* trie, const byte* key, int prefixLen, int entry)
+{
+  CGNetworkPrefixNode* node;
+  int nodeIdx;
+
+  nodeIdx = (int)trie->nodeCnt++;
+  node = &trie->nodes[nodeIdx];
+  memcpy(node->prefix, key, sizeof(node->prefix));
+  node->prefixLen = prefixLen;
+  node->child[0] = CG_NET_PREFIXTABLE_NONE;
+  node->child[1] = CG_NET_PREFIXTABLE_NONE;
+  node->entry = entry;
+
+  return nodeIdx;
+}
+
+/****************************************
+ * cg_net_prefixtrie_insert
+ ****************************************/
+
+static void cg_net_prefixtrie_insert(CGNetworkPrefixTrie* trie, int* slot, const byte* key, int prefixLen, int entry)
+{
+  CGNetworkPrefixNode* node;
+  int nodeIdx, glueIdx, leafIdx;
+  int commonLen;
+
+  while (*slot != CG_NET_PREFIXTABLE_NONE) {
+    node = &trie->nodes[*slot];
+    commonLen = cg_net_prefix_commonlen(node->prefix, key, (node->prefixLen < prefixLen) ? node->prefixLen : prefixLen);
+
+    if (commonLen == node->prefixLen) {
+      if (prefixLen == node->prefixLen) {
+        /* The first interface wins for duplicate prefixes as in cg_net_selectaddr() */
+        if (node->entry == CG_NET_PREFIXTABLE_NONE)
+          node->entry = entry;
+        return;
+      }
+      slot = &node->child[cg_net_prefix_getbit(key, node->prefixLen)];
+      continue;
+    }
+
+    nodeIdx = *slot;
+
+    if (commonLen == prefixLen) {
+      leafIdx = cg_net_prefixtrie_newnode(trie, key, prefixLen, entry);
+      trie->nodes[leafIdx].child[cg_net_prefix_getbit(trie->nodes[nodeIdx].prefix, prefixLen)] = nodeIdx;
+      *slot = leafIdx;
+      return;
+    }
+
+    glueIdx = cg_net_prefixtrie_newnode(trie, key, commonLen, CG_NET_PREFIXTABLE_NONE);
+    leafIdx = cg_net_prefixtrie_newnode(trie, key, prefixLen, entry);
+    trie->nodes[glueIdx].child[cg_net_prefix_getbit(key, commonLen)] = leafIdx;
+    trie->nodes[glueIdx].child[cg_net_prefix_getbit(trie->nodes[nodeIdx].prefix, commonLen)] = nodeIdx;
+    *slot = glueIdx;
+    return;
+  }
+
+  *slot = cg_net_prefixtrie_newnode(trie, key, prefixLen, entry);
+}
+
+/****************************************
+ * cg_net_prefixtrie_delete
+ ****************************************/
+
+static void cg_net_prefixtrie_delete(CGNetworkPrefixTrie* trie)
+{
+  if (!trie)
+    return;
+
+  free(trie->entries);
+  free(trie->nodes);
+  free(trie);
+}
+
+/****************************************
+ * cg_net_prefixtrie_new
+ ****************************************/
+
+static CGNetworkPrefixTrie* cg_net_prefixtrie_new(CGNetworkInterfaceList* netIfList)
+{
+  CGNetworkPrefixTrie* trie;
+  CGNetworkInterface* netIf;
+  CGNetworkPrefixEntry* entry;
+  byte key[CG_NET_PREFIXTABLE_IPV6_ADDRLEN];
+  size_t netIfCnt;
+  int family, familyIdx;
+  int entryIdx;
+  int prefixLen;
+  bool isAutoIp;
+  bool isFallbackAutoIp[2] = { false, false };
+
+  trie = (CGNetworkPrefixTrie*)calloc(1, sizeof(CGNetworkPrefixTrie));
+  if (!trie)
+    return NULL;
+
+  trie->root[0] = trie->root[1] = CG_NET_PREFIXTABLE_NONE;
+  trie->fallback[0] = trie->fallback[1] = CG_NET_PREFIXTABLE_NONE;
+  trie->fingerprint = cg_net_prefix_listfingerprint(netIfList);
+
+  netIfCnt = cg_net_interfacelist_size(netIfList);
+  if (netIfCnt <= 0)
+    return trie;
+
+  /* A path-compressed trie never needs more than two nodes per prefix */
+  trie->entries = (CGNetworkPrefixEntry*)calloc(netIfCnt, sizeof(CGNetworkPrefixEntry));
+  trie->nodes = (CGNetworkPrefixNode*)calloc(netIfCnt * 2, sizeof(CGNetworkPrefixNode));
+  if (!trie->entries || !trie->nodes) {
+    cg_net_prefixtrie_delete(trie);
+    return NULL;
+  }
+
+  for (netIf = cg_net_interfacelist_gets(netIfList); netIf; netIf = cg_net_interface_next(netIf)) {
+    memset(key, 0, sizeof(key));
+    family = cg_net_prefix_parseaddr(cg_net_interface_getaddress(netIf), key);
+    if (family == 0)
+      continue;
+    familyIdx = (family == AF_INET6) ? 1 : 0;
+
+    entryIdx = (int)trie->entryCnt++;
+    entry = &trie->entries[entryIdx];
+    cg_strncpy(entry->addr, cg_net_interface_getaddress(netIf), sizeof(entry->addr) - 1);
+    entry->index = netIf->index;
+#if !defined(WIN32)
+    if ((entry->index <= 0) && (0 < cg_strlen(cg_net_interface_getname(netIf))))
+      entry->index = (int)if_nametoindex(cg_net_interface_getname(netIf));
+#endif
+
+    prefixLen = cg_net_prefix_masklen(cg_net_interface_getnetmask(netIf), family);
+    cg_net_prefixtrie_insert(trie, &trie->root[familyIdx], key, prefixLen, entryIdx);
+
+    /* Prefer the first interface which is not an auto IP address as fallback */
+    isAutoIp = false;
+    if (family == AF_INET)
+      isAutoIp = ((((uint32_t)key[0] << 24) | ((uint32_t)key[1] << 16)) & CG_NET_SOCKET_AUTO_IP_MASK) == CG_NET_SOCKET_AUTO_IP_NET;
+    if ((trie->fallback[familyIdx] == CG_NET_PREFIXTABLE_NONE) || (isFallbackAutoIp[familyIdx] && !isAutoIp)) {
+      trie->fallback[familyIdx] = entryIdx;
+      isFallbackAutoIp[familyIdx] = isAutoIp;
+    }
+  }
+
+  return trie;
+}
+
+/****************************************
+ * cg_net_prefixtrie_lookup
+ ****************************************/
+
+static CGNetworkPrefixEntry* cg_net_prefixtrie_lookup(CGNetworkPrefixTrie* trie, const struct sockaddr* remoteAddr)
+{
+  CGNetworkPrefixNode* node;
+  const byte* key;
+  int familyIdx;
+  int addrBitLen;
+  int nodeIdx;
+  int bestIdx;
+
+  if (!trie || !remoteAddr)
+    return NULL;
+
+  switch (remoteAddr->sa_family) {
+  case AF_INET:
+    key = (const byte*)&((const struct sockaddr_in*)remoteAddr)->sin_addr;
+    familyIdx = 0;
+    addrBitLen = CG_NET_PREFIXTABLE_IPV4_ADDRLEN * 8;
+    break;
+  case AF_INET6:
+    key = (const byte*)&((const struct sockaddr_in6*)remoteAddr)->sin6_addr;
+    familyIdx = 1;
+    addrBitLen = CG_NET_PREFIXTABLE_IPV6_ADDRLEN * 8;
+    break;
+  default:
+    return NULL;
+  }
+
+  bestIdx = trie->fallback[familyIdx];
+  nodeIdx = trie->root[familyIdx];
+  while (nodeIdx != CG_NET_PREFIXTABLE_NONE) {
+    node = &trie->nodes[nodeIdx];
+    if (cg_net_prefix_commonlen(node->prefix, key, node->prefixLen) != node->prefixLen)
+      break;
+    if (node->entry != CG_NET_PREFIXTABLE_NONE)
+      bestIdx = node->entry;
+    if (addrBitLen <= node->prefixLen)
+      break;
+    nodeIdx = node->child[cg_net_prefix_getbit(key, node->prefixLen)];
+  }
+
+  if (bestIdx == CG_NET_PREFIXTABLE_NONE)
+    return NULL;
+
+  return &trie->entries[bestIdx];
+}
+
+/****************************************
+ * cg_net_prefixtable_new
+ ****************************************/
+
+CGNetworkPrefixTable* cg_net_prefixtable_new(void)
+{
+  CGNetworkPrefixTable* table;
+
+  table = (CGNetworkPrefixTable*)malloc(sizeof(CGNetworkPrefixTable));
+  if (!table)
+    return NULL;
+
+  /* Lookups run per received datagram, rebuilds only when the interfaces change */
+  table->rwlock = cg_rwlock_writerpreferred_new();
+  table->trie = NULL;
+
+  if (!table->rwlock) {
+    free(table);
+    return NULL;
+  }
+
+  return table;
+}
+
+/****************************************
+ * cg_net_prefixtable_delete
+ ****************************************/
+
+void cg_net_prefixtable_delete(CGNetworkPrefixTable* table)
+{
+  if (!table)
+    return;
+
+  cg_net_prefixtrie_delete(table->trie);
+  cg_rwlock_delete(table->rwlock);
+  free(table);
+}
+
+/****************************************
+ * cg_net_prefixtable_setinterfaces
+ ****************************************/
+
+bool cg_net_prefixtable_setinterfaces(CGNetworkPrefixTable* table, CGNetworkInterfaceList* netIfList)
+{
+  CGNetworkPrefixTrie *newTrie, *oldTrie;
+
+  if (!table || !netIfList)
+    return false;
+
+  newTrie = cg_net_prefixtrie_new(netIfList);
+  if (!newTrie)
+    return false;
+
+  cg_rwlock_writelock(table->rwlock);
+  oldTrie = table->trie;
+  table->trie = newTrie;
+  cg_rwlock_writeunlock(table->rwlock);
+
+  cg_net_prefixtrie_delete(oldTrie);
+
+  return true;
+}
+
+/****************************************
+ * cg_net_prefixtable_update
+ ****************************************/
+
+bool cg_net_prefixtable_update(CGNetworkPrefixTable* table)
+{
+  CGNetworkInterfaceList* netIfList;
+  uint32_t fingerprint;
+  bool isChanged;
+  bool isSuccess;
+
+  if (!table)
+    return false;
+
+  netIfList = cg_net_interfacelist_new();
+  if (!netIfList)
+    return false;
+
+  cg_net_gethostinterfaces(netIfList);
+
+  fingerprint = cg_net_prefix_listfingerprint(netIfList);
+  cg_rwlock_readlock(table->rwlock);
+  isChanged = (!table->trie || (table->trie->fingerprint != fingerprint)) ? true : false;
+  cg_rwlock_readunlock(table->rwlock);
+
+  isSuccess = true;
+  if (isChanged)
+    isSuccess = cg_net_prefixtable_setinterfaces(table, netIfList);
+
+  cg_net_interfacelist_delete(netIfList);
+
+  return isSuccess;
+}
+
+/****************************************
+ * cg_net_prefixtable_size
+ ****************************************/
+
+size_t cg_net_prefixtable_size(CGNetworkPrefixTable* table)
+{
+  size_t entryCnt;
+
+  if (!table)
+    return 0;
+
+  cg_rwlock_readlock(table->rwlock);
+  entryCnt = table->trie ? table->trie->entryCnt : 0;
+  cg_rwlock_readunlock(table->rwlock);
+
+  return entryCnt;
+}
+
+/****************************************
+ * cg_net_prefixtable_lookup
+ ****************************************/
+
+bool cg_net_prefixtable_lookup(CGNetworkPrefixTable* table, const struct sockaddr* remoteAddr, char* addrBuf, size_t addrBufLen, int* ifIndex)
+{
+  CGNetworkPrefixEntry* entry;
+
+  if (!table || !remoteAddr)
+    return false;
+
+  cg_rwlock_readlock(table->rwlock);
+
+  entry = cg_net_prefixtrie_lookup(table->trie, remoteAddr);
+  if (entry) {
+    if (addrBuf && (0 < addrBufLen)) {
+      cg_strncpy(addrBuf, entry->addr, addrBufLen - 1);
+      addrBuf[addrBufLen - 1] = '\0';
+    }
+    if (ifIndex)
+      *ifIndex = entry->index;
+  }
+
+  cg_rwlock_readunlock(table->rwlock);
+
+  return entry ? true : false;
+}
@@ -16,12 +16,19 @@
  *
  ******************************************************************/
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 
+#include <cgpr/net/_socket.h>
 #include <cgpr/net/interface.h>
 #include <cgpr/net/socket.h>
 #include <cgpr/util/logs.h>
+#include <cgpr/util/mutex.h>
 #include <cgpr/util/time.h>
 
 #if defined(WIN32)
@@ -36,17 +43,36 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
 #include <signal.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
+
+#include <cgpr/util/fiber.h>
 #endif
 
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_FREELIST_MAXSIZE 64
+
 /****************************************
  * static variable
  ****************************************/
 
-static int _gSocketCnt = 0;
+#if defined(WIN32)
+static INIT_ONCE _gSocketInitOnce = INIT_ONCE_STATIC_INIT;
+#else
+static pthread_once_t _gSocketInitOnce = PTHREAD_ONCE_INIT;
+#endif
+
+/* Deleted sockets are kept for reuse; the mutex only guards a pointer push or pop */
+static CGSocket* _gSocketFreeList[CG_NET_SOCKET_FREELIST_MAXSIZE];
+static size_t _gSocketFreeListCnt = 0;
+static CGMutex* _gSocketFreeListMutex = NULL;
 
 /****************************************
  * prototype
@@ -57,6 +83,13 @@ bool cg_socket_tosockaddrinfo(int sockType, const char* addr, int port, struct a
 
 #define cg_socket_getrawtype(socket) (((socket->type & CG_NET_SOCKET_STREAM) == CG_NET_SOCKET_STREAM) ? SOCK_STREAM : SOCK_DGRAM)
 
+#if !defined(WIN32)
+static uint64_t cg_socket_cmsg_gettimestamp(struct cmsghdr* cmsg);
+#endif
+
+static bool cg_socket_freelist_lock(void);
+static void cg_socket_freelist_unlock(void);
+
 /****************************************
  *
  * Socket
@@ -64,29 +97,48 @@ bool cg_socket_tosockaddrinfo(int sockType, const char* addr, int port, struct a
  ****************************************/
 
 /****************************************
- * cg_socket_startup
+ * cg_socket_init
  ****************************************/
 
-void cg_socket_startup(void)
+#if defined(WIN32)
+static BOOL CALLBACK cg_socket_init(PINIT_ONCE initOnce, PVOID param, PVOID* context)
+#else
+static void cg_socket_init(void)
+#endif
 {
-  if (_gSocketCnt == 0) {
 #if defined(WIN32)
-    WSADATA wsaData;
-    int err;
+  WSADATA wsaData;
 
-    err = WSAStartup(MAKEWORD(2, 2), &wsaData);
+  WSAStartup(MAKEWORD(2, 2), &wsaData);
 #endif
 
 #if !defined(WIN32)
-    // Thanks for Brent Hills (10/26/04)
-    signal(SIGPIPE, SIG_IGN);
+  // Thanks for Brent Hills (10/26/04)
+  signal(SIGPIPE, SIG_IGN);
 #endif
 
 #if defined(CG_USE_OPENSSL)
-    SSL_library_init();
+  SSL_library_init();
+#endif
+
+  _gSocketFreeListMutex = cg_mutex_new();
+
+#if defined(WIN32)
+  return TRUE;
+#endif
+}
+
+/****************************************
+ * cg_socket_startup
+ ****************************************/
+
+void cg_socket_startup(void)
+{
+#if defined(WIN32)
+  InitOnceExecuteOnce(&_gSocketInitOnce, cg_socket_init, NULL, NULL);
+#else
+  pthread_once(&_gSocketInitOnce, cg_socket_init);
 #endif
-  }
-  _gSocketCnt++;
 }
 
 /****************************************
@@ -95,17 +147,37 @@ void cg_socket_startup(void)
 
 void cg_socket_cleanup(void)
 {
-  _gSocketCnt--;
-  if (_gSocketCnt <= 0) {
+  if (cg_socket_freelist_lock()) {
+    while (0 < _gSocketFreeListCnt)
+      free(_gSocketFreeList[--_gSocketFreeListCnt]);
+    cg_socket_freelist_unlock();
+  }
+
 #if defined(WIN32)
-    WSACleanup();
+  WSACleanup();
 #endif
+}
 
-#if !defined(WIN32)
-    // Thanks for Brent Hills (10/26/04)
-    signal(SIGPIPE, SIG_DFL);
-#endif
-  }
+/****************************************
+ * cg_socket_freelist_lock
+ ****************************************/
+
+static bool cg_socket_freelist_lock(void)
+{
+  /* Without the mutex sockets are simply not recycled */
+  if (!_gSocketFreeListMutex)
+    return false;
+
+  return cg_mutex_lock(_gSocketFreeListMutex);
+}
+
+/****************************************
+ * cg_socket_freelist_unlock
+ ****************************************/
+
+static void cg_socket_freelist_unlock(void)
+{
+  cg_mutex_unlock(_gSocketFreeListMutex);
 }
 
 /****************************************
@@ -118,9 +190,18 @@ CGSocket* cg_socket_new(int type)
 
   cg_socket_startup();
 
-  sock = (CGSocket*)malloc(sizeof(CGSocket));
-  if (!sock)
-    return NULL;
+  sock = NULL;
+  if (cg_socket_freelist_lock()) {
+    if (0 < _gSocketFreeListCnt)
+      sock = _gSocketFreeList[--_gSocketFreeListCnt];
+    cg_socket_freelist_unlock();
+  }
+
+  if (!sock) {
+    sock = (CGSocket*)malloc(sizeof(CGSocket));
+    if (!sock)
+      return NULL;
+  }
 
 #if defined(WIN32)
   sock->id = INVALID_SOCKET;
@@ -131,16 +212,20 @@ CGSocket* cg_socket_new(int type)
   cg_socket_settype(sock, type);
   cg_socket_setdirection(sock, CG_NET_SOCKET_NONE);
 
-  sock->ipaddr = cg_string_new();
-
-  cg_socket_setaddress(sock, "");
+  sock->ipaddr[0] = '\0';
   cg_socket_setport(sock, -1);
+  sock->timeout = 0;
 
 #if defined(CG_USE_OPENSSL)
   sock->ctx = NULL;
   sock->ssl = NULL;
 #endif
 
+  memset(&sock->stats, 0, sizeof(sock->stats));
+  memset(&sock->pacer, 0, sizeof(sock->pacer));
+  memset(&sock->zerocopy, 0, sizeof(sock->zerocopy));
+  sock->impairment = NULL;
+
   return sock;
 }
 
@@ -154,14 +239,40 @@ bool cg_socket_delete(CGSocket* sock)
     return true;
 
   cg_socket_close(sock);
-  cg_string_delete(sock->ipaddr);
-  free(sock);
 
-  cg_socket_cleanup();
+  if (cg_socket_freelist_lock()) {
+    if (_gSocketFreeListCnt < CG_NET_SOCKET_FREELIST_MAXSIZE) {
+      _gSocketFreeList[_gSocketFreeListCnt++] = sock;
+      sock = NULL;
+    }
+    cg_socket_freelist_unlock();
+  }
+
+  free(sock);
 
   return true;
 }
 
+/****************************************
+ * cg_socket_setaddress
+ ****************************************/
+
+void cg_socket_setaddress(CGSocket* sock, const char* addr)
+{
+  size_t addrLen;
+
+  if (!sock)
+    return;
+
+  addrLen = addr ? strlen(addr) : 0;
+  if (sizeof(sock->ipaddr) <= addrLen)
+    addrLen = sizeof(sock->ipaddr) - 1;
+
+  if (0 < addrLen)
+    memmove(sock->ipaddr, addr, addrLen);
+  sock->ipaddr[addrLen] = '\0';
+}
+
 /****************************************
  * cg_socket_isbound
  ****************************************/
@@ -206,7 +317,7 @@ void cg_socket_setid(CGSocket* sock, SOCKET value)
   sock->id = value;
 
 #if defined(WIN32) || defined(HAVE_IP_PKTINFO)
-  if (CG_NET_SOCKET_DGRAM == cg_socket_gettype(socket))
+  if (CG_NET_SOCKET_DGRAM == cg_socket_gettype(sock))
     setsockopt(sock->id, IPPROTO_IP, IP_PKTINFO, &on, sizeof(on));
 #endif
 
@@ -259,6 +370,7 @@ bool cg_socket_close(CGSocket* sock)
 
   cg_socket_setaddress(sock, "");
   cg_socket_setport(sock, -1);
+  sock->timeout = 0;
 
   return true;
 }
@@ -327,40 +439,326 @@ bool cg_socket_bind(CGSocket* sock, int bindPort, const char* bindAddr, CGSocket
 }
 
 /****************************************
- * cg_socket_accept
+ * cg_socket_pair
  ****************************************/
 
-bool cg_socket_accept(CGSocket* serverSock, CGSocket* clientSock)
+bool cg_socket_pair(CGSocket* sock, CGSocket* peerSock)
 {
-  struct sockaddr_in sockaddr;
-  socklen_t socklen;
-  char localAddr[CG_NET_SOCKET_MAXHOST];
-  char localPort[CG_NET_SOCKET_MAXSERV];
-  struct sockaddr_storage sockClientAddr;
-  socklen_t nLength = sizeof(sockClientAddr);
-
-  cg_socket_setid(clientSock, accept(serverSock->id, (struct sockaddr*)&sockClientAddr, &nLength));
-
 #if defined(WIN32)
-  if (clientSock->id == INVALID_SOCKET)
-    return false;
+  return false;
 #else
-  if (clientSock->id < 0)
+  CGSocket* socks[2];
+  SOCKET sockIds[2];
+  struct sockaddr_in sockAddrs[2];
+  socklen_t sockAddrLen;
+  bool isPaired;
+  int n;
+
+  if (!sock || !peerSock || (sock == peerSock) || cg_socket_isbound(sock) || cg_socket_isbound(peerSock))
     return false;
+
+  if (cg_socket_gettype(sock) != cg_socket_gettype(peerSock))
+    return false;
+
+  socks[0] = sock;
+  socks[1] = peerSock;
+
+  /* Stream pairs are local sockets, datagram pairs are connected loopback UDP sockets so that sendto() and recv() keep working */
+  if (cg_socket_issocketstream(sock)) {
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockIds) != 0)
+      return false;
+    for (n = 0; n < 2; n++) {
+      cg_socket_setid(socks[n], sockIds[n]);
+      cg_socket_setaddress(socks[n], "");
+      cg_socket_setport(socks[n], 0);
+    }
+  }
+  else {
+    isPaired = true;
+    for (n = 0; n < 2; n++) {
+      memset(&sockAddrs[n], 0, sizeof(sockAddrs[n]));
+      sockAddrs[n].sin_family = AF_INET;
+      sockAddrs[n].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      sockAddrLen = sizeof(sockAddrs[n]);
+      cg_socket_setid(socks[n], socket(AF_INET, SOCK_DGRAM, 0));
+      if (!cg_socket_isbound(socks[n]) || (bind(socks[n]->id, (struct sockaddr*)&sockAddrs[n], sizeof(sockAddrs[n])) != 0) || (getsockname(socks[n]->id, (struct sockaddr*)&sockAddrs[n], &sockAddrLen) != 0)) {
+        isPaired = false;
+        break;
+      }
+    }
+    for (n = 0; isPaired && (n < 2); n++) {
+      if (connect(socks[n]->id, (struct sockaddr*)&sockAddrs[1 - n], sizeof(sockAddrs[1 - n])) != 0)
+        isPaired = false;
+      cg_socket_setaddress(socks[n], "127.0.0.1");
+      cg_socket_setport(socks[n], ntohs(sockAddrs[n].sin_port));
+    }
+    if (!isPaired) {
+      cg_socket_close(sock);
+      cg_socket_close(peerSock);
+      return false;
+    }
+  }
+
+  cg_socket_setdirection(sock, CG_NET_SOCKET_CLIENT);
+  cg_socket_setdirection(peerSock, CG_NET_SOCKET_CLIENT);
+
+  return true;
 #endif
+}
+
+/****************************************
+ * cg_socket_setacceptedid
+ ****************************************/
 
+static void cg_socket_setacceptedid(CGSocket* serverSock, CGSocket* clientSock, SOCKET sockId)
+{
+  struct sockaddr_storage sockaddr;
+  socklen_t socklen;
+  char localAddr[CG_NET_SOCKET_MAXHOST];
+  char localPort[CG_NET_SOCKET_MAXSERV];
+
+  cg_socket_setid(clientSock, sockId);
   cg_socket_setaddress(clientSock, cg_socket_getaddress(serverSock));
   cg_socket_setport(clientSock, cg_socket_getport(serverSock));
-  socklen = sizeof(struct sockaddr_in);
+  socklen = sizeof(sockaddr);
 
   if (getsockname(clientSock->id, (struct sockaddr*)&sockaddr, &socklen) == 0 && getnameinfo((struct sockaddr*)&sockaddr, socklen, localAddr, sizeof(localAddr), localPort, sizeof(localPort), NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
     /* Set address for the sockaddr to real addr */
     cg_socket_setaddress(clientSock, localAddr);
   }
+}
+
+/****************************************
+ * cg_socket_fiberflags
+ ****************************************/
+
+#if defined(WIN32)
+#define cg_socket_fiberflags() 0
+#define cg_socket_fiberwait(sock, events) false
+#define cg_socket_fiberbegin(sock) -1
+#define cg_socket_fiberend(sock, flags)
+#define cg_socket_fibersslwait(sock, ret) false
+#else
+static int cg_socket_fiberflags(void)
+{
+  /* Inside a fiber a call must not block the thread, it waits in the scheduler instead */
+  return cg_fiber_isactive() ? MSG_DONTWAIT : 0;
+}
+
+/****************************************
+ * cg_socket_fiberwaitfd
+ ****************************************/
+
+static bool cg_socket_fiberwaitfd(CGSocket* sock, int events)
+{
+  clock_t mtime;
+  int readyEvents;
+
+  /* SO_RCVTIMEO and SO_SNDTIMEO do not apply to non-blocking calls, so the fiber wait enforces them */
+  mtime = (0 < sock->timeout) ? (clock_t)sock->timeout * 1000 : CG_FIBER_WAIT_INFINITE;
+  readyEvents = cg_fiber_waitfd(sock->id, events, mtime);
+  if (0 < readyEvents)
+    return true;
+
+  if (readyEvents == 0)
+    errno = EAGAIN;
+  return false;
+}
+
+/****************************************
+ * cg_socket_fiberwait
+ ****************************************/
+
+static bool cg_socket_fiberwait(CGSocket* sock, int events)
+{
+  if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+    return false;
+
+  return cg_socket_fiberwaitfd(sock, events);
+}
+
+/****************************************
+ * cg_socket_fiberbegin
+ ****************************************/
+
+static int cg_socket_fiberbegin(CGSocket* sock)
+{
+  int flags;
+
+  /* Calls without a flags argument (accept, connect and the OpenSSL BIO) need the descriptor itself non-blocking */
+  if (!cg_fiber_isactive())
+    return -1;
+
+  flags = fcntl(sock->id, F_GETFL, 0);
+  if ((0 <= flags) && !(flags & O_NONBLOCK))
+    fcntl(sock->id, F_SETFL, flags | O_NONBLOCK);
+
+  return flags;
+}
+
+/****************************************
+ * cg_socket_fiberend
+ ****************************************/
+
+static void cg_socket_fiberend(CGSocket* sock, int flags)
+{
+  if ((0 <= flags) && !(flags & O_NONBLOCK))
+    fcntl(sock->id, F_SETFL, flags);
+}
+
+/****************************************
+ * cg_socket_fibersslwait
+ ****************************************/
+
+#if defined(CG_USE_OPENSSL)
+static bool cg_socket_fibersslwait(CGSocket* sock, int ret)
+{
+  if (!cg_fiber_isactive())
+    return false;
+
+  switch (SSL_get_error(sock->ssl, ret)) {
+  case SSL_ERROR_WANT_READ:
+    return cg_socket_fiberwaitfd(sock, POLLIN);
+  case SSL_ERROR_WANT_WRITE:
+    return cg_socket_fiberwaitfd(sock, POLLOUT);
+  }
+
+  return false;
+}
+#endif
+
+/****************************************
+ * cg_socket_fiberaccept
+ ****************************************/
+
+static SOCKET cg_socket_fiberaccept(CGSocket* serverSock, struct sockaddr* sockAddr, socklen_t* sockAddrLen)
+{
+  socklen_t addrLen;
+  SOCKET sockId;
+  int flags;
+
+  flags = cg_socket_fiberbegin(serverSock);
+
+  addrLen = *sockAddrLen;
+  do {
+    *sockAddrLen = addrLen;
+    sockId = accept(serverSock->id, sockAddr, sockAddrLen);
+  } while ((sockId < 0) && cg_socket_fiberwait(serverSock, POLLIN));
+
+  cg_socket_fiberend(serverSock, flags);
+
+  return sockId;
+}
+
+/****************************************
+ * cg_socket_fiberconnect
+ ****************************************/
+
+static int cg_socket_fiberconnect(CGSocket* sock, const struct sockaddr* sockAddr, socklen_t sockAddrLen)
+{
+  socklen_t optLen;
+  int sockErr;
+  int flags;
+  int ret;
+
+  flags = cg_socket_fiberbegin(sock);
+
+  ret = connect(sock->id, sockAddr, sockAddrLen);
+  if ((ret != 0) && (errno == EINPROGRESS)) {
+    if (!cg_socket_fiberwaitfd(sock, POLLOUT)) {
+      cg_socket_fiberend(sock, flags);
+      errno = ETIMEDOUT;
+      return -1;
+    }
+    sockErr = 0;
+    optLen = sizeof(sockErr);
+    if ((getsockopt(sock->id, SOL_SOCKET, SO_ERROR, &sockErr, &optLen) == 0) && (sockErr == 0))
+      ret = 0;
+    else
+      errno = sockErr;
+  }
+
+  cg_socket_fiberend(sock, flags);
+
+  return ret;
+}
+#endif
+
+/****************************************
+ * cg_socket_accept
+ ****************************************/
+
+bool cg_socket_accept(CGSocket* serverSock, CGSocket* clientSock)
+{
+  struct sockaddr_storage sockClientAddr;
+  socklen_t nLength = sizeof(sockClientAddr);
+  SOCKET sockId;
+
+#if !defined(WIN32)
+  if (cg_fiber_isactive())
+    sockId = cg_socket_fiberaccept(serverSock, (struct sockaddr*)&sockClientAddr, &nLength);
+  else
+#endif
+    sockId = accept(serverSock->id, (struct sockaddr*)&sockClientAddr, &nLength);
+
+  cg_socket_stats_inc(serverSock, acceptCnt);
+#if defined(WIN32)
+  if (sockId == INVALID_SOCKET) {
+#else
+  if (sockId < 0) {
+#endif
+    cg_socket_setid(clientSock, sockId);
+    cg_socket_stats_inc(serverSock, acceptErrors);
+    return false;
+  }
+
+  cg_socket_setacceptedid(serverSock, clientSock, sockId);
 
   return true;
 }
 
+/****************************************
+ * cg_socket_acceptbatch
+ ****************************************/
+
+size_t cg_socket_acceptbatch(CGSocket* serverSock, CGSocket** clientSocks, size_t clientSockCnt)
+{
+  struct sockaddr_storage sockClientAddr;
+  socklen_t nLength;
+  SOCKET sockId;
+  size_t acceptedCnt;
+
+  if (!serverSock || !clientSocks)
+    return 0;
+
+  /* The listener is expected to be non-blocking, so the loop stops once the backlog is empty */
+  for (acceptedCnt = 0; acceptedCnt < clientSockCnt; acceptedCnt++) {
+    nLength = sizeof(sockClientAddr);
+#if defined(__linux__)
+    sockId = accept4(serverSock->id, (struct sockaddr*)&sockClientAddr, &nLength, SOCK_CLOEXEC);
+#else
+    sockId = accept(serverSock->id, (struct sockaddr*)&sockClientAddr, &nLength);
+#endif
+#if defined(WIN32)
+    if (sockId == INVALID_SOCKET) {
+      if (WSAGetLastError() != WSAEWOULDBLOCK)
+#else
+    if (sockId < 0) {
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+#endif
+      {
+        cg_socket_stats_inc(serverSock, acceptCnt);
+        cg_socket_stats_inc(serverSock, acceptErrors);
+      }
+      break;
+    }
+    cg_socket_stats_inc(serverSock, acceptCnt);
+    cg_socket_setacceptedid(serverSock, clientSocks[acceptedCnt], sockId);
+  }
+
+  return acceptedCnt;
+}
+
 /****************************************
  * cg_socket_connect
  ****************************************/
@@ -369,6 +767,10 @@ bool cg_socket_connect(CGSocket* sock, const char* addr, int port)
 {
   struct addrinfo* toaddrInfo;
   int ret;
+#if defined(CG_USE_OPENSSL)
+  int sslRet;
+  int flags;
+#endif
 
   if (!sock)
     return false;
@@ -378,11 +780,22 @@ bool cg_socket_connect(CGSocket* sock, const char* addr, int port)
 
   if (cg_socket_isbound(sock) == false) {
     cg_socket_setid(sock, socket(toaddrInfo->ai_family, toaddrInfo->ai_socktype, 0));
+    if (cg_socket_iszerocopy(sock))
+      cg_socket_zerocopy_apply(sock);
   }
 
-  ret = connect(sock->id, toaddrInfo->ai_addr, toaddrInfo->ai_addrlen);
+#if !defined(WIN32)
+  if (cg_fiber_isactive())
+    ret = cg_socket_fiberconnect(sock, toaddrInfo->ai_addr, toaddrInfo->ai_addrlen);
+  else
+#endif
+    ret = connect(sock->id, toaddrInfo->ai_addr, toaddrInfo->ai_addrlen);
   freeaddrinfo(toaddrInfo);
 
+  cg_socket_stats_inc(sock, connectCnt);
+  if (ret != 0)
+    cg_socket_stats_inc(sock, connectErrors);
+
   cg_socket_setdirection(sock, CG_NET_SOCKET_CLIENT);
 
 #if defined(CG_USE_OPENSSL)
@@ -393,7 +806,12 @@ bool cg_socket_connect(CGSocket* sock, const char* addr, int port)
       cg_socket_close(sock);
       return false;
     }
-    if (SSL_connect(sock->ssl) < 1) {
+    flags = cg_socket_fiberbegin(sock);
+    do {
+      sslRet = SSL_connect(sock->ssl);
+    } while ((sslRet < 1) && cg_socket_fibersslwait(sock, sslRet));
+    cg_socket_fiberend(sock, flags);
+    if (sslRet < 1) {
       cg_socket_close(sock);
       return false;
     }
@@ -410,6 +828,9 @@ bool cg_socket_connect(CGSocket* sock, const char* addr, int port)
 ssize_t cg_socket_read(CGSocket* sock, char* buffer, size_t bufferLen)
 {
   ssize_t recvLen;
+#if defined(CG_USE_OPENSSL)
+  int flags;
+#endif
 
   if (!sock)
     return -1;
@@ -418,24 +839,213 @@ ssize_t cg_socket_read(CGSocket* sock, char* buffer, size_t bufferLen)
   if (cg_socket_isssl(sock) == false) {
 #endif
 
-    recvLen = recv(sock->id, buffer, bufferLen, 0);
+    do {
+      recvLen = recv(sock->id, buffer, bufferLen, cg_socket_fiberflags());
+    } while ((recvLen < 0) && cg_socket_fiberwait(sock, POLLIN));
 
 #if defined(CG_USE_OPENSSL)
   }
   else {
-    recvLen = SSL_read(sock->ssl, buffer, bufferLen);
+    flags = cg_socket_fiberbegin(sock);
+    do {
+      recvLen = SSL_read(sock->ssl, buffer, bufferLen);
+    } while ((recvLen <= 0) && cg_socket_fibersslwait(sock, (int)recvLen));
+    cg_socket_fiberend(sock, flags);
   }
 #endif
 
+  cg_socket_stats_inc(sock, readCnt);
+  if (0 < recvLen)
+    cg_socket_stats_add(sock, readBytes, recvLen);
+  else if (recvLen < 0)
+    cg_socket_stats_inc(sock, readErrors);
+
   return recvLen;
 }
 
 /****************************************
- * cg_socket_write
+ * cg_socket_readtimestamp
  ****************************************/
 
-#define CG_NET_SOCKET_SEND_RETRY_CNT 10
-#define CG_NET_SOCKET_SEND_RETRY_WAIT_MSEC 20
+ssize_t cg_socket_readtimestamp(CGSocket* sock, char* buffer, size_t bufferLen, uint64_t* timestamp)
+{
+#if !defined(WIN32)
+  struct msghdr msg;
+  struct iovec iov;
+  struct cmsghdr* cmsg;
+  union {
+    struct cmsghdr align;
+    byte buf[CG_NET_SOCKET_DGRAM_ANCILLARY_BUFSIZE];
+  } ctrlBuf;
+#endif
+  ssize_t recvLen;
+
+  if (!sock)
+    return -1;
+
+  if (timestamp)
+    *timestamp = 0;
+
+#if defined(CG_USE_OPENSSL)
+  if (cg_socket_isssl(sock) == true)
+    return cg_socket_read(sock, buffer, bufferLen);
+#endif
+
+#if defined(WIN32)
+  recvLen = cg_socket_read(sock, buffer, bufferLen);
+#else
+  iov.iov_base = buffer;
+  iov.iov_len = bufferLen;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctrlBuf.buf;
+  msg.msg_controllen = sizeof(ctrlBuf.buf);
+
+  do {
+    recvLen = recvmsg(sock->id, &msg, cg_socket_fiberflags());
+  } while ((recvLen < 0) && cg_socket_fiberwait(sock, POLLIN));
+
+  cg_socket_stats_inc(sock, readCnt);
+  if (0 < recvLen)
+    cg_socket_stats_add(sock, readBytes, recvLen);
+  else if (recvLen < 0)
+    cg_socket_stats_inc(sock, readErrors);
+
+  if ((0 < recvLen) && timestamp) {
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if ((cmsg->cmsg_level == SOL_SOCKET) && (cg_socket_cmsg_gettimestamp(cmsg) != 0))
+        *timestamp = cg_socket_cmsg_gettimestamp(cmsg);
+    }
+  }
+#endif
+
+  return recvLen;
+}
+
+/****************************************
+ * cg_socket_readring
+ ****************************************/
+
+ssize_t cg_socket_readring(CGSocket* sock, CGRingBuffer* ring)
+{
+  ssize_t recvLen;
+#if !defined(WIN32)
+  struct iovec iov[2];
+  struct msghdr msg;
+#endif
+#if defined(WIN32) || defined(CG_USE_OPENSSL)
+  size_t regionLen;
+  byte* region;
+#endif
+
+  if (!sock || !ring)
+    return -1;
+
+  if (cg_ring_buffer_isfull(ring))
+    return 0;
+
+#if defined(CG_USE_OPENSSL)
+  if (cg_socket_isssl(sock) == true) {
+    region = cg_ring_buffer_getwriteregion(ring, &regionLen);
+    recvLen = cg_socket_read(sock, (char*)region, regionLen);
+    if (0 < recvLen)
+      cg_ring_buffer_commit(ring, recvLen);
+    return recvLen;
+  }
+#endif
+
+#if defined(WIN32)
+  region = cg_ring_buffer_getwriteregion(ring, &regionLen);
+  recvLen = recv(sock->id, (char*)region, (int)regionLen, 0);
+#else
+  /* One recvmsg() fills both sides of the wrap, and unlike readv() it takes the non-blocking flag of fibers */
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = cg_ring_buffer_getwritevec(ring, iov);
+  do {
+    recvLen = recvmsg(sock->id, &msg, cg_socket_fiberflags());
+  } while ((recvLen < 0) && cg_socket_fiberwait(sock, POLLIN));
+#endif
+
+  cg_socket_stats_inc(sock, readCnt);
+  if (0 < recvLen) {
+    cg_socket_stats_add(sock, readBytes, recvLen);
+    cg_ring_buffer_commit(ring, (size_t)recvLen);
+  }
+  else if (recvLen < 0) {
+    cg_socket_stats_inc(sock, readErrors);
+  }
+
+  return recvLen;
+}
+
+/****************************************
+ * cg_socket_writering
+ ****************************************/
+
+ssize_t cg_socket_writering(CGSocket* sock, CGRingBuffer* ring)
+{
+  ssize_t sentLen;
+#if !defined(WIN32)
+  struct iovec iov[2];
+  struct msghdr msg;
+#endif
+#if defined(WIN32) || defined(CG_USE_OPENSSL)
+  size_t regionLen;
+  byte* region;
+#endif
+#if defined(CG_USE_OPENSSL)
+  int flags;
+#endif
+
+  if (!sock || !ring)
+    return -1;
+
+  if (cg_ring_buffer_isempty(ring))
+    return 0;
+
+#if defined(CG_USE_OPENSSL)
+  if (cg_socket_isssl(sock) == true) {
+    region = cg_ring_buffer_getreadregion(ring, &regionLen);
+    flags = cg_socket_fiberbegin(sock);
+    do {
+      sentLen = SSL_write(sock->ssl, region, regionLen);
+    } while ((sentLen <= 0) && cg_socket_fibersslwait(sock, (int)sentLen));
+    cg_socket_fiberend(sock, flags);
+    if (0 < sentLen)
+      cg_ring_buffer_consume(ring, sentLen);
+    return sentLen;
+  }
+#endif
+
+#if defined(WIN32)
+  region = cg_ring_buffer_getreadregion(ring, &regionLen);
+  sentLen = send(sock->id, (const char*)region, (int)regionLen, 0);
+#else
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = cg_ring_buffer_getreadvec(ring, iov);
+  do {
+    sentLen = sendmsg(sock->id, &msg, cg_socket_fiberflags());
+  } while ((sentLen < 0) && cg_socket_fiberwait(sock, POLLOUT));
+#endif
+
+  cg_socket_stats_inc(sock, writeCnt);
+  if (0 < sentLen) {
+    cg_socket_stats_add(sock, writeBytes, sentLen);
+    cg_ring_buffer_consume(ring, (size_t)sentLen);
+  }
+  else if (sentLen < 0) {
+    cg_socket_stats_inc(sock, writeErrors);
+  }
+
+  return sentLen;
+}
+
+/****************************************
+ * cg_socket_write
+ ****************************************/
 
 size_t cg_socket_write(CGSocket* sock, const char* cmd, size_t cmdLen)
 {
@@ -443,6 +1053,9 @@ size_t cg_socket_write(CGSocket* sock, const char* cmd, size_t cmdLen)
   size_t nTotalSent = 0;
   size_t cmdPos = 0;
   int retryCnt = 0;
+#if defined(CG_USE_OPENSSL)
+  int flags;
+#endif
 
   if (!sock)
     return 0;
@@ -455,25 +1068,42 @@ size_t cg_socket_write(CGSocket* sock, const char* cmd, size_t cmdLen)
     if (cg_socket_isssl(sock) == false) {
 #endif
 
-      nSent = send(sock->id, cmd + cmdPos, cmdLen, 0);
+      if (sock->impairment)
+        nSent = cg_socket_impairment_enqueue(sock->impairment, sock, cmd + cmdPos, cmdLen, NULL, 0);
+      else {
+        nSent = send(sock->id, cmd + cmdPos, cmdLen, cg_socket_fiberflags());
+        if ((nSent < 0) && cg_socket_fiberwait(sock, POLLOUT))
+          continue;
+      }
 
 #if defined(CG_USE_OPENSSL)
     }
     else {
-      nSent = SSL_write(sock->ssl, cmd + cmdPos, cmdLen);
+      flags = cg_socket_fiberbegin(sock);
+      do {
+        nSent = SSL_write(sock->ssl, cmd + cmdPos, cmdLen);
+      } while ((nSent <= 0) && cg_socket_fibersslwait(sock, (int)nSent));
+      cg_socket_fiberend(sock, flags);
     }
 #endif
 
+    cg_socket_stats_inc(sock, writeCnt);
+
     if (nSent <= 0) {
       retryCnt++;
       if (CG_NET_SOCKET_SEND_RETRY_CNT < retryCnt) {
+        cg_socket_stats_inc(sock, writeErrors);
         nTotalSent = 0;
         break;
       }
 
+      cg_socket_stats_inc(sock, writeRetryCnt);
       cg_wait(CG_NET_SOCKET_SEND_RETRY_WAIT_MSEC);
     }
     else {
+      cg_socket_stats_add(sock, writeBytes, nSent);
+      if ((size_t)nSent < cmdLen)
+        cg_socket_stats_inc(sock, writeShortCnt);
       nTotalSent += nSent;
       cmdPos += nSent;
       cmdLen -= nSent;
@@ -484,6 +1114,111 @@ size_t cg_socket_write(CGSocket* sock, const char* cmd, size_t cmdLen)
 
   return nTotalSent;
 }
+
+/****************************************
+ * cg_socket_writev
+ ****************************************/
+
+size_t cg_socket_writev(CGSocket* sock, const byte** bufs, const size_t* bufLens, size_t bufCnt)
+{
+#if !defined(WIN32)
+  struct iovec iov[CG_NET_SOCKET_WRITEV_MAX];
+  struct msghdr msg;
+  size_t iovCnt;
+  size_t nLeft;
+  ssize_t nSent;
+  int retryCnt;
+#endif
+  size_t nTotalSent;
+  bool isGathered;
+  size_t n;
+
+  if (!sock || !bufs || !bufLens)
+    return 0;
+
+#if defined(WIN32)
+  isGathered = false;
+#else
+  isGathered = ((bufCnt <= CG_NET_SOCKET_WRITEV_MAX) && !sock->impairment) ? true : false;
+#endif
+#if defined(CG_USE_OPENSSL)
+  if (cg_socket_isssl(sock) == true)
+    isGathered = false;
+#endif
+
+  /* SSL records and impaired sends are written one buffer at a time */
+  if (!isGathered) {
+    nTotalSent = 0;
+    for (n = 0; n < bufCnt; n++) {
+      if (bufLens[n] <= 0)
+        continue;
+      if (cg_socket_write(sock, (const char*)bufs[n], bufLens[n]) != bufLens[n])
+        return 0;
+      nTotalSent += bufLens[n];
+    }
+    return nTotalSent;
+  }
+
+#if !defined(WIN32)
+  iovCnt = 0;
+  nLeft = 0;
+  for (n = 0; n < bufCnt; n++) {
+    if (bufLens[n] <= 0)
+      continue;
+    iov[iovCnt].iov_base = (void*)bufs[n];
+    iov[iovCnt].iov_len = bufLens[n];
+    nLeft += bufLens[n];
+    iovCnt++;
+  }
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = iovCnt;
+
+  nTotalSent = 0;
+  retryCnt = 0;
+  while (0 < nLeft) {
+    nSent = sendmsg(sock->id, &msg, cg_socket_fiberflags());
+    if ((nSent < 0) && cg_socket_fiberwait(sock, POLLOUT))
+      continue;
+
+    cg_socket_stats_inc(sock, writeCnt);
+
+    if (nSent <= 0) {
+      retryCnt++;
+      if (CG_NET_SOCKET_SEND_RETRY_CNT < retryCnt) {
+        cg_socket_stats_inc(sock, writeErrors);
+        return 0;
+      }
+      cg_socket_stats_inc(sock, writeRetryCnt);
+      cg_wait(CG_NET_SOCKET_SEND_RETRY_WAIT_MSEC);
+      continue;
+    }
+
+    cg_socket_stats_add(sock, writeBytes, nSent);
+    if ((size_t)nSent < nLeft)
+      cg_socket_stats_inc(sock, writeShortCnt);
+    nTotalSent += nSent;
+    nLeft -= nSent;
+    retryCnt = 0;
+
+    /* A short write resumes from the first byte the kernel did not take */
+    while ((0 < msg.msg_iovlen) && (msg.msg_iov->iov_len <= (size_t)nSent)) {
+      nSent -= msg.msg_iov->iov_len;
+      msg.msg_iov++;
+      msg.msg_iovlen--;
+    }
+    if (0 < nSent) {
+      msg.msg_iov->iov_base = (byte*)msg.msg_iov->iov_base + nSent;
+      msg.msg_iov->iov_len -= nSent;
+    }
+  }
+
+  return nTotalSent;
+#else
+  return 0;
+#endif
+}
 /****************************************
  * cg_socket_readline
  ****************************************/
@@ -563,14 +1298,31 @@ size_t cg_socket_sendto(CGSocket* sock, const char* addr, int port, const byte*
 
   if (cg_socket_tosockaddrinfo(cg_socket_getrawtype(sock), addr, port, &addrInfo, true) == false)
     return -1;
-  if (isBoundFlag == false)
+  if (isBoundFlag == false) {
     cg_socket_setid(sock, socket(addrInfo->ai_family, addrInfo->ai_socktype, 0));
+    if (cg_socket_ispaced(sock))
+      cg_socket_pacer_apply(sock);
+  }
 
   /* Setting multicast time to live in any case to default */
   cg_socket_setmulticastttl(sock, CG_NET_SOCKET_MULTICAST_DEFAULT_TTL);
 
-  if (0 <= sock->id)
-    sentLen = sendto(sock->id, data, dataLen, 0, addrInfo->ai_addr, addrInfo->ai_addrlen);
+  if (cg_socket_ispaced(sock))
+    cg_socket_pacer_wait(sock, dataLen);
+
+  if ((0 <= sock->id) && sock->impairment)
+    sentLen = cg_socket_impairment_enqueue(sock->impairment, sock, data, dataLen, addrInfo->ai_addr, addrInfo->ai_addrlen);
+  else if (0 <= sock->id) {
+    do {
+      sentLen = sendto(sock->id, data, dataLen, cg_socket_fiberflags(), addrInfo->ai_addr, addrInfo->ai_addrlen);
+    } while ((sentLen < 0) && cg_socket_fiberwait(sock, POLLOUT));
+  }
+
+  cg_socket_stats_inc(sock, sendtoCnt);
+  if (0 <= sentLen)
+    cg_socket_stats_add(sock, sendtoBytes, sentLen);
+  else
+    cg_socket_stats_inc(sock, sendtoErrors);
 
   cg_net_socket_debug(CG_LOG_NET_PREFIX_SEND, cg_socket_getaddress(sock), addr, data, dataLen);
 
@@ -592,37 +1344,119 @@ ssize_t cg_socket_recv(CGSocket* sock, CGDatagramPacket* dgmPkt)
   byte recvBuf[CG_NET_SOCKET_DGRAM_RECV_BUFSIZE + 1];
   char remoteAddr[CG_NET_SOCKET_MAXHOST];
   char remotePort[CG_NET_SOCKET_MAXSERV];
-  char* localAddr;
+  char destAddr[CG_NET_ADDRSTRING_MAXSIZE];
+  char pktInfoAddr[CG_NET_ADDRSTRING_MAXSIZE];
+  char localAddr[CG_NET_ADDRSTRING_MAXSIZE];
   struct sockaddr_storage from;
   socklen_t fromLen;
+  int ifIndex;
+  uint64_t timestamp;
+#if !defined(WIN32)
+  struct msghdr msg;
+  struct iovec iov;
+  struct cmsghdr* cmsg;
+  union {
+    struct cmsghdr align;
+    byte buf[CG_NET_SOCKET_DGRAM_ANCILLARY_BUFSIZE];
+  } ctrlBuf;
+#endif
 
   if (!sock)
     return -1;
 
   fromLen = sizeof(from);
+  ifIndex = 0;
+  timestamp = 0;
+  destAddr[0] = '\0';
+  pktInfoAddr[0] = '\0';
+
+#if defined(WIN32)
   recvLen = recvfrom(sock->id, recvBuf, sizeof(recvBuf) - 1, 0, (struct sockaddr*)&from, &fromLen);
+#else
+  iov.iov_base = recvBuf;
+  iov.iov_len = sizeof(recvBuf) - 1;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_name = &from;
+  msg.msg_namelen = fromLen;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctrlBuf.buf;
+  msg.msg_controllen = sizeof(ctrlBuf.buf);
+
+  do {
+    recvLen = recvmsg(sock->id, &msg, cg_socket_fiberflags());
+  } while ((recvLen < 0) && cg_socket_fiberwait(sock, POLLIN));
+  fromLen = msg.msg_namelen;
+#endif
+
+  cg_socket_stats_inc(sock, recvCnt);
+  if (recvLen < 0)
+    cg_socket_stats_inc(sock, recvErrors);
 
   if (recvLen <= 0)
     return recvLen;
 
+  cg_socket_stats_add(sock, recvBytes, recvLen);
+#if !defined(WIN32)
+  if (msg.msg_flags & MSG_TRUNC)
+    cg_socket_stats_inc(sock, recvTruncatedCnt);
+#endif
+
+#if !defined(WIN32)
+  /* Ingress interface, destination address and kernel receive time (see cg_socket_setpktinfo() and cg_socket_settimestamp()) */
+  for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET) {
+      if (cg_socket_cmsg_gettimestamp(cmsg) != 0)
+        timestamp = cg_socket_cmsg_gettimestamp(cmsg);
+      continue;
+    }
+#if defined(IP_PKTINFO)
+    if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO)) {
+      struct in_pktinfo pktInfo;
+      memcpy(&pktInfo, CMSG_DATA(cmsg), sizeof(pktInfo));
+      ifIndex = (int)pktInfo.ipi_ifindex;
+      inet_ntop(AF_INET, &pktInfo.ipi_addr, destAddr, sizeof(destAddr));
+      inet_ntop(AF_INET, &pktInfo.ipi_spec_dst, pktInfoAddr, sizeof(pktInfoAddr));
+    }
+#endif
+#if defined(IPV6_PKTINFO)
+    if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO)) {
+      struct in6_pktinfo pktInfo6;
+      memcpy(&pktInfo6, CMSG_DATA(cmsg), sizeof(pktInfo6));
+      ifIndex = (int)pktInfo6.ipi6_ifindex;
+      inet_ntop(AF_INET6, &pktInfo6.ipi6_addr, destAddr, sizeof(destAddr));
+    }
+#endif
+  }
+#endif
+
   cg_socket_datagram_packet_setdata(dgmPkt, recvBuf, recvLen);
 
   cg_socket_datagram_packet_setlocalport(dgmPkt, cg_socket_getport(sock));
   cg_socket_datagram_packet_setremoteAddr(dgmPkt, "");
   cg_socket_datagram_packet_setremoteport(dgmPkt, 0);
+  cg_socket_datagram_packet_setdestAddr(dgmPkt, destAddr);
+  cg_socket_datagram_packet_setifindex(dgmPkt, ifIndex);
+  cg_socket_datagram_packet_settimestamp(dgmPkt, timestamp);
 
   if (getnameinfo((struct sockaddr*)&from, fromLen, remoteAddr, sizeof(remoteAddr), remotePort, sizeof(remotePort), NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
     cg_socket_datagram_packet_setremoteAddr(dgmPkt, remoteAddr);
     cg_socket_datagram_packet_setremoteport(dgmPkt, cg_str2int(remotePort));
   }
 
-  localAddr = cg_net_selectaddr((struct sockaddr*)&from);
+  /* The kernel already knows the local interface address for IPv4 packets */
+  if (0 < cg_strlen(pktInfoAddr)) {
+    cg_socket_datagram_packet_setlocalAddr(dgmPkt, pktInfoAddr);
+    cg_net_socket_debug(CG_LOG_NET_PREFIX_RECV, remoteAddr, pktInfoAddr, recvBuf, recvLen);
+    return recvLen;
+  }
+
+  if (!cg_net_selectaddrto((struct sockaddr*)&from, localAddr, sizeof(localAddr)))
+    localAddr[0] = '\0';
   cg_socket_datagram_packet_setlocalAddr(dgmPkt, localAddr);
 
   cg_net_socket_debug(CG_LOG_NET_PREFIX_RECV, remoteAddr, localAddr, recvBuf, recvLen);
 
-  free(localAddr);
-
   return recvLen;
 }
 
@@ -744,6 +1578,107 @@ bool cg_socket_settimeout(CGSocket* sock, int sec)
     sockOptRet = setsockopt(sock->id, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
 #endif
 
+  if (sockOptRet == 0)
+    sock->timeout = sec;
+
+  return (sockOptRet == 0) ? true : false;
+}
+
+/****************************************
+ * cg_socket_setnonblocking
+ ****************************************/
+
+bool cg_socket_setnonblocking(CGSocket* sock, bool flag)
+{
+#if defined(WIN32)
+  u_long mode;
+
+  if (!sock)
+    return false;
+
+  mode = flag ? 1 : 0;
+  return (ioctlsocket(sock->id, FIONBIO, &mode) == 0) ? true : false;
+#else
+  int flags;
+
+  if (!sock)
+    return false;
+
+  flags = fcntl(sock->id, F_GETFL, 0);
+  if (flags < 0)
+    return false;
+
+  flags = flag ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+  return (fcntl(sock->id, F_SETFL, flags) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_socket_setpktinfo
+ ****************************************/
+
+bool cg_socket_setpktinfo(CGSocket* sock, bool flag)
+{
+  struct sockaddr_storage sockAddr;
+  socklen_t sockAddrLen;
+  int sockOptRet;
+  int optval;
+
+  if (!sock)
+    return false;
+
+  sockAddrLen = sizeof(sockAddr);
+  if (getsockname(sock->id, (struct sockaddr*)&sockAddr, &sockAddrLen) != 0)
+    return false;
+
+  optval = (flag == true) ? 1 : 0;
+  sockOptRet = -1;
+
+  switch (sockAddr.ss_family) {
+  case AF_INET:
+#if defined(IP_PKTINFO)
+    sockOptRet = setsockopt(sock->id, IPPROTO_IP, IP_PKTINFO, (const char*)&optval, sizeof(optval));
+#endif
+    break;
+  case AF_INET6:
+#if defined(IPV6_RECVPKTINFO)
+    sockOptRet = setsockopt(sock->id, IPPROTO_IPV6, IPV6_RECVPKTINFO, (const char*)&optval, sizeof(optval));
+#elif defined(IPV6_PKTINFO)
+    sockOptRet = setsockopt(sock->id, IPPROTO_IPV6, IPV6_PKTINFO, (const char*)&optval, sizeof(optval));
+#endif
+#if defined(IP_PKTINFO)
+    /* IPv4-mapped traffic on dual-stack sockets */
+    if (sockOptRet == 0)
+      setsockopt(sock->id, IPPROTO_IP, IP_PKTINFO, (const char*)&optval, sizeof(optval));
+#endif
+    break;
+  }
+
+  return (sockOptRet == 0) ? true : false;
+}
+
+/****************************************
+ * cg_socket_settimestamp
+ ****************************************/
+
+bool cg_socket_settimestamp(CGSocket* sock, bool flag)
+{
+  int sockOptRet;
+  int optval;
+
+  if (!sock)
+    return false;
+
+  optval = (flag == true) ? 1 : 0;
+
+#if defined(SO_TIMESTAMPNS)
+  sockOptRet = setsockopt(sock->id, SOL_SOCKET, SO_TIMESTAMPNS, (const char*)&optval, sizeof(optval));
+#elif defined(SO_TIMESTAMP)
+  sockOptRet = setsockopt(sock->id, SOL_SOCKET, SO_TIMESTAMP, (const char*)&optval, sizeof(optval));
+#else
+  sockOptRet = -1;
+#endif
+
   return (sockOptRet == 0) ? true : false;
 }
 
@@ -821,6 +1756,34 @@ bool cg_socket_joingroup(CGSocket* sock, const char* mcastAddr, const char* ifAd
   return joinSuccess;
 }
 
+/****************************************
+ * cg_socket_joingroups
+ ****************************************/
+
+size_t cg_socket_joingroups(CGSocket* sock, const char* mcastAddr, CGNetworkInterfaceList* netIfList)
+{
+  CGNetworkInterface* netIf;
+  const char* ifAddr;
+  bool isMcastIpv6;
+  size_t joinedCnt;
+
+  if (!sock || !netIfList)
+    return 0;
+
+  isMcastIpv6 = cg_net_isipv6address(mcastAddr);
+
+  joinedCnt = 0;
+  for (netIf = cg_net_interfacelist_gets(netIfList); netIf; netIf = cg_net_interface_next(netIf)) {
+    ifAddr = cg_net_interface_getaddress(netIf);
+    if (cg_net_isipv6address(ifAddr) != isMcastIpv6)
+      continue;
+    if (cg_socket_joingroup(sock, mcastAddr, ifAddr))
+      joinedCnt++;
+  }
+
+  return joinedCnt;
+}
+
 /****************************************
  * cg_socket_tosockaddrin
  ****************************************/
@@ -874,3 +1837,34 @@ bool cg_socket_tosockaddrinfo(int sockType, const char* addr, int port, struct a
     return false;
   return true;
 }
+
+/****************************************
+ * cg_socket_cmsg_gettimestamp
+ ****************************************/
+
+#if !defined(WIN32)
+static uint64_t cg_socket_cmsg_gettimestamp(struct cmsghdr* cmsg)
+{
+#if defined(SCM_TIMESTAMPNS)
+  struct timespec ts;
+#endif
+#if defined(SCM_TIMESTAMP)
+  struct timeval tv;
+#endif
+
+#if defined(SCM_TIMESTAMPNS)
+  if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+    memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+  }
+#endif
+#if defined(SCM_TIMESTAMP)
+  if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+    memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+    return ((uint64_t)tv.tv_sec * 1000000000ULL) + ((uint64_t)tv.tv_usec * 1000ULL);
+  }
+#endif
+
+  return 0;
+}
+#endif
@@ -0,0 +1,333 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <string.h>
+
+#include <cgpr/net/socket_framer.h>
+#include <cgpr/util/bytes.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_FRAMER_HEADER_MAXSIZE CG_BYTES_VARINT_MAXSIZE
+
+/****************************************
+ * cg_socket_framer_new
+ ****************************************/
+
+CGSocketFramer* cg_socket_framer_new(CGSocket* sock, int lengthType)
+{
+  CGSocketFramer* framer;
+
+  if (!sock)
+    return NULL;
+
+  if ((lengthType != CG_NET_SOCKET_FRAMER_VARINT) && (lengthType != CG_NET_SOCKET_FRAMER_UINT16) && (lengthType != CG_NET_SOCKET_FRAMER_UINT32))
+    return NULL;
+
+  framer = (CGSocketFramer*)malloc(sizeof(CGSocketFramer));
+  if (!framer)
+    return NULL;
+
+  framer->sock = sock;
+  framer->lengthType = lengthType;
+  framer->maxFrameSize = 0;
+  framer->recvBuf = NULL;
+  framer->recvBufSize = 0;
+  framer->recvBegin = 0;
+  framer->recvEnd = 0;
+  framer->sendBuf = NULL;
+  framer->sendBufSize = 0;
+  framer->sendLen = 0;
+
+  if (!cg_socket_framer_setmaxframesize(framer, CG_NET_SOCKET_FRAMER_DEFAULT_MAXFRAMESIZE) || !cg_socket_framer_setsendbuffersize(framer, CG_NET_SOCKET_FRAMER_DEFAULT_SENDBUFSIZE)) {
+    cg_socket_framer_delete(framer);
+    return NULL;
+  }
+
+  return framer;
+}
+
+/****************************************
+ * cg_socket_framer_delete
+ ****************************************/
+
+void cg_socket_framer_delete(CGSocketFramer* framer)
+{
+  if (!framer)
+    return;
+
+  free(framer->recvBuf);
+  free(framer->sendBuf);
+  free(framer);
+}
+
+/****************************************
+ * cg_socket_framer_setmaxframesize
+ ****************************************/
+
+bool cg_socket_framer_setmaxframesize(CGSocketFramer* framer, size_t maxFrameSize)
+{
+  size_t recvBufSize;
+  byte* recvBuf;
+
+  if (!framer)
+    return false;
+
+  if ((framer->lengthType == CG_NET_SOCKET_FRAMER_UINT16) && (0xFFFF < maxFrameSize))
+    maxFrameSize = 0xFFFF;
+  if ((framer->lengthType == CG_NET_SOCKET_FRAMER_UINT32) && (0x7FFFFFFF < maxFrameSize))
+    maxFrameSize = 0x7FFFFFFF;
+
+  recvBufSize = maxFrameSize + CG_NET_SOCKET_FRAMER_HEADER_MAXSIZE;
+  if (recvBufSize < cg_socket_framer_getbufferedsize(framer))
+    return false;
+
+  if (0 < framer->recvBegin) {
+    memmove(framer->recvBuf, framer->recvBuf + framer->recvBegin, cg_socket_framer_getbufferedsize(framer));
+    framer->recvEnd -= framer->recvBegin;
+    framer->recvBegin = 0;
+  }
+
+  recvBuf = (byte*)realloc(framer->recvBuf, recvBufSize);
+  if (!recvBuf)
+    return false;
+
+  framer->recvBuf = recvBuf;
+  framer->recvBufSize = recvBufSize;
+  framer->maxFrameSize = maxFrameSize;
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_framer_setsendbuffersize
+ ****************************************/
+
+bool cg_socket_framer_setsendbuffersize(CGSocketFramer* framer, size_t bufSize)
+{
+  byte* sendBuf;
+
+  if (!framer)
+    return false;
+
+  if (!cg_socket_framer_flush(framer))
+    return false;
+
+  sendBuf = (byte*)realloc(framer->sendBuf, bufSize);
+  if (!sendBuf && (0 < bufSize))
+    return false;
+
+  framer->sendBuf = sendBuf;
+  framer->sendBufSize = bufSize;
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_framer_encodeheader
+ ****************************************/
+
+size_t cg_socket_framer_encodeheader(CGSocketFramer* framer, byte* buf, size_t frameLen)
+{
+  if (!framer || !buf)
+    return 0;
+
+  switch (framer->lengthType) {
+  case CG_NET_SOCKET_FRAMER_UINT16:
+  case CG_NET_SOCKET_FRAMER_UINT32:
+    cg_bytes_setint(buf, (int)frameLen, framer->lengthType);
+    return framer->lengthType;
+  }
+
+  return cg_bytes_setvarint(buf, frameLen);
+}
+
+/****************************************
+ * cg_socket_framer_decodeheader
+ ****************************************/
+
+static int cg_socket_framer_decodeheader(CGSocketFramer* framer, size_t* headerLen, size_t* frameLen)
+{
+  byte* buf;
+  size_t bufLen;
+  uint64_t varLen;
+  int intLen;
+
+  buf = framer->recvBuf + framer->recvBegin;
+  bufLen = cg_socket_framer_getbufferedsize(framer);
+
+  switch (framer->lengthType) {
+  case CG_NET_SOCKET_FRAMER_UINT16:
+  case CG_NET_SOCKET_FRAMER_UINT32:
+    if (bufLen < (size_t)framer->lengthType)
+      return 0;
+    intLen = cg_bytes_toint(buf, framer->lengthType);
+    if (intLen < 0)
+      return -1;
+    *headerLen = framer->lengthType;
+    *frameLen = (size_t)intLen;
+    break;
+  default:
+    *headerLen = cg_bytes_getvarint(buf, bufLen, &varLen);
+    if (*headerLen == 0)
+      return (bufLen < CG_BYTES_VARINT_MAXSIZE) ? 0 : -1;
+    if ((uint64_t)framer->maxFrameSize < varLen)
+      return -1;
+    *frameLen = (size_t)varLen;
+    break;
+  }
+
+  return (*frameLen <= framer->maxFrameSize) ? 1 : -1;
+}
+
+/****************************************
+ * cg_socket_framer_parse
+ ****************************************/
+
+static int cg_socket_framer_parse(CGSocketFramer* framer, const byte** frame, size_t* frameLen)
+{
+  size_t headerLen;
+  int ret;
+
+  ret = cg_socket_framer_decodeheader(framer, &headerLen, frameLen);
+  if (ret <= 0)
+    return ret;
+
+  if (cg_socket_framer_getbufferedsize(framer) < (headerLen + *frameLen))
+    return 0;
+
+  *frame = framer->recvBuf + framer->recvBegin + headerLen;
+  framer->recvBegin += headerLen + *frameLen;
+  if (framer->recvBegin == framer->recvEnd) {
+    framer->recvBegin = 0;
+    framer->recvEnd = 0;
+  }
+
+  return 1;
+}
+
+/****************************************
+ * cg_socket_framer_nextframe
+ ****************************************/
+
+bool cg_socket_framer_nextframe(CGSocketFramer* framer, const byte** frame, size_t* frameLen)
+{
+  if (!framer || !frame || !frameLen)
+    return false;
+
+  return (cg_socket_framer_parse(framer, frame, frameLen) == 1) ? true : false;
+}
+
+/****************************************
+ * cg_socket_framer_read
+ ****************************************/
+
+ssize_t cg_socket_framer_read(CGSocketFramer* framer, const byte** frame)
+{
+  size_t frameLen;
+  ssize_t readLen;
+  int ret;
+
+  if (!framer || !frame)
+    return -1;
+
+  while (true) {
+    ret = cg_socket_framer_parse(framer, frame, &frameLen);
+    if (ret < 0)
+      return -1;
+    if (0 < ret)
+      return (ssize_t)frameLen;
+
+    /* Keep the partial frame at the head so that the whole frame fits behind it */
+    if (0 < framer->recvBegin) {
+      memmove(framer->recvBuf, framer->recvBuf + framer->recvBegin, cg_socket_framer_getbufferedsize(framer));
+      framer->recvEnd -= framer->recvBegin;
+      framer->recvBegin = 0;
+    }
+
+    readLen = cg_socket_read(framer->sock, (char*)(framer->recvBuf + framer->recvEnd), framer->recvBufSize - framer->recvEnd);
+    if (readLen <= 0)
+      return -1;
+    framer->recvEnd += readLen;
+  }
+}
+
+/****************************************
+ * cg_socket_framer_write
+ ****************************************/
+
+bool cg_socket_framer_write(CGSocketFramer* framer, const byte* data, size_t dataLen)
+{
+  byte header[CG_NET_SOCKET_FRAMER_HEADER_MAXSIZE];
+  const byte* bufs[2];
+  size_t bufLens[2];
+  size_t headerLen;
+
+  if (!framer || (!data && (0 < dataLen)))
+    return false;
+
+  if (framer->maxFrameSize < dataLen)
+    return false;
+
+  headerLen = cg_socket_framer_encodeheader(framer, header, dataLen);
+
+  if (framer->sendBufSize < (framer->sendLen + headerLen + dataLen)) {
+    if (!cg_socket_framer_flush(framer))
+      return false;
+  }
+
+  /* Frames larger than the send buffer bypass it, with the header and the payload in one gathered write */
+  if (framer->sendBufSize < (headerLen + dataLen)) {
+    bufs[0] = header;
+    bufLens[0] = headerLen;
+    bufs[1] = data;
+    bufLens[1] = dataLen;
+    return (cg_socket_writev(framer->sock, bufs, bufLens, 2) == (headerLen + dataLen)) ? true : false;
+  }
+
+  memcpy(framer->sendBuf + framer->sendLen, header, headerLen);
+  framer->sendLen += headerLen;
+  if (0 < dataLen) {
+    memcpy(framer->sendBuf + framer->sendLen, data, dataLen);
+    framer->sendLen += dataLen;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_framer_flush
+ ****************************************/
+
+bool cg_socket_framer_flush(CGSocketFramer* framer)
+{
+  size_t sendLen;
+
+  if (!framer)
+    return false;
+
+  if (framer->sendLen <= 0)
+    return true;
+
+  sendLen = framer->sendLen;
+  framer->sendLen = 0;
+
+  return (cg_socket_write(framer->sock, (const char*)framer->sendBuf, sendLen) == sendLen) ? true : false;
+}
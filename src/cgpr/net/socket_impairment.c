@@ -0,0 +1,519 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <string.h>
+
+#include <cgpr/net/_socket.h>
+#include <cgpr/net/socket_impairment.h>
+#include <cgpr/util/fiber.h>
+#include <cgpr/util/time.h>
+
+#if !defined(WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_IMPAIRMENT_POLL_INTERVAL 100
+#define CG_NET_SOCKET_IMPAIRMENT_FULL_WAIT 1
+#define CG_NET_SOCKET_IMPAIRMENT_RETRY_WAIT 1
+#define CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_USEC 1000ULL
+#define CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_MSEC 1000000ULL
+#define CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_SEC 1000000000ULL
+
+#define cg_socket_impairment_packet_next(pkt) (CGSocketImpairmentPacket*)cg_list_next((CGList*)pkt)
+#define cg_socket_impairment_packet_prev(pkt) (CGSocketImpairmentPacket*)cg_list_prev((CGList*)pkt)
+#define cg_socket_impairment_packetlist_gets(pktList) (CGSocketImpairmentPacket*)cg_list_next((CGList*)pktList)
+
+/****************************************
+ * cg_socket_impairment_new
+ ****************************************/
+
+CGSocketImpairment* cg_socket_impairment_new(void)
+{
+  CGSocketImpairment* imp;
+
+  imp = (CGSocketImpairment*)malloc(sizeof(CGSocketImpairment));
+  if (!imp)
+    return NULL;
+
+  imp->mutex = cg_mutex_new();
+  imp->pktList = (CGSocketImpairmentPacketList*)malloc(sizeof(CGSocketImpairmentPacketList));
+  if (!imp->mutex || !imp->pktList || (pipe(imp->wakePipe) != 0)) {
+    cg_mutex_delete(imp->mutex);
+    free(imp->pktList);
+    free(imp);
+    return NULL;
+  }
+  cg_list_header_init((CGList*)imp->pktList);
+  fcntl(imp->wakePipe[1], F_SETFL, fcntl(imp->wakePipe[1], F_GETFL, 0) | O_NONBLOCK);
+
+  imp->delay = 0;
+  imp->jitter = 0;
+  imp->rate = 0;
+  imp->loss = 0.0;
+  imp->reorder = 0.0;
+  imp->linkFreeTime = 0;
+  imp->lastStreamTime = 0;
+  imp->queueLimit = CG_NET_SOCKET_IMPAIRMENT_DEFAULT_QUEUE_LIMIT;
+  imp->queuedBytes = 0;
+  imp->sentCnt = 0;
+  imp->droppedCnt = 0;
+  imp->reorderedCnt = 0;
+  imp->thread = NULL;
+  cg_socket_impairment_setseed(imp, CG_NET_SOCKET_IMPAIRMENT_DEFAULT_SEED);
+
+  return imp;
+}
+
+/****************************************
+ * cg_socket_impairment_clear
+ ****************************************/
+
+static void cg_socket_impairment_clear(CGSocketImpairment* imp)
+{
+  CGSocketImpairmentPacket* pkt;
+
+  cg_mutex_lock(imp->mutex);
+  while ((pkt = cg_socket_impairment_packetlist_gets(imp->pktList))) {
+    cg_list_remove((CGList*)pkt);
+    free(pkt);
+  }
+  imp->queuedBytes = 0;
+  cg_mutex_unlock(imp->mutex);
+}
+
+/****************************************
+ * cg_socket_impairment_delete
+ ****************************************/
+
+void cg_socket_impairment_delete(CGSocketImpairment* imp)
+{
+  if (!imp)
+    return;
+
+  cg_socket_impairment_stop(imp);
+  cg_socket_impairment_clear(imp);
+  close(imp->wakePipe[0]);
+  close(imp->wakePipe[1]);
+  cg_mutex_delete(imp->mutex);
+  free(imp->pktList);
+  free(imp);
+}
+
+/****************************************
+ * cg_socket_impairment_setseed
+ ****************************************/
+
+void cg_socket_impairment_setseed(CGSocketImpairment* imp, uint64_t seed)
+{
+  if (!imp)
+    return;
+
+  /* xorshift never leaves the zero state */
+  imp->randState = (seed != 0) ? seed : CG_NET_SOCKET_IMPAIRMENT_DEFAULT_SEED;
+}
+
+/****************************************
+ * cg_socket_impairment_rand
+ ****************************************/
+
+static uint64_t cg_socket_impairment_rand(CGSocketImpairment* imp)
+{
+  uint64_t x;
+
+  /* xorshift64* */
+  x = imp->randState;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  imp->randState = x;
+
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+/****************************************
+ * cg_socket_impairment_randprob
+ ****************************************/
+
+static bool cg_socket_impairment_randprob(CGSocketImpairment* imp, double prob)
+{
+  if (prob <= 0.0)
+    return false;
+
+  return (((double)(cg_socket_impairment_rand(imp) >> 11) / 9007199254740992.0) < prob) ? true : false;
+}
+
+/****************************************
+ * cg_socket_impairment_wakeup
+ ****************************************/
+
+static void cg_socket_impairment_wakeup(CGSocketImpairment* imp)
+{
+  /* The write end is non-blocking and a full pipe already wakes the thread */
+  if (write(imp->wakePipe[1], "", 1) != 1)
+    return;
+}
+
+/****************************************
+ * cg_socket_impairment_insert
+ ****************************************/
+
+static bool cg_socket_impairment_insert(CGSocketImpairment* imp, CGSocketImpairmentPacket* pkt)
+{
+  CGSocketImpairmentPacket* prevPkt;
+
+  /* Packets mostly arrive in delivery order, so the position is searched from the tail */
+  prevPkt = (CGSocketImpairmentPacket*)cg_list_prev((CGList*)imp->pktList);
+  while (prevPkt && (pkt->deliveryTime < prevPkt->deliveryTime))
+    prevPkt = cg_socket_impairment_packet_prev(prevPkt);
+  cg_list_insert(prevPkt ? (CGList*)prevPkt : (CGList*)imp->pktList, (CGList*)pkt);
+
+  return prevPkt ? false : true;
+}
+
+/****************************************
+ * cg_socket_impairment_isfull
+ ****************************************/
+
+static bool cg_socket_impairment_isfull(CGSocketImpairment* imp, size_t dataLen)
+{
+  /* A write larger than the whole limit is still taken when the queue is empty */
+  if ((imp->queueLimit <= 0) || (imp->queuedBytes <= 0))
+    return false;
+
+  return (imp->queueLimit < (imp->queuedBytes + dataLen)) ? true : false;
+}
+
+/****************************************
+ * cg_socket_impairment_waitroom
+ ****************************************/
+
+static bool cg_socket_impairment_waitroom(CGSocketImpairment* imp, CGSocket* sock, size_t dataLen)
+{
+  /* Called with the mutex held, a queue which is not drained or a non-blocking socket is not waited for */
+  while (cg_socket_impairment_isfull(imp, dataLen)) {
+    if (!imp->thread || (fcntl(cg_socket_getid(sock), F_GETFL, 0) & O_NONBLOCK)) {
+      errno = EAGAIN;
+      return false;
+    }
+    cg_mutex_unlock(imp->mutex);
+    if (cg_fiber_isactive())
+      cg_fiber_sleep(CG_NET_SOCKET_IMPAIRMENT_FULL_WAIT);
+    else
+      cg_wait(CG_NET_SOCKET_IMPAIRMENT_FULL_WAIT);
+    cg_mutex_lock(imp->mutex);
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_impairment_enqueue
+ ****************************************/
+
+ssize_t cg_socket_impairment_enqueue(CGSocketImpairment* imp, CGSocket* sock, const void* data, size_t dataLen, const struct sockaddr* toAddr, socklen_t toAddrLen)
+{
+  CGSocketImpairmentPacket* pkt;
+  uint64_t now;
+  uint64_t sendTime;
+  uint64_t delay;
+  uint64_t jitter;
+  bool isDatagram;
+  bool isHead;
+
+  if (!imp || !sock || (!data && (0 < dataLen)) || (sizeof(pkt->toAddr) < toAddrLen))
+    return -1;
+
+  pkt = (CGSocketImpairmentPacket*)malloc(sizeof(CGSocketImpairmentPacket) + dataLen);
+  if (!pkt)
+    return -1;
+
+  cg_list_node_init((CGList*)pkt);
+  pkt->sock = sock;
+  pkt->data = (byte*)(pkt + 1);
+  pkt->dataLen = dataLen;
+  memcpy(pkt->data, data, dataLen);
+  pkt->toAddrLen = toAddrLen;
+  if (0 < toAddrLen)
+    memcpy(&pkt->toAddr, toAddr, toAddrLen);
+
+  isDatagram = cg_socket_isdatagramstream(sock);
+
+  cg_mutex_lock(imp->mutex);
+
+  if (isDatagram && cg_socket_impairment_randprob(imp, imp->loss)) {
+    imp->droppedCnt++;
+    cg_mutex_unlock(imp->mutex);
+    free(pkt);
+    return (ssize_t)dataLen;
+  }
+
+  /* A full queue tail-drops datagrams and holds stream writes back */
+  if (isDatagram && cg_socket_impairment_isfull(imp, dataLen)) {
+    imp->droppedCnt++;
+    cg_mutex_unlock(imp->mutex);
+    free(pkt);
+    return (ssize_t)dataLen;
+  }
+  if (!isDatagram && !cg_socket_impairment_waitroom(imp, sock, dataLen)) {
+    cg_mutex_unlock(imp->mutex);
+    free(pkt);
+    return -1;
+  }
+
+  now = cg_getmonotonicnanotime();
+
+  /* The bandwidth cap serializes packets on one virtual link */
+  sendTime = now;
+  if (0 < imp->rate) {
+    if (imp->linkFreeTime < now)
+      imp->linkFreeTime = now;
+    imp->linkFreeTime += (dataLen * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_SEC) / imp->rate;
+    sendTime = imp->linkFreeTime;
+  }
+
+  delay = imp->delay * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_USEC;
+  if (0 < imp->jitter) {
+    jitter = (cg_socket_impairment_rand(imp) % ((imp->jitter * 2) + 1)) * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_USEC;
+    delay = ((delay + jitter) < (imp->jitter * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_USEC)) ? 0 : (delay + jitter - (imp->jitter * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_USEC));
+  }
+  pkt->deliveryTime = sendTime + delay;
+
+  if (isDatagram) {
+    /* A reordered packet skips the delay line and overtakes the queued ones */
+    if (cg_socket_impairment_randprob(imp, imp->reorder)) {
+      pkt->deliveryTime = sendTime;
+      imp->reorderedCnt++;
+    }
+  }
+  else {
+    if (pkt->deliveryTime < imp->lastStreamTime)
+      pkt->deliveryTime = imp->lastStreamTime;
+    imp->lastStreamTime = pkt->deliveryTime;
+  }
+
+  isHead = cg_socket_impairment_insert(imp, pkt);
+  imp->queuedBytes += dataLen;
+
+  cg_mutex_unlock(imp->mutex);
+
+  if (isHead)
+    cg_socket_impairment_wakeup(imp);
+
+  return (ssize_t)dataLen;
+}
+
+/****************************************
+ * cg_socket_impairment_getpendingsize
+ ****************************************/
+
+size_t cg_socket_impairment_getpendingsize(CGSocketImpairment* imp)
+{
+  size_t pendingCnt;
+
+  if (!imp)
+    return 0;
+
+  cg_mutex_lock(imp->mutex);
+  pendingCnt = cg_list_size((CGList*)imp->pktList);
+  cg_mutex_unlock(imp->mutex);
+
+  return pendingCnt;
+}
+
+/****************************************
+ * cg_socket_impairment_deliver
+ ****************************************/
+
+static bool cg_socket_impairment_deliver(CGSocketImpairmentPacket* pkt)
+{
+  ssize_t sentLen;
+
+  /* A full socket buffer must not stall the other sockets, so the rest of the packet is sent later */
+  while (0 < pkt->dataLen) {
+    if (0 < pkt->toAddrLen)
+      sentLen = sendto(cg_socket_getid(pkt->sock), pkt->data, pkt->dataLen, MSG_NOSIGNAL | MSG_DONTWAIT, (struct sockaddr*)&pkt->toAddr, pkt->toAddrLen);
+    else
+      sentLen = send(cg_socket_getid(pkt->sock), pkt->data, pkt->dataLen, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (sentLen < 0)
+      return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? false : true;
+    if (0 < pkt->toAddrLen)
+      break;
+    pkt->data += sentLen;
+    pkt->dataLen -= (size_t)sentLen;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_impairment_requeue
+ ****************************************/
+
+static void cg_socket_impairment_requeue(CGSocketImpairment* imp, CGSocketImpairmentPacket* pkt, uint64_t retryTime)
+{
+  CGSocketImpairmentPacketList heldList;
+  CGSocketImpairmentPacket* heldPkt;
+  CGSocketImpairmentPacket* nextPkt;
+
+  /* Packets of the same socket which are due before the retry must not overtake the blocked one */
+  cg_list_header_init((CGList*)&heldList);
+  for (heldPkt = cg_socket_impairment_packetlist_gets(imp->pktList); heldPkt && (heldPkt->deliveryTime <= retryTime); heldPkt = nextPkt) {
+    nextPkt = cg_socket_impairment_packet_next(heldPkt);
+    if (heldPkt->sock != pkt->sock)
+      continue;
+    cg_list_remove((CGList*)heldPkt);
+    cg_list_add((CGList*)&heldList, (CGList*)heldPkt);
+  }
+
+  pkt->deliveryTime = retryTime;
+  cg_socket_impairment_insert(imp, pkt);
+  while ((heldPkt = cg_socket_impairment_packetlist_gets(&heldList))) {
+    cg_list_remove((CGList*)heldPkt);
+    heldPkt->deliveryTime = retryTime;
+    cg_socket_impairment_insert(imp, heldPkt);
+  }
+
+  if (!cg_socket_isdatagramstream(pkt->sock) && (imp->lastStreamTime < retryTime))
+    imp->lastStreamTime = retryTime;
+}
+
+/****************************************
+ * cg_socket_impairment_action
+ ****************************************/
+
+static void cg_socket_impairment_action(CGThread* thread)
+{
+  CGSocketImpairment* imp;
+  CGSocketImpairmentPacket* pkt;
+  struct pollfd pfds[2];
+  char wakeBuf[64];
+  uint64_t now;
+  uint64_t waitTime;
+  size_t dataLen;
+  bool isDelivered;
+
+  imp = (CGSocketImpairment*)cg_thread_getuserdata(thread);
+
+  pfds[0].fd = imp->wakePipe[0];
+  pfds[0].events = POLLIN;
+  pfds[1].fd = cg_thread_getstopfd(thread);
+  pfds[1].events = POLLIN;
+
+  while (cg_thread_isrunnable(thread)) {
+    cg_mutex_lock(imp->mutex);
+    pkt = cg_socket_impairment_packetlist_gets(imp->pktList);
+    now = cg_getmonotonicnanotime();
+    if (pkt && (pkt->deliveryTime <= now)) {
+      cg_list_remove((CGList*)pkt);
+      cg_mutex_unlock(imp->mutex);
+      dataLen = pkt->dataLen;
+      isDelivered = cg_socket_impairment_deliver(pkt);
+      cg_mutex_lock(imp->mutex);
+      imp->queuedBytes -= isDelivered ? dataLen : (dataLen - pkt->dataLen);
+      if (isDelivered)
+        imp->sentCnt++;
+      else
+        cg_socket_impairment_requeue(imp, pkt, now + (CG_NET_SOCKET_IMPAIRMENT_RETRY_WAIT * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_MSEC));
+      cg_mutex_unlock(imp->mutex);
+      if (isDelivered)
+        free(pkt);
+      continue;
+    }
+    waitTime = pkt ? (pkt->deliveryTime - now) : (CG_NET_SOCKET_IMPAIRMENT_POLL_INTERVAL * CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_MSEC);
+    cg_mutex_unlock(imp->mutex);
+
+    /* poll() only has millisecond resolution, so the sub-millisecond rest is slept precisely */
+    if (waitTime < CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_MSEC) {
+      cg_waitnano(waitTime);
+      continue;
+    }
+
+    pfds[0].revents = pfds[1].revents = 0;
+    if ((0 < poll(pfds, 2, (int)(waitTime / CG_NET_SOCKET_IMPAIRMENT_NSEC_PER_MSEC))) && (pfds[0].revents & POLLIN)) {
+      if (read(imp->wakePipe[0], wakeBuf, sizeof(wakeBuf)) <= 0)
+        continue;
+    }
+  }
+}
+
+/****************************************
+ * cg_socket_impairment_start
+ ****************************************/
+
+bool cg_socket_impairment_start(CGSocketImpairment* imp)
+{
+  if (!imp)
+    return false;
+
+  if (imp->thread)
+    return true;
+
+  imp->thread = cg_thread_new();
+  if (!imp->thread)
+    return false;
+
+  cg_thread_setaction(imp->thread, cg_socket_impairment_action);
+  cg_thread_setuserdata(imp->thread, imp);
+
+  if (!cg_thread_start(imp->thread)) {
+    cg_thread_delete(imp->thread);
+    imp->thread = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_impairment_stop
+ ****************************************/
+
+bool cg_socket_impairment_stop(CGSocketImpairment* imp)
+{
+  if (!imp)
+    return false;
+
+  if (!imp->thread)
+    return true;
+
+  cg_thread_stop(imp->thread);
+  cg_thread_delete(imp->thread);
+  imp->thread = NULL;
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_impairment_isrunning
+ ****************************************/
+
+bool cg_socket_impairment_isrunning(CGSocketImpairment* imp)
+{
+  if (!imp)
+    return false;
+
+  return imp->thread ? true : false;
+}
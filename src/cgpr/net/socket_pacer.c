@@ -0,0 +1,111 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <cgpr/net/_socket.h>
+#include <cgpr/util/time.h>
+
+#if !defined(WIN32)
+#include <sys/socket.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_NET_SOCKET_PACER_NSEC_PER_SEC 1000000000ULL
+
+/* Sleeping overshoots by tens of microseconds, so the tail of a wait is spun */
+#define CG_NET_SOCKET_PACER_SPIN_NSEC 50000ULL
+
+/****************************************
+ * cg_socket_setpacingrate
+ ****************************************/
+
+bool cg_socket_setpacingrate(CGSocket* sock, uint64_t bytesPerSec, size_t burstBytes)
+{
+  if (!sock)
+    return false;
+
+  sock->pacer.rate = bytesPerSec;
+  sock->pacer.burst = burstBytes;
+  cg_atomic_store(&sock->pacer.tat, 0, CG_ATOMIC_RELAXED);
+
+  if (!cg_socket_isbound(sock))
+    return true;
+
+  return cg_socket_pacer_apply(sock);
+}
+
+/****************************************
+ * cg_socket_pacer_apply
+ ****************************************/
+
+bool cg_socket_pacer_apply(CGSocket* sock)
+{
+#if defined(SO_MAX_PACING_RATE)
+  uint32_t maxRate;
+
+  if (!sock)
+    return false;
+
+  /* The kernel only honours the cap with the fq qdisc; the user-space bucket always applies */
+  maxRate = ((0 < sock->pacer.rate) && (sock->pacer.rate < UINT32_MAX)) ? (uint32_t)sock->pacer.rate : UINT32_MAX;
+  return (setsockopt(sock->id, SOL_SOCKET, SO_MAX_PACING_RATE, (const char*)&maxRate, sizeof(maxRate)) == 0) ? true : false;
+#else
+  return sock ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_socket_pacer_wait
+ ****************************************/
+
+void cg_socket_pacer_wait(CGSocket* sock, size_t dataLen)
+{
+  CGSocketPacer* pacer;
+  uint64_t burstTime;
+  uint64_t sendTime;
+  uint64_t now;
+  uint64_t tat;
+  uint64_t nextTat;
+
+  if (!sock)
+    return;
+
+  pacer = &sock->pacer;
+  if (pacer->rate <= 0)
+    return;
+
+  burstTime = (pacer->burst * CG_NET_SOCKET_PACER_NSEC_PER_SEC) / pacer->rate;
+
+  /* Reserve [tat, tat + cost) on the virtual timeline; a send may run up to burstTime ahead of it */
+  now = cg_getmonotonicnanotime();
+  tat = cg_atomic_load(&pacer->tat, CG_ATOMIC_RELAXED);
+  do {
+    nextTat = ((now < tat) ? tat : now) + (((uint64_t)dataLen * CG_NET_SOCKET_PACER_NSEC_PER_SEC) / pacer->rate);
+  } while (!cg_atomic_cas(&pacer->tat, &tat, nextTat, CG_ATOMIC_RELAXED));
+
+  sendTime = (burstTime < tat) ? (tat - burstTime) : 0;
+  if (sendTime <= now)
+    return;
+
+  if (CG_NET_SOCKET_PACER_SPIN_NSEC < (sendTime - now))
+    cg_waitnano(sendTime - now - CG_NET_SOCKET_PACER_SPIN_NSEC);
+  while (cg_getmonotonicnanotime() < sendTime) {
+  }
+}
@@ -0,0 +1,352 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <string.h>
+
+#include <cgpr/net/socket_pool.h>
+#include <cgpr/util/time.h>
+
+#if defined(WIN32)
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define cg_socket_pool_connection_next(conn) (CGSocketPoolConnection*)cg_list_next((CGList*)conn)
+#define cg_socket_pool_connectionlist_gets(connList) (CGSocketPoolConnection*)cg_list_next((CGList*)connList)
+
+/****************************************
+ * cg_socket_pool_connection_new
+ ****************************************/
+
+static CGSocketPoolConnection* cg_socket_pool_connection_new(const char* host, int port, bool ssl)
+{
+  CGSocketPoolConnection* conn;
+
+  conn = (CGSocketPoolConnection*)malloc(sizeof(CGSocketPoolConnection));
+  if (!conn)
+    return NULL;
+
+  cg_list_node_init((CGList*)conn);
+  conn->sock = NULL;
+  cg_strncpy(conn->host, host, sizeof(conn->host) - 1);
+  conn->host[sizeof(conn->host) - 1] = '\0';
+  conn->port = port;
+  conn->ssl = ssl;
+  conn->idleTime = 0;
+
+  return conn;
+}
+
+/****************************************
+ * cg_socket_pool_connection_delete
+ ****************************************/
+
+static void cg_socket_pool_connection_delete(CGSocketPoolConnection* conn)
+{
+  cg_list_remove((CGList*)conn);
+  if (conn->sock)
+    cg_socket_delete(conn->sock);
+  free(conn);
+}
+
+/****************************************
+ * cg_socket_pool_connection_equals
+ ****************************************/
+
+static bool cg_socket_pool_connection_equals(CGSocketPoolConnection* conn, const char* host, int port, bool ssl)
+{
+  if ((conn->port != port) || (conn->ssl != ssl))
+    return false;
+  return (strcmp(conn->host, host) == 0) ? true : false;
+}
+
+/****************************************
+ * cg_socket_pool_connection_isalive
+ ****************************************/
+
+static bool cg_socket_pool_connection_isalive(CGSocketPoolConnection* conn)
+{
+#if defined(WIN32)
+  WSAPOLLFD pollFd;
+#else
+  struct pollfd pollFd;
+#endif
+
+  /* An idle connection has nothing to read: readable means EOF, a reset or stale data */
+  pollFd.fd = cg_socket_getid(conn->sock);
+  pollFd.events = POLLIN;
+  pollFd.revents = 0;
+#if defined(WIN32)
+  return (WSAPoll(&pollFd, 1, 0) == 0) ? true : false;
+#else
+  return (poll(&pollFd, 1, 0) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_socket_pool_new
+ ****************************************/
+
+CGSocketPool* cg_socket_pool_new(void)
+{
+  CGSocketPool* pool;
+
+  pool = (CGSocketPool*)malloc(sizeof(CGSocketPool));
+  if (!pool)
+    return NULL;
+
+  pool->mutex = cg_mutex_new();
+  pool->idleList = (CGSocketPoolConnectionList*)malloc(sizeof(CGSocketPoolConnectionList));
+  pool->busyList = (CGSocketPoolConnectionList*)malloc(sizeof(CGSocketPoolConnectionList));
+  if (!pool->mutex || !pool->idleList || !pool->busyList) {
+    cg_mutex_delete(pool->mutex);
+    free(pool->idleList);
+    free(pool->busyList);
+    free(pool);
+    return NULL;
+  }
+
+  cg_list_header_init((CGList*)pool->idleList);
+  cg_list_header_init((CGList*)pool->busyList);
+  pool->maxIdle = CG_NET_SOCKET_POOL_DEFAULT_MAXIDLE;
+  pool->maxPerHost = CG_NET_SOCKET_POOL_DEFAULT_MAXPERHOST;
+  pool->idleTimeout = CG_NET_SOCKET_POOL_DEFAULT_IDLETIMEOUT;
+
+  return pool;
+}
+
+/****************************************
+ * cg_socket_pool_delete
+ ****************************************/
+
+void cg_socket_pool_delete(CGSocketPool* pool)
+{
+  CGSocketPoolConnection* conn;
+
+  if (!pool)
+    return;
+
+  cg_socket_pool_clear(pool);
+
+  /* Checked out sockets still belong to their users */
+  while ((conn = cg_socket_pool_connectionlist_gets(pool->busyList))) {
+    conn->sock = NULL;
+    cg_socket_pool_connection_delete(conn);
+  }
+
+  cg_mutex_delete(pool->mutex);
+  free(pool->idleList);
+  free(pool->busyList);
+  free(pool);
+}
+
+/****************************************
+ * cg_socket_pool_clear
+ ****************************************/
+
+void cg_socket_pool_clear(CGSocketPool* pool)
+{
+  CGSocketPoolConnection* conn;
+
+  if (!pool)
+    return;
+
+  cg_mutex_lock(pool->mutex);
+  while ((conn = cg_socket_pool_connectionlist_gets(pool->idleList)))
+    cg_socket_pool_connection_delete(conn);
+  cg_mutex_unlock(pool->mutex);
+}
+
+/****************************************
+ * cg_socket_pool_expire
+ ****************************************/
+
+static void cg_socket_pool_expire(CGSocketPool* pool, uint64_t now)
+{
+  CGSocketPoolConnection* conn;
+  CGSocketPoolConnection* nextConn;
+  uint64_t idleTimeout;
+
+  idleTimeout = (uint64_t)pool->idleTimeout * 1000000ULL;
+  for (conn = cg_socket_pool_connectionlist_gets(pool->idleList); conn; conn = nextConn) {
+    nextConn = cg_socket_pool_connection_next(conn);
+    if (idleTimeout < (now - conn->idleTime))
+      cg_socket_pool_connection_delete(conn);
+  }
+}
+
+/****************************************
+ * cg_socket_pool_checkout
+ ****************************************/
+
+CGSocket* cg_socket_pool_checkout(CGSocketPool* pool, const char* host, int port, bool ssl)
+{
+  CGSocketPoolConnection* conn;
+  CGSocketPoolConnection* nextConn;
+  CGSocket* sock;
+  size_t hostConnCnt;
+
+  if (!pool || !host)
+    return NULL;
+
+  cg_mutex_lock(pool->mutex);
+
+  cg_socket_pool_expire(pool, cg_getmonotonicnanotime());
+
+  /* The idle list is kept most recently used first */
+  for (conn = cg_socket_pool_connectionlist_gets(pool->idleList); conn; conn = nextConn) {
+    nextConn = cg_socket_pool_connection_next(conn);
+    if (!cg_socket_pool_connection_equals(conn, host, port, ssl))
+      continue;
+    if (!cg_socket_pool_connection_isalive(conn)) {
+      cg_socket_pool_connection_delete(conn);
+      continue;
+    }
+    cg_list_remove((CGList*)conn);
+    cg_list_add((CGList*)pool->busyList, (CGList*)conn);
+    cg_mutex_unlock(pool->mutex);
+    return conn->sock;
+  }
+
+  hostConnCnt = 0;
+  for (conn = cg_socket_pool_connectionlist_gets(pool->busyList); conn; conn = cg_socket_pool_connection_next(conn)) {
+    if (cg_socket_pool_connection_equals(conn, host, port, ssl))
+      hostConnCnt++;
+  }
+  if (pool->maxPerHost <= hostConnCnt) {
+    cg_mutex_unlock(pool->mutex);
+    return NULL;
+  }
+
+  /* Reserve the slot, then connect without holding the lock */
+  conn = cg_socket_pool_connection_new(host, port, ssl);
+  if (!conn) {
+    cg_mutex_unlock(pool->mutex);
+    return NULL;
+  }
+  cg_list_add((CGList*)pool->busyList, (CGList*)conn);
+
+  cg_mutex_unlock(pool->mutex);
+
+#if defined(CG_USE_OPENSSL)
+  sock = ssl ? cg_socket_ssl_new() : cg_socket_stream_new();
+#else
+  sock = ssl ? NULL : cg_socket_stream_new();
+#endif
+
+  if (sock && !cg_socket_connect(sock, host, port)) {
+    cg_socket_delete(sock);
+    sock = NULL;
+  }
+
+  cg_mutex_lock(pool->mutex);
+  if (sock)
+    conn->sock = sock;
+  else
+    cg_socket_pool_connection_delete(conn);
+  cg_mutex_unlock(pool->mutex);
+
+  return sock;
+}
+
+/****************************************
+ * cg_socket_pool_checkin
+ ****************************************/
+
+bool cg_socket_pool_checkin(CGSocketPool* pool, CGSocket* sock, bool isReusable)
+{
+  CGSocketPoolConnection* conn;
+  CGSocketPoolConnection* lastConn;
+
+  if (!pool || !sock)
+    return false;
+
+  cg_mutex_lock(pool->mutex);
+
+  for (conn = cg_socket_pool_connectionlist_gets(pool->busyList); conn; conn = cg_socket_pool_connection_next(conn)) {
+    if (conn->sock == sock)
+      break;
+  }
+
+  if (!conn) {
+    cg_mutex_unlock(pool->mutex);
+    return false;
+  }
+
+  if (!isReusable || (pool->maxIdle <= 0)) {
+    cg_socket_pool_connection_delete(conn);
+    cg_mutex_unlock(pool->mutex);
+    return true;
+  }
+
+  /* Drop the least recently used idle connection to make room */
+  if (pool->maxIdle <= cg_list_size((CGList*)pool->idleList)) {
+    lastConn = (CGSocketPoolConnection*)cg_list_prev((CGList*)pool->idleList);
+    if (lastConn)
+      cg_socket_pool_connection_delete(lastConn);
+  }
+
+  cg_list_remove((CGList*)conn);
+  conn->idleTime = cg_getmonotonicnanotime();
+  cg_list_insert((CGList*)pool->idleList, (CGList*)conn);
+
+  cg_mutex_unlock(pool->mutex);
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_pool_getidlesize
+ ****************************************/
+
+size_t cg_socket_pool_getidlesize(CGSocketPool* pool)
+{
+  size_t idleCnt;
+
+  if (!pool)
+    return 0;
+
+  cg_mutex_lock(pool->mutex);
+  idleCnt = cg_list_size((CGList*)pool->idleList);
+  cg_mutex_unlock(pool->mutex);
+
+  return idleCnt;
+}
+
+/****************************************
+ * cg_socket_pool_getbusysize
+ ****************************************/
+
+size_t cg_socket_pool_getbusysize(CGSocketPool* pool)
+{
+  size_t busyCnt;
+
+  if (!pool)
+    return 0;
+
+  cg_mutex_lock(pool->mutex);
+  busyCnt = cg_list_size((CGList*)pool->busyList);
+  cg_mutex_unlock(pool->mutex);
+
+  return busyCnt;
+}
@@ -0,0 +1,137 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <string.h>
+
+#include <cgpr/net/_socket.h>
+
+/****************************************
+ * global variables
+ ****************************************/
+
+CGSocketStatsShard _gSocketStatsShards[CG_NET_SOCKET_STATS_SHARD_CNT];
+CG_NET_SOCKET_STATS_TLS CGSocketStats* _gSocketStatsShard = NULL;
+
+/****************************************
+ * static variables
+ ****************************************/
+
+static size_t _gSocketStatsNextShard = 0;
+
+/****************************************
+ * cg_socket_stats_copy
+ ****************************************/
+
+static void cg_socket_stats_copy(CGSocketStats* dst, CGSocketStats* src)
+{
+  uint64_t* dstCnts = (uint64_t*)dst;
+  uint64_t* srcCnts = (uint64_t*)src;
+  size_t n;
+
+  for (n = 0; n < (sizeof(CGSocketStats) / sizeof(uint64_t)); n++)
+    dstCnts[n] = cg_atomic_load(&srcCnts[n], CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_socket_stats_clear
+ ****************************************/
+
+static void cg_socket_stats_clear(CGSocketStats* stats)
+{
+  uint64_t* cnts = (uint64_t*)stats;
+  size_t n;
+
+  for (n = 0; n < (sizeof(CGSocketStats) / sizeof(uint64_t)); n++)
+    cg_atomic_store(&cnts[n], 0, CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_socket_stats_assignshard
+ ****************************************/
+
+CGSocketStats* cg_socket_stats_assignshard(void)
+{
+  size_t shardIdx;
+
+  shardIdx = cg_atomic_inc(&_gSocketStatsNextShard) % CG_NET_SOCKET_STATS_SHARD_CNT;
+  _gSocketStatsShard = &_gSocketStatsShards[shardIdx].stats;
+
+  return _gSocketStatsShard;
+}
+
+/****************************************
+ * cg_socket_getstats
+ ****************************************/
+
+void cg_socket_getstats(CGSocket* sock, CGSocketStats* stats)
+{
+  if (!stats)
+    return;
+
+  if (!sock) {
+    memset(stats, 0, sizeof(CGSocketStats));
+    return;
+  }
+
+  cg_socket_stats_copy(stats, &sock->stats);
+}
+
+/****************************************
+ * cg_socket_resetstats
+ ****************************************/
+
+void cg_socket_resetstats(CGSocket* sock)
+{
+  if (!sock)
+    return;
+
+  cg_socket_stats_clear(&sock->stats);
+}
+
+/****************************************
+ * cg_socket_getglobalstats
+ ****************************************/
+
+void cg_socket_getglobalstats(CGSocketStats* stats)
+{
+  uint64_t* cnts = (uint64_t*)stats;
+  uint64_t* shardCnts;
+  size_t shardIdx, n;
+
+  if (!stats)
+    return;
+
+  memset(stats, 0, sizeof(CGSocketStats));
+  for (shardIdx = 0; shardIdx < CG_NET_SOCKET_STATS_SHARD_CNT; shardIdx++) {
+    shardCnts = (uint64_t*)&_gSocketStatsShards[shardIdx].stats;
+    for (n = 0; n < (sizeof(CGSocketStats) / sizeof(uint64_t)); n++)
+      cnts[n] += cg_atomic_load(&shardCnts[n], CG_ATOMIC_RELAXED);
+  }
+}
+
+/****************************************
+ * cg_socket_resetglobalstats
+ ****************************************/
+
+void cg_socket_resetglobalstats(void)
+{
+  size_t shardIdx;
+
+  for (shardIdx = 0; shardIdx < CG_NET_SOCKET_STATS_SHARD_CNT; shardIdx++)
+    cg_socket_stats_clear(&_gSocketStatsShards[shardIdx].stats);
+}
@@ -0,0 +1,88 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <string.h>
+
+#include <cgpr/net/socket.h>
+
+#if defined(__linux__)
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+/****************************************
+ * cg_socket_gettcpinfo
+ ****************************************/
+
+bool cg_socket_gettcpinfo(CGSocket* sock, CGSocketTcpInfo* info)
+{
+#if defined(__linux__) && defined(TCP_INFO)
+  struct tcp_info tcpInfo;
+  socklen_t tcpInfoLen;
+#endif
+
+  if (!sock || !info)
+    return false;
+
+  memset(info, 0, sizeof(CGSocketTcpInfo));
+
+  if (!cg_socket_issocketstream(sock) || !cg_socket_isbound(sock))
+    return false;
+
+#if defined(__linux__) && defined(TCP_INFO)
+  /* Older kernels return a shorter structure, so the tail stays zero */
+  memset(&tcpInfo, 0, sizeof(tcpInfo));
+  tcpInfoLen = sizeof(tcpInfo);
+  if (getsockopt(sock->id, IPPROTO_TCP, TCP_INFO, &tcpInfo, &tcpInfoLen) != 0)
+    return false;
+
+  info->state = tcpInfo.tcpi_state;
+  info->caState = tcpInfo.tcpi_ca_state;
+  info->retransmits = tcpInfo.tcpi_retransmits;
+  info->probes = tcpInfo.tcpi_probes;
+  info->backoff = tcpInfo.tcpi_backoff;
+  info->rto = tcpInfo.tcpi_rto;
+  info->sndMss = tcpInfo.tcpi_snd_mss;
+  info->rcvMss = tcpInfo.tcpi_rcv_mss;
+  info->pmtu = tcpInfo.tcpi_pmtu;
+  info->rtt = tcpInfo.tcpi_rtt;
+  info->rttVar = tcpInfo.tcpi_rttvar;
+  info->minRtt = tcpInfo.tcpi_min_rtt;
+  info->sndCwnd = tcpInfo.tcpi_snd_cwnd;
+  info->sndSsthresh = tcpInfo.tcpi_snd_ssthresh;
+  info->unacked = tcpInfo.tcpi_unacked;
+  info->sacked = tcpInfo.tcpi_sacked;
+  info->lost = tcpInfo.tcpi_lost;
+  info->retrans = tcpInfo.tcpi_retrans;
+  info->totalRetrans = tcpInfo.tcpi_total_retrans;
+  info->reordering = tcpInfo.tcpi_reordering;
+  info->notsentBytes = tcpInfo.tcpi_notsent_bytes;
+  info->pacingRate = tcpInfo.tcpi_pacing_rate;
+  info->deliveryRate = tcpInfo.tcpi_delivery_rate;
+  info->bytesAcked = tcpInfo.tcpi_bytes_acked;
+  info->bytesReceived = tcpInfo.tcpi_bytes_received;
+  info->busyTime = tcpInfo.tcpi_busy_time;
+  info->rwndLimited = tcpInfo.tcpi_rwnd_limited;
+  info->sndbufLimited = tcpInfo.tcpi_sndbuf_limited;
+
+  return true;
+#else
+  return false;
+#endif
+}
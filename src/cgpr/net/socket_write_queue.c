@@ -0,0 +1,378 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <errno.h>
+#include <string.h>
+
+#include <cgpr/net/_socket.h>
+#include <cgpr/net/socket_write_queue.h>
+
+#if !defined(WIN32)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#if defined(MSG_NOSIGNAL)
+#define CG_NET_SOCKET_WRITE_QUEUE_SEND_FLAGS (MSG_DONTWAIT | MSG_NOSIGNAL)
+#elif defined(MSG_DONTWAIT)
+#define CG_NET_SOCKET_WRITE_QUEUE_SEND_FLAGS MSG_DONTWAIT
+#else
+#define CG_NET_SOCKET_WRITE_QUEUE_SEND_FLAGS 0
+#endif
+
+/****************************************
+ * cg_socket_write_queue_segment_new
+ ****************************************/
+
+static CGSocketWriteQueueSegment* cg_socket_write_queue_segment_new(CGSocketWriteQueue* queue, size_t dataLen)
+{
+  CGSocketWriteQueueSegment* seg;
+  size_t capacity;
+
+  capacity = (CG_NET_SOCKET_WRITE_QUEUE_SEGMENT_SIZE < dataLen) ? dataLen : CG_NET_SOCKET_WRITE_QUEUE_SEGMENT_SIZE;
+
+  /* Spares all have the default capacity */
+  if ((capacity == CG_NET_SOCKET_WRITE_QUEUE_SEGMENT_SIZE) && queue->spares) {
+    seg = queue->spares;
+    queue->spares = seg->next;
+    queue->spareCnt--;
+  }
+  else {
+    seg = (CGSocketWriteQueueSegment*)malloc(sizeof(CGSocketWriteQueueSegment) + capacity);
+    if (!seg)
+      return NULL;
+    seg->data = (byte*)(seg + 1);
+    seg->capacity = capacity;
+  }
+
+  seg->next = NULL;
+  seg->offset = 0;
+  seg->len = 0;
+
+  return seg;
+}
+
+/****************************************
+ * cg_socket_write_queue_segment_delete
+ ****************************************/
+
+static void cg_socket_write_queue_segment_delete(CGSocketWriteQueue* queue, CGSocketWriteQueueSegment* seg)
+{
+  if ((seg->capacity == CG_NET_SOCKET_WRITE_QUEUE_SEGMENT_SIZE) && (queue->spareCnt < CG_NET_SOCKET_WRITE_QUEUE_SPARE_MAX)) {
+    seg->next = queue->spares;
+    queue->spares = seg;
+    queue->spareCnt++;
+    return;
+  }
+
+  free(seg);
+}
+
+/****************************************
+ * cg_socket_write_queue_new
+ ****************************************/
+
+CGSocketWriteQueue* cg_socket_write_queue_new(CGSocket* sock)
+{
+  CGSocketWriteQueue* queue;
+
+  if (!sock)
+    return NULL;
+
+  queue = (CGSocketWriteQueue*)malloc(sizeof(CGSocketWriteQueue));
+  if (!queue)
+    return NULL;
+
+  queue->sock = sock;
+  queue->head = NULL;
+  queue->tail = NULL;
+  queue->spares = NULL;
+  queue->spareCnt = 0;
+  queue->size = 0;
+  queue->lowWatermark = CG_NET_SOCKET_WRITE_QUEUE_DEFAULT_LOW_WATERMARK;
+  queue->highWatermark = CG_NET_SOCKET_WRITE_QUEUE_DEFAULT_HIGH_WATERMARK;
+  queue->isHigh = false;
+  queue->sslRetryLen = 0;
+  queue->listener = NULL;
+  queue->userData = NULL;
+
+  return queue;
+}
+
+/****************************************
+ * cg_socket_write_queue_delete
+ ****************************************/
+
+void cg_socket_write_queue_delete(CGSocketWriteQueue* queue)
+{
+  CGSocketWriteQueueSegment* seg;
+
+  if (!queue)
+    return;
+
+  cg_socket_write_queue_clear(queue);
+
+  while (queue->spares) {
+    seg = queue->spares;
+    queue->spares = seg->next;
+    free(seg);
+  }
+
+  free(queue);
+}
+
+/****************************************
+ * cg_socket_write_queue_clear
+ ****************************************/
+
+void cg_socket_write_queue_clear(CGSocketWriteQueue* queue)
+{
+  CGSocketWriteQueueSegment* seg;
+
+  if (!queue)
+    return;
+
+  while (queue->head) {
+    seg = queue->head;
+    queue->head = seg->next;
+    cg_socket_write_queue_segment_delete(queue, seg);
+  }
+
+  queue->tail = NULL;
+  queue->size = 0;
+  queue->isHigh = false;
+  queue->sslRetryLen = 0;
+}
+
+/****************************************
+ * cg_socket_write_queue_setwatermarks
+ ****************************************/
+
+bool cg_socket_write_queue_setwatermarks(CGSocketWriteQueue* queue, size_t lowWatermark, size_t highWatermark)
+{
+  if (!queue || (highWatermark < lowWatermark))
+    return false;
+
+  queue->lowWatermark = lowWatermark;
+  queue->highWatermark = highWatermark;
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_write_queue_enqueue
+ ****************************************/
+
+bool cg_socket_write_queue_enqueue(CGSocketWriteQueue* queue, const byte* data, size_t dataLen)
+{
+  CGSocketWriteQueueSegment* seg;
+  size_t copyLen;
+
+  if (!queue || !data)
+    return false;
+
+  if (dataLen <= 0)
+    return true;
+
+  /* Coalesce into the free room of the tail segment first */
+  seg = queue->tail;
+  if (seg && (seg->len < seg->capacity)) {
+    copyLen = seg->capacity - seg->len;
+    if (dataLen < copyLen)
+      copyLen = dataLen;
+    memcpy(seg->data + seg->len, data, copyLen);
+    seg->len += copyLen;
+    queue->size += copyLen;
+    data += copyLen;
+    dataLen -= copyLen;
+  }
+
+  if (0 < dataLen) {
+    seg = cg_socket_write_queue_segment_new(queue, dataLen);
+    if (!seg)
+      return false;
+    memcpy(seg->data, data, dataLen);
+    seg->len = dataLen;
+    if (queue->tail)
+      queue->tail->next = seg;
+    else
+      queue->head = seg;
+    queue->tail = seg;
+    queue->size += dataLen;
+  }
+
+  if (!queue->isHigh && (queue->highWatermark < queue->size)) {
+    queue->isHigh = true;
+    if (queue->listener)
+      queue->listener(queue, true);
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_write_queue_sslsend
+ ****************************************/
+
+#if defined(CG_USE_OPENSSL)
+static ssize_t cg_socket_write_queue_sslsend(CGSocketWriteQueue* queue)
+{
+  CGSocketWriteQueueSegment* seg;
+  size_t sslLen;
+  int ret;
+
+  seg = queue->head;
+
+  /* The tail may have grown into the head segment, but a retry must not change the length */
+  sslLen = (0 < queue->sslRetryLen) ? queue->sslRetryLen : (seg->len - seg->offset);
+
+  ret = SSL_write(queue->sock->ssl, seg->data + seg->offset, (int)sslLen);
+  if (0 < ret) {
+    queue->sslRetryLen = 0;
+    return ret;
+  }
+
+  switch (SSL_get_error(queue->sock->ssl, ret)) {
+  case SSL_ERROR_WANT_READ:
+  case SSL_ERROR_WANT_WRITE:
+    queue->sslRetryLen = sslLen;
+#if defined(WIN32)
+    WSASetLastError(WSAEWOULDBLOCK);
+#else
+    errno = EAGAIN;
+#endif
+    break;
+  default:
+#if !defined(WIN32)
+    /* Any other failure must not look like a full socket to the flush */
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+      errno = EIO;
+#endif
+    break;
+  }
+
+  return -1;
+}
+#endif
+
+/****************************************
+ * cg_socket_write_queue_send
+ ****************************************/
+
+static ssize_t cg_socket_write_queue_send(CGSocketWriteQueue* queue)
+{
+  CGSocket* sock;
+  CGSocketWriteQueueSegment* seg;
+#if !defined(WIN32)
+  struct iovec iov[CG_NET_SOCKET_WRITE_QUEUE_IOV_MAX];
+  struct msghdr msg;
+  int iovCnt;
+#endif
+
+  sock = queue->sock;
+  seg = queue->head;
+
+#if defined(CG_USE_OPENSSL)
+  if (cg_socket_isssl(sock) == true)
+    return cg_socket_write_queue_sslsend(queue);
+#endif
+
+#if defined(WIN32)
+  return send(sock->id, (const char*)(seg->data + seg->offset), (int)(seg->len - seg->offset), 0);
+#else
+  for (iovCnt = 0; seg && (iovCnt < CG_NET_SOCKET_WRITE_QUEUE_IOV_MAX); seg = seg->next, iovCnt++) {
+    iov[iovCnt].iov_base = seg->data + seg->offset;
+    iov[iovCnt].iov_len = seg->len - seg->offset;
+  }
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = iovCnt;
+
+  return sendmsg(sock->id, &msg, CG_NET_SOCKET_WRITE_QUEUE_SEND_FLAGS);
+#endif
+}
+
+/****************************************
+ * cg_socket_write_queue_flush
+ ****************************************/
+
+ssize_t cg_socket_write_queue_flush(CGSocketWriteQueue* queue)
+{
+  CGSocketWriteQueueSegment* seg;
+  ssize_t sentLen;
+  size_t totalSentLen;
+  size_t segLen;
+
+  if (!queue)
+    return -1;
+
+  totalSentLen = 0;
+
+  while (queue->head) {
+    sentLen = cg_socket_write_queue_send(queue);
+    cg_socket_stats_inc(queue->sock, writeCnt);
+
+    if (sentLen <= 0) {
+#if defined(WIN32)
+      if ((sentLen < 0) && (WSAGetLastError() == WSAEWOULDBLOCK))
+        break;
+#else
+      if ((sentLen < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)))
+        break;
+#endif
+      cg_socket_stats_inc(queue->sock, writeErrors);
+      return -1;
+    }
+
+    cg_socket_stats_add(queue->sock, writeBytes, sentLen);
+    totalSentLen += sentLen;
+    queue->size -= sentLen;
+
+    while (0 < sentLen) {
+      seg = queue->head;
+      segLen = seg->len - seg->offset;
+      if ((size_t)sentLen < segLen) {
+        seg->offset += sentLen;
+        cg_socket_stats_inc(queue->sock, writeShortCnt);
+        break;
+      }
+      sentLen -= segLen;
+      queue->head = seg->next;
+      if (!queue->head)
+        queue->tail = NULL;
+      cg_socket_write_queue_segment_delete(queue, seg);
+    }
+
+    /* A partial send means that the socket buffer is full */
+    if (queue->head && (0 < queue->head->offset))
+      break;
+  }
+
+  if (queue->isHigh && (queue->size <= queue->lowWatermark)) {
+    queue->isHigh = false;
+    if (queue->listener)
+      queue->listener(queue, false);
+  }
+
+  return (ssize_t)totalSentLen;
+}
@@ -0,0 +1,280 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <errno.h>
+#include <string.h>
+
+#include <cgpr/net/_socket.h>
+#include <cgpr/util/time.h>
+
+#if !defined(WIN32)
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define CG_NET_SOCKET_ZEROCOPY_SUPPORTED 1
+#endif
+
+#define CG_NET_SOCKET_ZEROCOPY_CONTROL_BUFSIZE 128
+#define CG_NET_SOCKET_ZEROCOPY_ID_RANGE 0x100000000ULL
+
+/****************************************
+ * cg_socket_setzerocopy
+ ****************************************/
+
+bool cg_socket_setzerocopy(CGSocket* sock, bool flag, size_t threshold)
+{
+  if (!sock || !cg_socket_issocketstream(sock))
+    return false;
+
+#if !defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  if (flag)
+    return false;
+#endif
+
+  sock->zerocopy.enabled = flag;
+  sock->zerocopy.threshold = (0 < threshold) ? threshold : CG_NET_SOCKET_ZEROCOPY_DEFAULT_THRESHOLD;
+
+  if (!flag || !cg_socket_isbound(sock))
+    return true;
+
+  if (!cg_socket_zerocopy_apply(sock)) {
+    sock->zerocopy.enabled = false;
+    return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_socket_zerocopy_apply
+ ****************************************/
+
+bool cg_socket_zerocopy_apply(CGSocket* sock)
+{
+#if defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  int optval = 1;
+  return (setsockopt(sock->id, SOL_SOCKET, SO_ZEROCOPY, (const char*)&optval, sizeof(optval)) == 0) ? true : false;
+#else
+  return false;
+#endif
+}
+
+/****************************************
+ * cg_socket_writezerocopy
+ ****************************************/
+
+size_t cg_socket_writezerocopy(CGSocket* sock, const byte* data, size_t dataLen, uint64_t* sendId)
+{
+#if defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  ssize_t nSent;
+  size_t nTotalSent;
+  int retryCnt;
+#endif
+
+  if (sendId)
+    *sendId = 0;
+
+  if (!sock || !data || (dataLen <= 0))
+    return 0;
+
+#if !defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  return cg_socket_write(sock, (const char*)data, dataLen);
+#else
+#if defined(CG_USE_OPENSSL)
+  if (!cg_socket_iszerocopy(sock) || (dataLen < sock->zerocopy.threshold) || cg_socket_isssl(sock))
+#else
+  if (!cg_socket_iszerocopy(sock) || (dataLen < sock->zerocopy.threshold))
+#endif
+    return cg_socket_write(sock, (const char*)data, dataLen);
+
+  nTotalSent = 0;
+  retryCnt = 0;
+
+  while (nTotalSent < dataLen) {
+    nSent = send(sock->id, data + nTotalSent, dataLen - nTotalSent, MSG_ZEROCOPY | MSG_NOSIGNAL);
+    if ((nSent < 0) && (errno == ENOBUFS)) {
+      /* The pinned page budget (optmem) is exhausted, so this part is copied */
+      nSent = send(sock->id, data + nTotalSent, dataLen - nTotalSent, MSG_NOSIGNAL);
+    }
+    else if (0 < nSent) {
+      sock->zerocopy.sentCnt++;
+      if (sendId)
+        *sendId = sock->zerocopy.sentCnt;
+      cg_socket_stats_inc(sock, zerocopyCnt);
+    }
+
+    cg_socket_stats_inc(sock, writeCnt);
+
+    if (nSent <= 0) {
+      retryCnt++;
+      if (CG_NET_SOCKET_SEND_RETRY_CNT < retryCnt) {
+        cg_socket_stats_inc(sock, writeErrors);
+        break;
+      }
+      cg_socket_stats_inc(sock, writeRetryCnt);
+      cg_wait(CG_NET_SOCKET_SEND_RETRY_WAIT_MSEC);
+      continue;
+    }
+
+    cg_socket_stats_add(sock, writeBytes, nSent);
+    if ((size_t)nSent < (dataLen - nTotalSent))
+      cg_socket_stats_inc(sock, writeShortCnt);
+    nTotalSent += nSent;
+    retryCnt = 0;
+  }
+
+  return nTotalSent;
+#endif
+}
+
+/****************************************
+ * cg_socket_zerocopy_toid
+ ****************************************/
+
+#if defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+static uint64_t cg_socket_zerocopy_toid(CGSocket* sock, uint32_t kernelId)
+{
+  uint64_t lastId;
+  uint64_t id;
+
+  /* The kernel numbers zero-copy sends from 0 in 32 bits, so the latest wrap is restored from sentCnt */
+  lastId = sock->zerocopy.sentCnt - 1;
+  id = (lastId & ~(CG_NET_SOCKET_ZEROCOPY_ID_RANGE - 1)) | kernelId;
+  if (lastId < id)
+    id -= CG_NET_SOCKET_ZEROCOPY_ID_RANGE;
+
+  return id + 1;
+}
+#endif
+
+/****************************************
+ * cg_socket_readzerocopycompletions
+ ****************************************/
+
+size_t cg_socket_readzerocopycompletions(CGSocket* sock)
+{
+#if defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  struct msghdr msg;
+  struct cmsghdr* cmsg;
+  struct sock_extended_err* serr;
+  char control[CG_NET_SOCKET_ZEROCOPY_CONTROL_BUFSIZE];
+  uint64_t completedCnt;
+  size_t notifiedCnt;
+
+  if (!sock || !cg_socket_isbound(sock) || (sock->zerocopy.sentCnt <= sock->zerocopy.completedCnt))
+    return 0;
+
+  notifiedCnt = 0;
+
+  while (true) {
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(sock->id, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+      break;
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR)) && !((cmsg->cmsg_level == SOL_IPV6) && (cmsg->cmsg_type == IPV6_RECVERR)))
+        continue;
+      serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+      if ((serr->ee_errno != 0) || (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY))
+        continue;
+      /* A notification covers the inclusive range [ee_info, ee_data]; TCP completes them in order */
+      if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+        cg_socket_stats_add(sock, zerocopyCopiedCnt, (uint32_t)(serr->ee_data - serr->ee_info) + 1);
+      completedCnt = cg_socket_zerocopy_toid(sock, serr->ee_data);
+      if (sock->zerocopy.completedCnt < completedCnt)
+        sock->zerocopy.completedCnt = completedCnt;
+      notifiedCnt++;
+    }
+  }
+
+  return notifiedCnt;
+#else
+  return 0;
+#endif
+}
+
+/****************************************
+ * cg_socket_iszerocopycompleted
+ ****************************************/
+
+bool cg_socket_iszerocopycompleted(CGSocket* sock, uint64_t sendId)
+{
+  if (!sock)
+    return false;
+
+  if (sendId <= sock->zerocopy.completedCnt)
+    return true;
+
+  cg_socket_readzerocopycompletions(sock);
+
+  return (sendId <= sock->zerocopy.completedCnt) ? true : false;
+}
+
+/****************************************
+ * cg_socket_waitzerocopy
+ ****************************************/
+
+bool cg_socket_waitzerocopy(CGSocket* sock, uint64_t sendId, clock_t timeout)
+{
+#if defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  struct pollfd pfd;
+  uint64_t deadline;
+  uint64_t now;
+#endif
+
+  if (!sock)
+    return false;
+
+  if (cg_socket_iszerocopycompleted(sock, sendId))
+    return true;
+
+#if defined(CG_NET_SOCKET_ZEROCOPY_SUPPORTED)
+  deadline = cg_getmonotonicnanotime() + ((uint64_t)timeout * 1000000ULL);
+
+  /* A pending error queue is reported as POLLERR without requesting any event */
+  pfd.fd = sock->id;
+  pfd.events = 0;
+  while (!cg_socket_iszerocopycompleted(sock, sendId)) {
+    now = cg_getmonotonicnanotime();
+    if (deadline <= now)
+      return false;
+    pfd.revents = 0;
+    if ((poll(&pfd, 1, (int)((deadline - now + 999999ULL) / 1000000ULL)) < 0) && (errno != EINTR))
+      return false;
+    if (pfd.revents & POLLNVAL)
+      return false;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,467 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <string.h>
+
+#include <cgpr/net/_socket.h>
+#include <cgpr/net/stream_server.h>
+#include <cgpr/util/time.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_STREAM_SERVER_POLL_INTERVAL 100
+#define CG_STREAM_SERVER_BUSY_WAIT 1
+#define CG_STREAM_SERVER_STOP_WAIT 10
+#define CG_STREAM_SERVER_READY_BUFSIZE 64
+
+/****************************************
+ * cg_stream_server_new
+ ****************************************/
+
+CGStreamServer* cg_stream_server_new(void)
+{
+  CGStreamServer* server;
+
+  server = (CGStreamServer*)malloc(sizeof(CGStreamServer));
+  if (!server)
+    return NULL;
+
+  server->mutex = cg_mutex_new();
+  if (!server->mutex) {
+    free(server);
+    return NULL;
+  }
+
+  server->sock = NULL;
+  server->queue = NULL;
+  server->queueHead = 0;
+  server->queueCnt = 0;
+  server->queueCapacity = CG_STREAM_SERVER_DEFAULT_QUEUE_CAPACITY;
+  server->spareSocks = NULL;
+  server->spareCnt = 0;
+  server->acceptBatch = CG_STREAM_SERVER_DEFAULT_ACCEPT_BATCH;
+  server->readyPipe[0] = -1;
+  server->readyPipe[1] = -1;
+  server->acceptThread = NULL;
+  server->workers = NULL;
+  server->workerCnt = CG_STREAM_SERVER_DEFAULT_WORKERS;
+  server->listener = NULL;
+  server->userData = NULL;
+
+  return server;
+}
+
+/****************************************
+ * cg_stream_server_delete
+ ****************************************/
+
+void cg_stream_server_delete(CGStreamServer* server)
+{
+  if (!server)
+    return;
+
+  cg_stream_server_close(server);
+  cg_mutex_delete(server->mutex);
+  free(server);
+}
+
+/****************************************
+ * cg_stream_server_open
+ ****************************************/
+
+bool cg_stream_server_open(CGStreamServer* server, int port, const char* addr)
+{
+  CGSocketOption* opt;
+  CGSocket* sock;
+  bool isOpened;
+
+  if (!server || server->sock)
+    return false;
+
+  opt = cg_socket_option_new();
+  if (!opt)
+    return false;
+  cg_socket_option_setbindinterface(opt, (0 < cg_strlen(addr)) ? true : false);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  sock = cg_socket_stream_new();
+  isOpened = (sock && cg_socket_bind(sock, port, addr, opt) && cg_socket_listen(sock) && cg_socket_setnonblocking(sock, true)) ? true : false;
+  cg_socket_option_delete(opt);
+
+  if (!isOpened) {
+    cg_socket_delete(sock);
+    return false;
+  }
+
+  server->sock = sock;
+
+  return true;
+}
+
+/****************************************
+ * cg_stream_server_close
+ ****************************************/
+
+bool cg_stream_server_close(CGStreamServer* server)
+{
+  if (!server)
+    return false;
+
+  cg_stream_server_stop(server);
+
+  if (server->sock) {
+    cg_socket_delete(server->sock);
+    server->sock = NULL;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_stream_server_hasroom
+ ****************************************/
+
+static bool cg_stream_server_hasroom(CGStreamServer* server)
+{
+  bool hasRoom;
+
+  cg_mutex_lock(server->mutex);
+  hasRoom = (server->queueCnt < server->queueCapacity) ? true : false;
+  cg_mutex_unlock(server->mutex);
+
+  return hasRoom;
+}
+
+/****************************************
+ * cg_stream_server_fillspares
+ ****************************************/
+
+static void cg_stream_server_fillspares(CGStreamServer* server)
+{
+  CGSocket* sock;
+
+  while (server->spareCnt < server->acceptBatch) {
+    sock = cg_socket_stream_new();
+    if (!sock)
+      break;
+    server->spareSocks[server->spareCnt++] = sock;
+  }
+}
+
+/****************************************
+ * cg_stream_server_acceptconnections
+ ****************************************/
+
+static size_t cg_stream_server_acceptconnections(CGStreamServer* server)
+{
+  size_t batchCnt;
+  size_t acceptedCnt;
+  size_t n;
+  ssize_t writtenLen;
+  char readyBytes[CG_STREAM_SERVER_READY_BUFSIZE];
+
+  cg_mutex_lock(server->mutex);
+  batchCnt = server->queueCapacity - server->queueCnt;
+  cg_mutex_unlock(server->mutex);
+
+  if (server->spareCnt < batchCnt)
+    batchCnt = server->spareCnt;
+
+  acceptedCnt = cg_socket_acceptbatch(server->sock, server->spareSocks, batchCnt);
+  if (acceptedCnt <= 0)
+    return 0;
+
+  cg_mutex_lock(server->mutex);
+  for (n = 0; n < acceptedCnt; n++) {
+    server->queue[(server->queueHead + server->queueCnt) % server->queueCapacity] = server->spareSocks[n];
+    server->queueCnt++;
+  }
+  cg_mutex_unlock(server->mutex);
+
+  server->spareCnt -= acceptedCnt;
+  memmove(server->spareSocks, server->spareSocks + acceptedCnt, server->spareCnt * sizeof(CGSocket*));
+
+  /* One byte per queued connection wakes exactly one worker */
+  memset(readyBytes, 0, sizeof(readyBytes));
+  for (n = 0; n < acceptedCnt; n += (size_t)writtenLen) {
+    writtenLen = write(server->readyPipe[1], readyBytes, ((acceptedCnt - n) < sizeof(readyBytes)) ? (acceptedCnt - n) : sizeof(readyBytes));
+    if (writtenLen <= 0)
+      break;
+  }
+
+  cg_stream_server_fillspares(server);
+
+  return acceptedCnt;
+}
+
+/****************************************
+ * cg_stream_server_popconnection
+ ****************************************/
+
+static CGSocket* cg_stream_server_popconnection(CGStreamServer* server)
+{
+  CGSocket* sock;
+
+  cg_mutex_lock(server->mutex);
+  sock = NULL;
+  if (0 < server->queueCnt) {
+    sock = server->queue[server->queueHead];
+    server->queueHead = (server->queueHead + 1) % server->queueCapacity;
+    server->queueCnt--;
+  }
+  cg_mutex_unlock(server->mutex);
+
+  return sock;
+}
+
+/****************************************
+ * cg_stream_server_acceptaction
+ ****************************************/
+
+static void cg_stream_server_acceptaction(CGThread* thread)
+{
+  CGStreamServer* server;
+  struct pollfd pfds[2];
+
+  server = (CGStreamServer*)cg_thread_getuserdata(thread);
+
+  pfds[0].fd = cg_socket_getid(server->sock);
+  pfds[0].events = POLLIN;
+  pfds[1].fd = cg_thread_getstopfd(thread);
+  pfds[1].events = POLLIN;
+
+  while (cg_thread_isrunnable(thread)) {
+    /* Connections stay in the kernel backlog until the workers catch up */
+    if (!cg_stream_server_hasroom(server)) {
+      cg_thread_waitstop(thread, CG_STREAM_SERVER_BUSY_WAIT);
+      continue;
+    }
+    pfds[0].revents = pfds[1].revents = 0;
+    if (poll(pfds, 2, CG_STREAM_SERVER_POLL_INTERVAL) <= 0)
+      continue;
+    if (pfds[0].revents)
+      cg_stream_server_acceptconnections(server);
+  }
+}
+
+/****************************************
+ * cg_stream_server_workeraction
+ ****************************************/
+
+static void cg_stream_server_workeraction(CGThread* thread)
+{
+  CGStreamServer* server;
+  CGSocket* clientSock;
+  struct pollfd pfds[2];
+  char readyByte;
+
+  server = (CGStreamServer*)cg_thread_getuserdata(thread);
+
+  /* The ready pipe is non-blocking, every worker is woken but only one gets the byte */
+  pfds[0].fd = server->readyPipe[0];
+  pfds[0].events = POLLIN;
+  pfds[1].fd = cg_thread_getstopfd(thread);
+  pfds[1].events = POLLIN;
+
+  while (cg_thread_isrunnable(thread)) {
+    pfds[0].revents = pfds[1].revents = 0;
+    if (poll(pfds, 2, CG_STREAM_SERVER_POLL_INTERVAL) <= 0)
+      continue;
+    if (read(server->readyPipe[0], &readyByte, 1) != 1)
+      continue;
+    clientSock = cg_stream_server_popconnection(server);
+    if (!clientSock)
+      continue;
+    if (server->listener)
+      server->listener(server, clientSock);
+    cg_socket_delete(clientSock);
+  }
+}
+
+/****************************************
+ * cg_stream_server_openreadypipe
+ ****************************************/
+
+static bool cg_stream_server_openreadypipe(CGStreamServer* server)
+{
+#if !defined(__linux__)
+  size_t n;
+#endif
+
+#if defined(__linux__)
+  return (pipe2(server->readyPipe, O_CLOEXEC | O_NONBLOCK) == 0) ? true : false;
+#else
+  if (pipe(server->readyPipe) != 0)
+    return false;
+  for (n = 0; n < 2; n++) {
+    fcntl(server->readyPipe[n], F_SETFD, FD_CLOEXEC);
+    fcntl(server->readyPipe[n], F_SETFL, fcntl(server->readyPipe[n], F_GETFL, 0) | O_NONBLOCK);
+  }
+  return true;
+#endif
+}
+
+/****************************************
+ * cg_stream_server_startthread
+ ****************************************/
+
+static CGThread* cg_stream_server_startthread(CGStreamServer* server, CG_THREAD_FUNC action)
+{
+  CGThread* thread;
+
+  thread = cg_thread_new();
+  if (!thread)
+    return NULL;
+
+  cg_thread_setaction(thread, action);
+  cg_thread_setuserdata(thread, server);
+  cg_thread_setjoinable(thread, true);
+
+  if (!cg_thread_start(thread)) {
+    cg_thread_delete(thread);
+    return NULL;
+  }
+
+  return thread;
+}
+
+/****************************************
+ * cg_stream_server_start
+ ****************************************/
+
+bool cg_stream_server_start(CGStreamServer* server)
+{
+  size_t n;
+
+  if (!server || !server->sock || !server->listener)
+    return false;
+
+  if (server->acceptThread)
+    return true;
+
+  if ((server->workerCnt <= 0) || (server->queueCapacity <= 0) || (server->acceptBatch <= 0))
+    return false;
+
+  server->queue = (CGSocket**)malloc(server->queueCapacity * sizeof(CGSocket*));
+  server->spareSocks = (CGSocket**)malloc(server->acceptBatch * sizeof(CGSocket*));
+  server->workers = (CGThread**)calloc(server->workerCnt, sizeof(CGThread*));
+  if (!server->queue || !server->spareSocks || !server->workers || !cg_stream_server_openreadypipe(server)) {
+    cg_stream_server_stop(server);
+    return false;
+  }
+
+  server->queueHead = 0;
+  server->queueCnt = 0;
+  cg_stream_server_fillspares(server);
+
+  for (n = 0; n < server->workerCnt; n++) {
+    server->workers[n] = cg_stream_server_startthread(server, cg_stream_server_workeraction);
+    if (!server->workers[n]) {
+      cg_stream_server_stop(server);
+      return false;
+    }
+  }
+
+  server->acceptThread = cg_stream_server_startthread(server, cg_stream_server_acceptaction);
+  if (!server->acceptThread) {
+    cg_stream_server_stop(server);
+    return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_stream_server_stop
+ ****************************************/
+
+bool cg_stream_server_stop(CGStreamServer* server)
+{
+  CGSocket* sock;
+  size_t n;
+
+  if (!server)
+    return false;
+
+  /* Every thread is asked first, so the joins below overlap. The stop tokens wake the threads out of poll() */
+  if (server->acceptThread)
+    cg_thread_signalstop(server->acceptThread);
+  for (n = 0; server->workers && (n < server->workerCnt); n++) {
+    if (server->workers[n])
+      cg_thread_signalstop(server->workers[n]);
+  }
+
+  /* A worker may still be in the listener, so the joins have no deadline */
+  if (server->acceptThread) {
+    while (!cg_thread_join(server->acceptThread, CG_STREAM_SERVER_STOP_WAIT))
+      ;
+    cg_thread_delete(server->acceptThread);
+    server->acceptThread = NULL;
+  }
+
+  for (n = 0; server->workers && (n < server->workerCnt); n++) {
+    if (!server->workers[n])
+      continue;
+    while (!cg_thread_join(server->workers[n], CG_STREAM_SERVER_STOP_WAIT))
+      ;
+    cg_thread_delete(server->workers[n]);
+  }
+  free(server->workers);
+  server->workers = NULL;
+
+  while ((sock = server->queue ? cg_stream_server_popconnection(server) : NULL))
+    cg_socket_delete(sock);
+  free(server->queue);
+  server->queue = NULL;
+
+  for (n = 0; n < server->spareCnt; n++)
+    cg_socket_delete(server->spareSocks[n]);
+  free(server->spareSocks);
+  server->spareSocks = NULL;
+  server->spareCnt = 0;
+
+  for (n = 0; n < 2; n++) {
+    if (0 <= server->readyPipe[n])
+      close(server->readyPipe[n]);
+    server->readyPipe[n] = -1;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_stream_server_isrunning
+ ****************************************/
+
+bool cg_stream_server_isrunning(CGStreamServer* server)
+{
+  if (!server)
+    return false;
+
+  return server->acceptThread ? true : false;
+}
@@ -0,0 +1,258 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <cgpr/net/tcpinfo_sampler.h>
+#include <cgpr/util/time.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_TCPINFO_SAMPLER_INITIAL_CAPACITY 8
+
+/****************************************
+ * cg_tcpinfo_sampler_new
+ ****************************************/
+
+CGTcpInfoSampler* cg_tcpinfo_sampler_new(void)
+{
+  CGTcpInfoSampler* sampler;
+
+  sampler = (CGTcpInfoSampler*)malloc(sizeof(CGTcpInfoSampler));
+  if (!sampler)
+    return NULL;
+
+  sampler->mutex = cg_mutex_new();
+  if (!sampler->mutex) {
+    free(sampler);
+    return NULL;
+  }
+
+  sampler->socks = NULL;
+  sampler->sockCnt = 0;
+  sampler->sockCapacity = 0;
+  sampler->interval = CG_TCPINFO_SAMPLER_DEFAULT_INTERVAL;
+  sampler->listener = NULL;
+  sampler->userData = NULL;
+  sampler->thread = NULL;
+
+  return sampler;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_delete
+ ****************************************/
+
+void cg_tcpinfo_sampler_delete(CGTcpInfoSampler* sampler)
+{
+  if (!sampler)
+    return;
+
+  cg_tcpinfo_sampler_stop(sampler);
+  cg_mutex_delete(sampler->mutex);
+  free(sampler->socks);
+  free(sampler);
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_addsocket
+ ****************************************/
+
+bool cg_tcpinfo_sampler_addsocket(CGTcpInfoSampler* sampler, CGSocket* sock)
+{
+  CGSocket** socks;
+  size_t sockCapacity;
+  size_t n;
+
+  if (!sampler || !sock)
+    return false;
+
+  cg_mutex_lock(sampler->mutex);
+
+  for (n = 0; n < sampler->sockCnt; n++) {
+    if (sampler->socks[n] == sock) {
+      cg_mutex_unlock(sampler->mutex);
+      return true;
+    }
+  }
+
+  if (sampler->sockCapacity <= sampler->sockCnt) {
+    sockCapacity = (0 < sampler->sockCapacity) ? (sampler->sockCapacity * 2) : CG_TCPINFO_SAMPLER_INITIAL_CAPACITY;
+    socks = (CGSocket**)realloc(sampler->socks, sockCapacity * sizeof(CGSocket*));
+    if (!socks) {
+      cg_mutex_unlock(sampler->mutex);
+      return false;
+    }
+    sampler->socks = socks;
+    sampler->sockCapacity = sockCapacity;
+  }
+
+  sampler->socks[sampler->sockCnt++] = sock;
+
+  cg_mutex_unlock(sampler->mutex);
+
+  return true;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_removesocket
+ ****************************************/
+
+bool cg_tcpinfo_sampler_removesocket(CGTcpInfoSampler* sampler, CGSocket* sock)
+{
+  size_t n;
+
+  if (!sampler || !sock)
+    return false;
+
+  cg_mutex_lock(sampler->mutex);
+
+  for (n = 0; n < sampler->sockCnt; n++) {
+    if (sampler->socks[n] != sock)
+      continue;
+    sampler->socks[n] = sampler->socks[--sampler->sockCnt];
+    cg_mutex_unlock(sampler->mutex);
+    return true;
+  }
+
+  cg_mutex_unlock(sampler->mutex);
+
+  return false;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_size
+ ****************************************/
+
+size_t cg_tcpinfo_sampler_size(CGTcpInfoSampler* sampler)
+{
+  size_t sockCnt;
+
+  if (!sampler)
+    return 0;
+
+  cg_mutex_lock(sampler->mutex);
+  sockCnt = sampler->sockCnt;
+  cg_mutex_unlock(sampler->mutex);
+
+  return sockCnt;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_sample
+ ****************************************/
+
+size_t cg_tcpinfo_sampler_sample(CGTcpInfoSampler* sampler)
+{
+  CGSocketTcpInfo tcpInfo;
+  size_t sampledCnt;
+  size_t n;
+
+  if (!sampler)
+    return 0;
+
+  sampledCnt = 0;
+
+  /* The lock is held while the listener runs so that sockets can not be removed under it */
+  cg_mutex_lock(sampler->mutex);
+  for (n = 0; n < sampler->sockCnt; n++) {
+    if (!cg_socket_gettcpinfo(sampler->socks[n], &tcpInfo))
+      continue;
+    sampledCnt++;
+    if (sampler->listener)
+      sampler->listener(sampler, sampler->socks[n], &tcpInfo);
+  }
+  cg_mutex_unlock(sampler->mutex);
+
+  return sampledCnt;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_action
+ ****************************************/
+
+static void cg_tcpinfo_sampler_action(CGThread* thread)
+{
+  CGTcpInfoSampler* sampler;
+
+  sampler = (CGTcpInfoSampler*)cg_thread_getuserdata(thread);
+
+  while (cg_thread_isrunnable(thread)) {
+    cg_tcpinfo_sampler_sample(sampler);
+    cg_thread_waitstop(thread, sampler->interval);
+  }
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_start
+ ****************************************/
+
+bool cg_tcpinfo_sampler_start(CGTcpInfoSampler* sampler)
+{
+  if (!sampler)
+    return false;
+
+  if (sampler->thread)
+    return true;
+
+  sampler->thread = cg_thread_new();
+  if (!sampler->thread)
+    return false;
+
+  cg_thread_setaction(sampler->thread, cg_tcpinfo_sampler_action);
+  cg_thread_setuserdata(sampler->thread, sampler);
+
+  if (!cg_thread_start(sampler->thread)) {
+    cg_thread_delete(sampler->thread);
+    sampler->thread = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_stop
+ ****************************************/
+
+bool cg_tcpinfo_sampler_stop(CGTcpInfoSampler* sampler)
+{
+  if (!sampler)
+    return false;
+
+  if (!sampler->thread)
+    return true;
+
+  cg_thread_stop(sampler->thread);
+  cg_thread_delete(sampler->thread);
+  sampler->thread = NULL;
+
+  return true;
+}
+
+/****************************************
+ * cg_tcpinfo_sampler_isrunning
+ ****************************************/
+
+bool cg_tcpinfo_sampler_isrunning(CGTcpInfoSampler* sampler)
+{
+  if (!sampler)
+    return false;
+
+  return sampler->thread ? true : false;
+}
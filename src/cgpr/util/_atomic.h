@@ -0,0 +1,59 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef __CGPR_UTIL_ATOMIC_H_
+#define __CGPR_UTIL_ATOMIC_H_
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_ATOMIC_RELAXED __ATOMIC_RELAXED
+#define CG_ATOMIC_ACQUIRE __ATOMIC_ACQUIRE
+#define CG_ATOMIC_RELEASE __ATOMIC_RELEASE
+#define CG_ATOMIC_ACQ_REL __ATOMIC_ACQ_REL
+#define CG_ATOMIC_SEQ_CST __ATOMIC_SEQ_CST
+
+/****************************************
+ * Function
+ ****************************************/
+
+#define cg_atomic_load(ptr, order) __atomic_load_n(ptr, order)
+#define cg_atomic_store(ptr, val, order) __atomic_store_n(ptr, val, order)
+#define cg_atomic_exchange(ptr, val, order) __atomic_exchange_n(ptr, val, order)
+#define cg_atomic_fetchadd(ptr, val, order) __atomic_fetch_add(ptr, val, order)
+#define cg_atomic_fetchsub(ptr, val, order) __atomic_fetch_sub(ptr, val, order)
+#define cg_atomic_cas(ptr, expected, desired, order) __atomic_compare_exchange_n(ptr, expected, desired, false, order, CG_ATOMIC_RELAXED)
+#define cg_atomic_fence(order) __atomic_thread_fence(order)
+
+#define cg_atomic_inc(ptr) cg_atomic_fetchadd(ptr, 1, CG_ATOMIC_RELAXED)
+#define cg_atomic_add(ptr, val) cg_atomic_fetchadd(ptr, val, CG_ATOMIC_RELAXED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CGPR_UTIL_ATOMIC_H_
@@ -45,10 +45,23 @@ int cg_bytes_toint(byte* byteData, size_t byteSize)
 byte* cg_bytes_fromint(int val, size_t bytesSize)
 {
   byte* bytesData;
+
+  bytesData = malloc(bytesSize);
+  if (!bytesData)
+    return NULL;
+
+  return cg_bytes_setint(bytesData, val, bytesSize);
+}
+
+/****************************************
+ * cg_bytes_setint
+ ****************************************/
+
+byte* cg_bytes_setint(byte* bytesData, int val, size_t bytesSize)
+{
   int idx;
   int n;
 
-  bytesData = malloc(bytesSize);
   for (n = 0; n < (int)bytesSize; n++) {
     idx = ((int)bytesSize - 1) - n;
     bytesData[idx] = ((val >> (n * 8)) & 0xFF);
@@ -56,3 +69,45 @@ byte* cg_bytes_fromint(int val, size_t bytesSize)
 
   return bytesData;
 }
+
+/****************************************
+ * cg_bytes_setvarint
+ ****************************************/
+
+size_t cg_bytes_setvarint(byte* bytesData, uint64_t val)
+{
+  size_t n;
+
+  /* Unsigned LEB128, at most CG_BYTES_VARINT_MAXSIZE bytes */
+  n = 0;
+  while (0x80 <= val) {
+    bytesData[n++] = (byte)((val & 0x7F) | 0x80);
+    val >>= 7;
+  }
+  bytesData[n++] = (byte)val;
+
+  return n;
+}
+
+/****************************************
+ * cg_bytes_getvarint
+ ****************************************/
+
+size_t cg_bytes_getvarint(const byte* bytesData, size_t bytesSize, uint64_t* val)
+{
+  uint64_t varVal;
+  size_t n;
+
+  varVal = 0;
+  for (n = 0; (n < bytesSize) && (n < CG_BYTES_VARINT_MAXSIZE); n++) {
+    varVal |= (uint64_t)(bytesData[n] & 0x7F) << (n * 7);
+    if ((bytesData[n] & 0x80) == 0) {
+      if (val)
+        *val = varVal;
+      return n + 1;
+    }
+  }
+
+  /* Incomplete or longer than CG_BYTES_VARINT_MAXSIZE */
+  return 0;
+}
@@ -110,3 +110,19 @@ bool cg_cond_signal(CGCond* cond)
 
   return true;
 }
+
+/****************************************
+ * cg_cond_broadcast
+ ****************************************/
+
+bool cg_cond_broadcast(CGCond* cond)
+{
+  if (!cond)
+    return false;
+
+  pthread_mutex_lock(&cond->mutexId);
+  pthread_cond_broadcast(&cond->condId);
+  pthread_mutex_unlock(&cond->mutexId);
+
+  return true;
+}
@@ -0,0 +1,472 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cgpr/util/cpu.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_LIBNUMA)
+#include <numa.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_CPU_SYSFS_PATH_MAXSIZE 128
+#define CG_CPU_SYSFS_LINE_MAXSIZE 4096
+#define CG_CPU_SYSFS_CPU_PATH "/sys/devices/system/cpu"
+#define CG_CPU_SYSFS_NODE_PATH "/sys/devices/system/node"
+#define CG_CPU_TOPOLOGY_INITIAL_CAPACITY 16
+
+/****************************************
+ * cg_cpuset_clear
+ ****************************************/
+
+void cg_cpuset_clear(CGCpuSet* cpuSet)
+{
+  if (!cpuSet)
+    return;
+
+  memset(cpuSet->bits, 0, sizeof(cpuSet->bits));
+}
+
+/****************************************
+ * cg_cpuset_add
+ ****************************************/
+
+bool cg_cpuset_add(CGCpuSet* cpuSet, int cpu)
+{
+  if (!cpuSet || (cpu < 0) || (CG_CPU_SET_MAXSIZE <= cpu))
+    return false;
+
+  cpuSet->bits[cpu / 64] |= ((uint64_t)1 << (cpu % 64));
+
+  return true;
+}
+
+/****************************************
+ * cg_cpuset_remove
+ ****************************************/
+
+bool cg_cpuset_remove(CGCpuSet* cpuSet, int cpu)
+{
+  if (!cpuSet || (cpu < 0) || (CG_CPU_SET_MAXSIZE <= cpu))
+    return false;
+
+  cpuSet->bits[cpu / 64] &= ~((uint64_t)1 << (cpu % 64));
+
+  return true;
+}
+
+/****************************************
+ * cg_cpuset_contains
+ ****************************************/
+
+bool cg_cpuset_contains(const CGCpuSet* cpuSet, int cpu)
+{
+  if (!cpuSet || (cpu < 0) || (CG_CPU_SET_MAXSIZE <= cpu))
+    return false;
+
+  return (cpuSet->bits[cpu / 64] & ((uint64_t)1 << (cpu % 64))) ? true : false;
+}
+
+/****************************************
+ * cg_cpuset_size
+ ****************************************/
+
+size_t cg_cpuset_size(const CGCpuSet* cpuSet)
+{
+  size_t cpuCnt;
+  uint64_t bits;
+  size_t n;
+
+  if (!cpuSet)
+    return 0;
+
+  cpuCnt = 0;
+  for (n = 0; n < (CG_CPU_SET_MAXSIZE / 64); n++) {
+    for (bits = cpuSet->bits[n]; bits; bits &= (bits - 1))
+      cpuCnt++;
+  }
+
+  return cpuCnt;
+}
+
+/****************************************
+ * cg_cpuset_parselist
+ ****************************************/
+
+bool cg_cpuset_parselist(CGCpuSet* cpuSet, const char* cpuList)
+{
+  const char* p;
+  char* endp;
+  long first;
+  long last;
+  long cpu;
+
+  if (!cpuSet || !cpuList)
+    return false;
+
+  p = cpuList;
+  while ((*p != '\0') && (*p != '\n')) {
+    first = strtol(p, &endp, 10);
+    if ((endp == p) || (first < 0))
+      return false;
+    last = first;
+    p = endp;
+    if (*p == '-') {
+      p++;
+      last = strtol(p, &endp, 10);
+      if ((endp == p) || (last < first))
+        return false;
+      p = endp;
+    }
+    for (cpu = first; (cpu <= last) && (cpu < CG_CPU_SET_MAXSIZE); cpu++)
+      cg_cpuset_add(cpuSet, (int)cpu);
+    if (*p == ',')
+      p++;
+    else if ((*p != '\0') && (*p != '\n'))
+      return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_cpu_readsysfs
+ ****************************************/
+
+#if defined(__linux__)
+static bool cg_cpu_readsysfs(const char* path, char* buf, size_t bufLen)
+{
+  FILE* fp;
+  bool isSuccess;
+
+  fp = fopen(path, "r");
+  if (!fp)
+    return false;
+  isSuccess = (fgets(buf, (int)bufLen, fp) != NULL) ? true : false;
+  fclose(fp);
+
+  return isSuccess;
+}
+
+/****************************************
+ * cg_cpu_readsysfsint
+ ****************************************/
+
+static int cg_cpu_readsysfsint(const char* path, int defaultValue)
+{
+  char buf[32];
+
+  if (!cg_cpu_readsysfs(path, buf, sizeof(buf)))
+    return defaultValue;
+
+  return atoi(buf);
+}
+
+/****************************************
+ * cg_cpu_readsysfslist
+ ****************************************/
+
+static bool cg_cpu_readsysfslist(const char* path, CGCpuSet* cpuSet)
+{
+  char* buf;
+  bool isSuccess;
+
+  buf = (char*)malloc(CG_CPU_SYSFS_LINE_MAXSIZE);
+  if (!buf)
+    return false;
+
+  cg_cpuset_clear(cpuSet);
+  isSuccess = cg_cpu_readsysfs(path, buf, CG_CPU_SYSFS_LINE_MAXSIZE) && cg_cpuset_parselist(cpuSet, buf);
+  free(buf);
+
+  return isSuccess;
+}
+#endif
+
+/****************************************
+ * cg_cpu_getonlinecount
+ ****************************************/
+
+size_t cg_cpu_getonlinecount(void)
+{
+#if defined(WIN32)
+  SYSTEM_INFO sysInfo;
+  GetSystemInfo(&sysInfo);
+  return (0 < sysInfo.dwNumberOfProcessors) ? (size_t)sysInfo.dwNumberOfProcessors : 1;
+#else
+  long cpuCnt = sysconf(_SC_NPROCESSORS_ONLN);
+  return (0 < cpuCnt) ? (size_t)cpuCnt : 1;
+#endif
+}
+
+/****************************************
+ * cg_cpu_getcurrent
+ ****************************************/
+
+int cg_cpu_getcurrent(void)
+{
+#if defined(WIN32)
+  return (int)GetCurrentProcessorNumber();
+#elif defined(__linux__)
+  return sched_getcpu();
+#else
+  return -1;
+#endif
+}
+
+/****************************************
+ * cg_cpu_getnodecpus
+ ****************************************/
+
+bool cg_cpu_getnodecpus(int node, CGCpuSet* cpuSet)
+{
+#if defined(HAVE_LIBNUMA)
+  struct bitmask* cpuMask;
+  unsigned int cpu;
+  bool isSuccess;
+#elif defined(__linux__)
+  char path[CG_CPU_SYSFS_PATH_MAXSIZE];
+#endif
+
+  if (!cpuSet || (node < 0))
+    return false;
+
+#if defined(HAVE_LIBNUMA)
+  if ((numa_available() < 0) || (numa_max_node() < node))
+    return false;
+  cpuMask = numa_allocate_cpumask();
+  if (!cpuMask)
+    return false;
+  cg_cpuset_clear(cpuSet);
+  isSuccess = (numa_node_to_cpus(node, cpuMask) == 0) ? true : false;
+  for (cpu = 0; isSuccess && (cpu < cpuMask->size) && (cpu < CG_CPU_SET_MAXSIZE); cpu++) {
+    if (numa_bitmask_isbitset(cpuMask, cpu))
+      cg_cpuset_add(cpuSet, (int)cpu);
+  }
+  numa_free_cpumask(cpuMask);
+  return isSuccess;
+#elif defined(__linux__)
+  snprintf(path, sizeof(path), CG_CPU_SYSFS_NODE_PATH "/node%d/cpulist", node);
+  return cg_cpu_readsysfslist(path, cpuSet);
+#else
+  return false;
+#endif
+}
+
+/****************************************
+ * cg_cpu_topology_new
+ ****************************************/
+
+CGCpuTopology* cg_cpu_topology_new(void)
+{
+  CGCpuTopology* topology;
+
+  topology = (CGCpuTopology*)calloc(1, sizeof(CGCpuTopology));
+  if (!topology)
+    return NULL;
+
+  if (!cg_cpu_topology_update(topology)) {
+    cg_cpu_topology_delete(topology);
+    return NULL;
+  }
+
+  return topology;
+}
+
+/****************************************
+ * cg_cpu_topology_delete
+ ****************************************/
+
+void cg_cpu_topology_delete(CGCpuTopology* topology)
+{
+  if (!topology)
+    return;
+
+  free(topology->cpus);
+  free(topology);
+}
+
+/****************************************
+ * cg_cpu_topology_addcpu
+ ****************************************/
+
+static bool cg_cpu_topology_addcpu(CGCpuTopology* topology, int cpu, int core, int package)
+{
+  CGCpuInfo* cpus;
+  size_t cpuCapacity;
+
+  if (topology->cpuCapacity <= topology->cpuCnt) {
+    cpuCapacity = (0 < topology->cpuCapacity) ? (topology->cpuCapacity * 2) : CG_CPU_TOPOLOGY_INITIAL_CAPACITY;
+    cpus = (CGCpuInfo*)realloc(topology->cpus, cpuCapacity * sizeof(CGCpuInfo));
+    if (!cpus)
+      return false;
+    topology->cpus = cpus;
+    topology->cpuCapacity = cpuCapacity;
+  }
+
+  topology->cpus[topology->cpuCnt].cpu = cpu;
+  topology->cpus[topology->cpuCnt].core = core;
+  topology->cpus[topology->cpuCnt].package = package;
+  topology->cpus[topology->cpuCnt].node = CG_CPU_NODE_NONE;
+  topology->cpuCnt++;
+
+  return true;
+}
+
+/****************************************
+ * cg_cpu_topology_isfirstcore
+ ****************************************/
+
+static bool cg_cpu_topology_isfirstcore(CGCpuTopology* topology, size_t idx)
+{
+  size_t n;
+
+  for (n = 0; n < idx; n++) {
+    if ((topology->cpus[n].package == topology->cpus[idx].package) && (topology->cpus[n].core == topology->cpus[idx].core))
+      return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_cpu_topology_isfirstpackage
+ ****************************************/
+
+static bool cg_cpu_topology_isfirstpackage(CGCpuTopology* topology, size_t idx)
+{
+  size_t n;
+
+  for (n = 0; n < idx; n++) {
+    if (topology->cpus[n].package == topology->cpus[idx].package)
+      return false;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_cpu_topology_update
+ ****************************************/
+
+bool cg_cpu_topology_update(CGCpuTopology* topology)
+{
+#if defined(__linux__)
+  char path[CG_CPU_SYSFS_PATH_MAXSIZE];
+  CGCpuSet onlineSet;
+  CGCpuSet nodeSet;
+  int node;
+  int core;
+#endif
+  size_t cpuCnt;
+  size_t n;
+  int cpu;
+
+  if (!topology)
+    return false;
+
+  topology->cpuCnt = 0;
+  topology->coreCnt = 0;
+  topology->packageCnt = 0;
+  topology->nodeCnt = 0;
+
+#if defined(__linux__)
+  if (!cg_cpu_readsysfslist(CG_CPU_SYSFS_CPU_PATH "/online", &onlineSet)) {
+    cg_cpuset_clear(&onlineSet);
+    cpuCnt = cg_cpu_getonlinecount();
+    for (cpu = 0; (size_t)cpu < cpuCnt; cpu++)
+      cg_cpuset_add(&onlineSet, cpu);
+  }
+
+  for (cpu = 0; cpu < CG_CPU_SET_MAXSIZE; cpu++) {
+    if (!cg_cpuset_contains(&onlineSet, cpu))
+      continue;
+    snprintf(path, sizeof(path), CG_CPU_SYSFS_CPU_PATH "/cpu%d/topology/core_id", cpu);
+    core = cg_cpu_readsysfsint(path, cpu);
+    snprintf(path, sizeof(path), CG_CPU_SYSFS_CPU_PATH "/cpu%d/topology/physical_package_id", cpu);
+    if (!cg_cpu_topology_addcpu(topology, cpu, core, cg_cpu_readsysfsint(path, 0)))
+      return false;
+  }
+
+  if (cg_cpu_readsysfslist(CG_CPU_SYSFS_NODE_PATH "/online", &onlineSet)) {
+    for (node = 0; node < CG_CPU_SET_MAXSIZE; node++) {
+      if (!cg_cpuset_contains(&onlineSet, node) || !cg_cpu_getnodecpus(node, &nodeSet))
+        continue;
+      for (n = 0; n < topology->cpuCnt; n++) {
+        if (cg_cpuset_contains(&nodeSet, topology->cpus[n].cpu))
+          topology->cpus[n].node = node;
+      }
+      topology->nodeCnt++;
+    }
+  }
+#else
+  cpuCnt = cg_cpu_getonlinecount();
+  for (cpu = 0; (size_t)cpu < cpuCnt; cpu++) {
+    if (!cg_cpu_topology_addcpu(topology, cpu, cpu, 0))
+      return false;
+  }
+#endif
+
+  for (n = 0; n < topology->cpuCnt; n++) {
+    if (cg_cpu_topology_isfirstcore(topology, n))
+      topology->coreCnt++;
+    if (cg_cpu_topology_isfirstpackage(topology, n))
+      topology->packageCnt++;
+  }
+
+  return (0 < topology->cpuCnt) ? true : false;
+}
+
+/****************************************
+ * cg_cpu_topology_getcorecpus
+ ****************************************/
+
+size_t cg_cpu_topology_getcorecpus(CGCpuTopology* topology, int* cpus, size_t cpuCnt)
+{
+  size_t coreCnt;
+  size_t n;
+
+  if (!topology || !cpus)
+    return 0;
+
+  coreCnt = 0;
+  for (n = 0; (n < topology->cpuCnt) && (coreCnt < cpuCnt); n++) {
+    if (cg_cpu_topology_isfirstcore(topology, n))
+      cpus[coreCnt++] = topology->cpus[n].cpu;
+  }
+
+  return coreCnt;
+}
@@ -0,0 +1,569 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
+#include <cgpr/util/fiber.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_FIBER_POLL_INITIAL_CAPACITY 16
+#define CG_FIBER_EPOLL_EVENT_CNT 64
+#define CG_FIBER_NSEC_PER_MSEC 1000000ULL
+
+#if !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/****************************************
+ * static variable
+ ****************************************/
+
+/* The scheduler running on the current thread */
+static __thread CGFiberScheduler* _gFiberScheduler = NULL;
+
+/****************************************
+ * cg_fiber_scheduler_new
+ ****************************************/
+
+CGFiberScheduler* cg_fiber_scheduler_new(void)
+{
+  CGFiberScheduler* scheduler;
+
+  scheduler = (CGFiberScheduler*)calloc(1, sizeof(CGFiberScheduler));
+  if (!scheduler)
+    return NULL;
+
+  cg_list_header_init(&scheduler->readyList);
+  cg_list_header_init(&scheduler->waitList);
+  scheduler->current = NULL;
+  scheduler->fiberCnt = 0;
+  scheduler->stackSize = CG_FIBER_DEFAULT_STACK_SIZE;
+
+#if defined(__linux__)
+  cg_list_header_init(&scheduler->ioWaitList);
+  scheduler->epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (scheduler->epollFd < 0) {
+    free(scheduler);
+    return NULL;
+  }
+#endif
+
+  return scheduler;
+}
+
+/****************************************
+ * cg_fiber_delete
+ ****************************************/
+
+static void cg_fiber_delete(CGFiber* fiber)
+{
+  cg_list_remove((CGList*)fiber);
+  fiber->scheduler->fiberCnt--;
+  munmap(fiber->stack, fiber->stackSize);
+  free(fiber);
+}
+
+/****************************************
+ * cg_fiber_scheduler_delete
+ ****************************************/
+
+void cg_fiber_scheduler_delete(CGFiberScheduler* scheduler)
+{
+  CGFiber* fiber;
+
+  if (!scheduler)
+    return;
+
+  /* Fibers which never finished are dropped with their stacks */
+  while ((fiber = (CGFiber*)cg_list_next(&scheduler->readyList)))
+    cg_fiber_delete(fiber);
+  while ((fiber = (CGFiber*)cg_list_next(&scheduler->waitList)))
+    cg_fiber_delete(fiber);
+
+#if defined(__linux__)
+  while ((fiber = (CGFiber*)cg_list_next(&scheduler->ioWaitList)))
+    cg_fiber_delete(fiber);
+  close(scheduler->epollFd);
+  free(scheduler->fds);
+#else
+  free(scheduler->pollFds);
+  free(scheduler->pollFibers);
+#endif
+  free(scheduler);
+}
+
+/****************************************
+ * cg_fiber_entry
+ ****************************************/
+
+static void cg_fiber_entry(void)
+{
+  CGFiber* fiber = _gFiberScheduler->current;
+
+  fiber->func(fiber);
+  fiber->finished = true;
+
+  /* Returning resumes the scheduler through uc_link */
+}
+
+/****************************************
+ * cg_fiber_initcontext
+ ****************************************/
+
+/* Kept apart from cg_fiber_new() so that no local of the caller is live across getcontext() */
+static bool cg_fiber_initcontext(CGFiber* fiber, ucontext_t* link, void* stack, size_t stackSize)
+{
+  if (getcontext(&fiber->context) != 0)
+    return false;
+
+  fiber->context.uc_stack.ss_sp = stack;
+  fiber->context.uc_stack.ss_size = stackSize;
+  fiber->context.uc_link = link;
+  makecontext(&fiber->context, cg_fiber_entry, 0);
+
+  return true;
+}
+
+/****************************************
+ * cg_fiber_new
+ ****************************************/
+
+CGFiber* cg_fiber_new(CGFiberScheduler* scheduler, CG_FIBER_FUNC func, void* userData)
+{
+  CGFiber* fiber;
+  size_t pageSize;
+  size_t stackSize;
+  void* stack;
+
+  if (!scheduler || !func)
+    return NULL;
+
+  pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  stackSize = ((scheduler->stackSize + pageSize - 1) / pageSize) * pageSize;
+
+  fiber = (CGFiber*)calloc(1, sizeof(CGFiber));
+  if (!fiber)
+    return NULL;
+
+  /* The lowest page stays unmapped so that a stack overflow faults instead of corrupting memory */
+  stack = mmap(NULL, stackSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (stack == MAP_FAILED) {
+    free(fiber);
+    return NULL;
+  }
+  if ((mprotect(stack, pageSize, PROT_NONE) != 0) || !cg_fiber_initcontext(fiber, &scheduler->context, (char*)stack + pageSize, stackSize)) {
+    munmap(stack, stackSize + pageSize);
+    free(fiber);
+    return NULL;
+  }
+
+  fiber->stack = stack;
+  fiber->stackSize = stackSize + pageSize;
+
+  cg_list_node_init((CGList*)fiber);
+  fiber->scheduler = scheduler;
+  fiber->func = func;
+  fiber->userData = userData;
+  fiber->waitFd = -1;
+  fiber->finished = false;
+
+  cg_list_add(&scheduler->readyList, (CGList*)fiber);
+  scheduler->fiberCnt++;
+
+  return fiber;
+}
+
+/****************************************
+ * cg_fiber_current
+ ****************************************/
+
+CGFiber* cg_fiber_current(void)
+{
+  return _gFiberScheduler ? _gFiberScheduler->current : NULL;
+}
+
+/****************************************
+ * cg_fiber_suspend
+ ****************************************/
+
+static void cg_fiber_suspend(CGFiber* fiber)
+{
+  swapcontext(&fiber->context, &fiber->scheduler->context);
+}
+
+/****************************************
+ * cg_fiber_yield
+ ****************************************/
+
+bool cg_fiber_yield(void)
+{
+  CGFiber* fiber;
+
+  fiber = cg_fiber_current();
+  if (!fiber)
+    return false;
+
+  cg_list_add(&fiber->scheduler->readyList, (CGList*)fiber);
+  cg_fiber_suspend(fiber);
+
+  return true;
+}
+
+#if defined(__linux__)
+/****************************************
+ * cg_fiber_scheduler_arm
+ ****************************************/
+
+static bool cg_fiber_scheduler_arm(CGFiberScheduler* scheduler, int fd)
+{
+  struct epoll_event event;
+  CGFiberFd* fdEntry;
+  CGFiber* fiber;
+
+  fdEntry = &scheduler->fds[fd];
+
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLONESHOT;
+  for (fiber = fdEntry->waiters; fiber; fiber = fiber->nextFdWaiter)
+    event.events |= (uint32_t)fiber->waitEvents;
+  event.data.fd = fd;
+
+  /* A closed descriptor leaves epoll silently, so a stale registration is added again */
+  if (fdEntry->registered && (epoll_ctl(scheduler->epollFd, EPOLL_CTL_MOD, fd, &event) == 0))
+    return true;
+  if ((epoll_ctl(scheduler->epollFd, EPOLL_CTL_ADD, fd, &event) != 0) && ((errno != EEXIST) || (epoll_ctl(scheduler->epollFd, EPOLL_CTL_MOD, fd, &event) != 0)))
+    return false;
+
+  fdEntry->registered = true;
+
+  return true;
+}
+
+/****************************************
+ * cg_fiber_scheduler_addfdwaiter
+ ****************************************/
+
+static bool cg_fiber_scheduler_addfdwaiter(CGFiberScheduler* scheduler, CGFiber* fiber)
+{
+  CGFiberFd* fds;
+  CGFiberFd* fdEntry;
+  size_t fdCapacity;
+  int fd;
+
+  fd = fiber->waitFd;
+  if (scheduler->fdCapacity <= (size_t)fd) {
+    fdCapacity = (0 < scheduler->fdCapacity) ? scheduler->fdCapacity : CG_FIBER_POLL_INITIAL_CAPACITY;
+    while (fdCapacity <= (size_t)fd)
+      fdCapacity *= 2;
+    fds = (CGFiberFd*)realloc(scheduler->fds, fdCapacity * sizeof(CGFiberFd));
+    if (!fds)
+      return false;
+    memset(fds + scheduler->fdCapacity, 0, (fdCapacity - scheduler->fdCapacity) * sizeof(CGFiberFd));
+    scheduler->fds = fds;
+    scheduler->fdCapacity = fdCapacity;
+  }
+
+  fdEntry = &scheduler->fds[fd];
+  fiber->nextFdWaiter = fdEntry->waiters;
+  fdEntry->waiters = fiber;
+  if (cg_fiber_scheduler_arm(scheduler, fd))
+    return true;
+
+  fdEntry->waiters = fiber->nextFdWaiter;
+
+  return false;
+}
+
+/****************************************
+ * cg_fiber_scheduler_removefdwaiter
+ ****************************************/
+
+static void cg_fiber_scheduler_removefdwaiter(CGFiberScheduler* scheduler, CGFiber* fiber)
+{
+  CGFiber** waiter;
+
+  /* The registration stays armed, an event for a descriptor nobody waits on is ignored */
+  for (waiter = &scheduler->fds[fiber->waitFd].waiters; *waiter; waiter = &(*waiter)->nextFdWaiter) {
+    if (*waiter == fiber) {
+      *waiter = fiber->nextFdWaiter;
+      break;
+    }
+  }
+}
+#endif
+
+/****************************************
+ * cg_fiber_waitfd
+ ****************************************/
+
+int cg_fiber_waitfd(int fd, int events, clock_t mtime)
+{
+  CGFiberScheduler* scheduler;
+  CGFiber* fiber;
+
+  fiber = cg_fiber_current();
+  if (!fiber)
+    return -1;
+
+  scheduler = fiber->scheduler;
+  fiber->waitFd = fd;
+  fiber->waitEvents = (short)events;
+  fiber->readyEvents = 0;
+  fiber->deadline = (mtime == CG_FIBER_WAIT_INFINITE) ? 0 : (cg_getmonotonicnanotime() + ((uint64_t)mtime * CG_FIBER_NSEC_PER_MSEC));
+
+#if defined(__linux__)
+  if ((0 <= fd) && !cg_fiber_scheduler_addfdwaiter(scheduler, fiber)) {
+    fiber->waitFd = -1;
+    /* epoll refuses regular files, which poll() reports as always ready */
+    return (errno == EPERM) ? events : -1;
+  }
+
+  /* Only waits with a deadline are scanned every round, the others are woken by epoll alone */
+  if ((0 <= fd) && (fiber->deadline == 0))
+    cg_list_add(&scheduler->ioWaitList, (CGList*)fiber);
+  else
+    cg_list_add(&scheduler->waitList, (CGList*)fiber);
+#else
+  cg_list_add(&scheduler->waitList, (CGList*)fiber);
+#endif
+  cg_fiber_suspend(fiber);
+
+  fiber->waitFd = -1;
+
+  return fiber->readyEvents;
+}
+
+/****************************************
+ * cg_fiber_sleep
+ ****************************************/
+
+bool cg_fiber_sleep(clock_t mtime)
+{
+  return (cg_fiber_waitfd(-1, 0, mtime) == 0) ? true : false;
+}
+
+/****************************************
+ * cg_fiber_scheduler_runready
+ ****************************************/
+
+static void cg_fiber_scheduler_runready(CGFiberScheduler* scheduler)
+{
+  CGFiber* lastFiber;
+  CGFiber* fiber;
+  bool isLast;
+
+  /* Only the fibers ready now run, one which yields again waits for the next round */
+  lastFiber = (CGFiber*)scheduler->readyList.prev;
+  if (lastFiber == (CGFiber*)&scheduler->readyList)
+    return;
+
+  do {
+    fiber = (CGFiber*)cg_list_next(&scheduler->readyList);
+    isLast = (fiber == lastFiber) ? true : false;
+    cg_list_remove((CGList*)fiber);
+    scheduler->current = fiber;
+    swapcontext(&scheduler->context, &fiber->context);
+    scheduler->current = NULL;
+    if (fiber->finished)
+      cg_fiber_delete(fiber);
+  } while (!isLast);
+}
+
+/****************************************
+ * cg_fiber_scheduler_wake
+ ****************************************/
+
+static void cg_fiber_scheduler_wake(CGFiberScheduler* scheduler, CGFiber* fiber, short readyEvents)
+{
+#if defined(__linux__)
+  if (0 <= fiber->waitFd)
+    cg_fiber_scheduler_removefdwaiter(scheduler, fiber);
+#endif
+
+  fiber->readyEvents = readyEvents;
+  cg_list_remove((CGList*)fiber);
+  cg_list_add(&scheduler->readyList, (CGList*)fiber);
+}
+
+/****************************************
+ * cg_fiber_scheduler_waitevents
+ ****************************************/
+
+#if defined(__linux__)
+static bool cg_fiber_scheduler_waitevents(CGFiberScheduler* scheduler, int timeout)
+{
+  struct epoll_event events[CG_FIBER_EPOLL_EVENT_CNT];
+  CGFiberFd* fdEntry;
+  CGFiber* fiber;
+  CGFiber* nextFiber;
+  int eventCnt;
+  int n;
+
+  /* Every fiber waits forever on nothing, so none of them can be resumed */
+  if ((timeout < 0) && !cg_list_next(&scheduler->ioWaitList))
+    return false;
+
+  /* Only an interrupted wait is retried, any other error would make the caller spin */
+  eventCnt = epoll_wait(scheduler->epollFd, events, CG_FIBER_EPOLL_EVENT_CNT, timeout);
+  if (eventCnt < 0)
+    return (errno == EINTR) ? true : false;
+
+  for (n = 0; n < eventCnt; n++) {
+    fdEntry = &scheduler->fds[events[n].data.fd];
+    for (fiber = fdEntry->waiters; fiber; fiber = nextFiber) {
+      nextFiber = fiber->nextFdWaiter;
+      if (events[n].events & ((uint32_t)fiber->waitEvents | EPOLLERR | EPOLLHUP))
+        cg_fiber_scheduler_wake(scheduler, fiber, (short)events[n].events);
+    }
+    /* The one-shot registration has fired, the remaining waiters need it again */
+    if (fdEntry->waiters && !cg_fiber_scheduler_arm(scheduler, events[n].data.fd))
+      return false;
+  }
+
+  return true;
+}
+#else
+static bool cg_fiber_scheduler_waitevents(CGFiberScheduler* scheduler, int timeout)
+{
+  struct pollfd* pollFds;
+  CGFiber** pollFibers;
+  CGFiber* fiber;
+  size_t pollCapacity;
+  size_t pollCnt;
+  size_t n;
+
+  pollCnt = 0;
+  for (fiber = (CGFiber*)cg_list_next(&scheduler->waitList); fiber; fiber = (CGFiber*)cg_list_next((CGList*)fiber)) {
+    if (fiber->waitFd < 0)
+      continue;
+    if (scheduler->pollCapacity <= pollCnt) {
+      pollCapacity = (0 < scheduler->pollCapacity) ? (scheduler->pollCapacity * 2) : CG_FIBER_POLL_INITIAL_CAPACITY;
+      pollFds = (struct pollfd*)realloc(scheduler->pollFds, pollCapacity * sizeof(struct pollfd));
+      if (!pollFds)
+        return false;
+      scheduler->pollFds = pollFds;
+      pollFibers = (CGFiber**)realloc(scheduler->pollFibers, pollCapacity * sizeof(CGFiber*));
+      if (!pollFibers)
+        return false;
+      scheduler->pollFibers = pollFibers;
+      scheduler->pollCapacity = pollCapacity;
+    }
+    scheduler->pollFds[pollCnt].fd = fiber->waitFd;
+    scheduler->pollFds[pollCnt].events = fiber->waitEvents;
+    scheduler->pollFds[pollCnt].revents = 0;
+    scheduler->pollFibers[pollCnt] = fiber;
+    pollCnt++;
+  }
+
+  /* Every fiber waits forever on nothing, so none of them can be resumed */
+  if ((pollCnt == 0) && (timeout < 0))
+    return false;
+
+  /* Only an interrupted poll is retried, any other error would make the caller spin */
+  if (poll(scheduler->pollFds, (nfds_t)pollCnt, timeout) < 0)
+    return (errno == EINTR) ? true : false;
+
+  for (n = 0; n < pollCnt; n++) {
+    if (scheduler->pollFds[n].revents != 0)
+      cg_fiber_scheduler_wake(scheduler, scheduler->pollFibers[n], scheduler->pollFds[n].revents);
+  }
+
+  return true;
+}
+#endif
+
+/****************************************
+ * cg_fiber_scheduler_poll
+ ****************************************/
+
+static bool cg_fiber_scheduler_poll(CGFiberScheduler* scheduler)
+{
+  CGFiber* fiber;
+  CGFiber* nextFiber;
+  uint64_t now;
+  int timeout;
+
+  now = cg_getmonotonicnanotime();
+  timeout = (cg_list_next(&scheduler->readyList) != NULL) ? 0 : -1;
+
+  for (fiber = (CGFiber*)cg_list_next(&scheduler->waitList); fiber; fiber = (CGFiber*)cg_list_next((CGList*)fiber)) {
+    if (fiber->deadline == 0)
+      continue;
+    if (fiber->deadline <= now)
+      timeout = 0;
+    else if ((timeout < 0) || (((fiber->deadline - now + CG_FIBER_NSEC_PER_MSEC - 1) / CG_FIBER_NSEC_PER_MSEC) < (uint64_t)timeout))
+      timeout = (int)((fiber->deadline - now + CG_FIBER_NSEC_PER_MSEC - 1) / CG_FIBER_NSEC_PER_MSEC);
+  }
+
+  if (!cg_fiber_scheduler_waitevents(scheduler, timeout))
+    return false;
+
+  now = cg_getmonotonicnanotime();
+  for (fiber = (CGFiber*)cg_list_next(&scheduler->waitList); fiber; fiber = nextFiber) {
+    nextFiber = (CGFiber*)cg_list_next((CGList*)fiber);
+    if ((fiber->deadline == 0) || (now < fiber->deadline))
+      continue;
+    cg_fiber_scheduler_wake(scheduler, fiber, 0);
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_fiber_scheduler_run
+ ****************************************/
+
+bool cg_fiber_scheduler_run(CGFiberScheduler* scheduler)
+{
+  CGFiberScheduler* prevScheduler;
+  bool isSuccess;
+
+  if (!scheduler)
+    return false;
+
+  prevScheduler = _gFiberScheduler;
+  _gFiberScheduler = scheduler;
+
+  isSuccess = true;
+  while (0 < scheduler->fiberCnt) {
+    cg_fiber_scheduler_runready(scheduler);
+    if (scheduler->fiberCnt <= 0)
+      break;
+    if (!cg_fiber_scheduler_poll(scheduler)) {
+      isSuccess = false;
+      break;
+    }
+  }
+
+  _gFiberScheduler = prevScheduler;
+
+  return isSuccess;
+}
@@ -0,0 +1,610 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/future.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_FUTURE_NSEC_PER_SEC 1000000000L
+#define CG_FUTURE_NSEC_PER_MSEC 1000000L
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+typedef struct {
+  CG_FUTURE_FUNC func;
+  void* userData;
+  CGFuture* future;
+} CGFutureTask;
+
+typedef struct {
+  CG_FUTURE_THEN_FUNC func;
+  void* userData;
+  CGFuture* future;
+} CGFutureThen;
+
+typedef struct {
+  CGFuture* future;
+  size_t remainCnt;
+  size_t refCnt;
+} CGFutureJoin;
+
+/****************************************
+ * cg_future_new
+ ****************************************/
+
+static CGFuture* cg_future_new(CGThreadPool* pool, int refCnt)
+{
+  CGFuture* future;
+  pthread_condattr_t condAttr;
+
+  future = (CGFuture*)malloc(sizeof(CGFuture));
+  if (!future)
+    return NULL;
+
+  pthread_mutex_init(&future->mutexId, NULL);
+  pthread_condattr_init(&condAttr);
+#if !defined(__APPLE__)
+  /* Timed waits are not disturbed by wall clock changes */
+  pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+#endif
+  pthread_cond_init(&future->condId, &condAttr);
+  pthread_condattr_destroy(&condAttr);
+
+  future->state = CG_FUTURE_PENDING;
+  future->value = NULL;
+  future->error = CG_FUTURE_ERROR_NONE;
+  future->refCnt = refCnt;
+  future->waiterCnt = 0;
+  future->callbacks = NULL;
+  future->pool = pool;
+
+  return future;
+}
+
+/****************************************
+ * cg_future_retain
+ ****************************************/
+
+CGFuture* cg_future_retain(CGFuture* future)
+{
+  if (!future)
+    return NULL;
+
+  cg_atomic_inc(&future->refCnt);
+
+  return future;
+}
+
+/****************************************
+ * cg_future_delete
+ ****************************************/
+
+void cg_future_delete(CGFuture* future)
+{
+  if (!future)
+    return;
+
+  if (cg_atomic_fetchsub(&future->refCnt, 1, CG_ATOMIC_ACQ_REL) != 1)
+    return;
+
+  pthread_mutex_destroy(&future->mutexId);
+  pthread_cond_destroy(&future->condId);
+  free(future);
+}
+
+/****************************************
+ * cg_future_runcallback
+ ****************************************/
+
+static void cg_future_runcallback(void* userData)
+{
+  CGFutureCallback* callback = (CGFutureCallback*)userData;
+
+  callback->func(callback->future, callback->userData);
+  cg_future_delete(callback->future);
+  free(callback);
+}
+
+/****************************************
+ * cg_future_dispatch
+ ****************************************/
+
+static void cg_future_dispatch(CGFuture* future, CGFutureCallback* callback)
+{
+  /* A stopped pool refuses tasks, and the callback must still run */
+  if (!future->pool || !cg_thread_pool_submit(future->pool, cg_future_runcallback, callback))
+    cg_future_runcallback(callback);
+}
+
+/****************************************
+ * cg_future_settle
+ ****************************************/
+
+static bool cg_future_settle(CGFuture* future, int state, void* value, int error)
+{
+  CGFutureCallback* callbacks;
+  CGFutureCallback* callback;
+  CGFutureCallback* next;
+
+  pthread_mutex_lock(&future->mutexId);
+  if (future->state != CG_FUTURE_PENDING) {
+    pthread_mutex_unlock(&future->mutexId);
+    return false;
+  }
+  future->value = value;
+  future->error = error;
+  cg_atomic_store(&future->state, state, CG_ATOMIC_RELEASE);
+  callbacks = future->callbacks;
+  future->callbacks = NULL;
+  if (0 < future->waiterCnt)
+    pthread_cond_broadcast(&future->condId);
+  pthread_mutex_unlock(&future->mutexId);
+
+  /* Callbacks are pushed in front, so reverse them into registration order */
+  callback = NULL;
+  while (callbacks) {
+    next = callbacks->next;
+    callbacks->next = callback;
+    callback = callbacks;
+    callbacks = next;
+  }
+
+  while (callback) {
+    next = callback->next;
+    cg_future_dispatch(future, callback);
+    callback = next;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_promise_new
+ ****************************************/
+
+CGPromise* cg_promise_new(CGThreadPool* pool)
+{
+  CGPromise* promise;
+
+  promise = (CGPromise*)malloc(sizeof(CGPromise));
+  if (!promise)
+    return NULL;
+
+  promise->future = cg_future_new(pool, 1);
+  if (!promise->future) {
+    free(promise);
+    return NULL;
+  }
+
+  return promise;
+}
+
+/****************************************
+ * cg_promise_delete
+ ****************************************/
+
+void cg_promise_delete(CGPromise* promise)
+{
+  if (!promise)
+    return;
+
+  cg_future_settle(promise->future, CG_FUTURE_REJECTED, NULL, CG_FUTURE_ERROR_BROKEN);
+  cg_future_delete(promise->future);
+  free(promise);
+}
+
+/****************************************
+ * cg_promise_getfuture
+ ****************************************/
+
+CGFuture* cg_promise_getfuture(CGPromise* promise)
+{
+  if (!promise)
+    return NULL;
+
+  return cg_future_retain(promise->future);
+}
+
+/****************************************
+ * cg_promise_setvalue
+ ****************************************/
+
+bool cg_promise_setvalue(CGPromise* promise, void* value)
+{
+  if (!promise)
+    return false;
+
+  return cg_future_settle(promise->future, CG_FUTURE_FULFILLED, value, CG_FUTURE_ERROR_NONE);
+}
+
+/****************************************
+ * cg_promise_seterror
+ ****************************************/
+
+bool cg_promise_seterror(CGPromise* promise, int error)
+{
+  if (!promise)
+    return false;
+
+  return cg_future_settle(promise->future, CG_FUTURE_REJECTED, NULL, error);
+}
+
+/****************************************
+ * cg_future_runtask
+ ****************************************/
+
+static void cg_future_runtask(void* userData)
+{
+  CGFutureTask* task = (CGFutureTask*)userData;
+
+  cg_future_settle(task->future, CG_FUTURE_FULFILLED, task->func(task->userData), CG_FUTURE_ERROR_NONE);
+  cg_future_delete(task->future);
+  free(task);
+}
+
+/****************************************
+ * cg_future_run
+ ****************************************/
+
+CGFuture* cg_future_run(CGThreadPool* pool, CG_FUTURE_FUNC func, void* userData)
+{
+  CGFutureTask* task;
+  CGFuture* future;
+
+  if (!pool || !func)
+    return NULL;
+
+  task = (CGFutureTask*)malloc(sizeof(CGFutureTask));
+  future = cg_future_new(pool, 2);
+  if (!task || !future) {
+    free(task);
+    free(future);
+    return NULL;
+  }
+
+  task->func = func;
+  task->userData = userData;
+  task->future = future;
+
+  if (!cg_thread_pool_submit(pool, cg_future_runtask, task)) {
+    free(task);
+    cg_future_delete(future);
+    cg_future_delete(future);
+    return NULL;
+  }
+
+  return future;
+}
+
+/****************************************
+ * cg_future_wait
+ ****************************************/
+
+bool cg_future_wait(CGFuture* future)
+{
+  if (!future)
+    return false;
+
+  if (cg_future_isready(future))
+    return true;
+
+  pthread_mutex_lock(&future->mutexId);
+  future->waiterCnt++;
+  while (future->state == CG_FUTURE_PENDING)
+    pthread_cond_wait(&future->condId, &future->mutexId);
+  future->waiterCnt--;
+  pthread_mutex_unlock(&future->mutexId);
+
+  return true;
+}
+
+/****************************************
+ * cg_future_timedwait
+ ****************************************/
+
+bool cg_future_timedwait(CGFuture* future, clock_t mtime)
+{
+  struct timespec deadline;
+  bool isReady;
+
+  if (!future)
+    return false;
+
+  if (cg_future_isready(future))
+    return true;
+
+#if !defined(__APPLE__)
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+#else
+  clock_gettime(CLOCK_REALTIME, &deadline);
+#endif
+  deadline.tv_sec += mtime / 1000;
+  deadline.tv_nsec += (long)(mtime % 1000) * CG_FUTURE_NSEC_PER_MSEC;
+  if (CG_FUTURE_NSEC_PER_SEC <= deadline.tv_nsec) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= CG_FUTURE_NSEC_PER_SEC;
+  }
+
+  pthread_mutex_lock(&future->mutexId);
+  future->waiterCnt++;
+  while (future->state == CG_FUTURE_PENDING) {
+    if (pthread_cond_timedwait(&future->condId, &future->mutexId, &deadline) == ETIMEDOUT)
+      break;
+  }
+  future->waiterCnt--;
+  isReady = (future->state != CG_FUTURE_PENDING) ? true : false;
+  pthread_mutex_unlock(&future->mutexId);
+
+  return isReady;
+}
+
+/****************************************
+ * cg_future_getstate
+ ****************************************/
+
+int cg_future_getstate(CGFuture* future)
+{
+  if (!future)
+    return CG_FUTURE_PENDING;
+
+  return cg_atomic_load(&future->state, CG_ATOMIC_ACQUIRE);
+}
+
+/****************************************
+ * cg_future_isready
+ ****************************************/
+
+bool cg_future_isready(CGFuture* future)
+{
+  return (cg_future_getstate(future) != CG_FUTURE_PENDING) ? true : false;
+}
+
+/****************************************
+ * cg_future_getvalue
+ ****************************************/
+
+void* cg_future_getvalue(CGFuture* future)
+{
+  if (!cg_future_wait(future))
+    return NULL;
+
+  return (future->state == CG_FUTURE_FULFILLED) ? future->value : NULL;
+}
+
+/****************************************
+ * cg_future_geterror
+ ****************************************/
+
+int cg_future_geterror(CGFuture* future)
+{
+  if (!cg_future_isready(future))
+    return CG_FUTURE_ERROR_NONE;
+
+  return future->error;
+}
+
+/****************************************
+ * cg_future_addcallback
+ ****************************************/
+
+bool cg_future_addcallback(CGFuture* future, CG_FUTURE_CALLBACK func, void* userData)
+{
+  CGFutureCallback* callback;
+
+  if (!future || !func)
+    return false;
+
+  callback = (CGFutureCallback*)malloc(sizeof(CGFutureCallback));
+  if (!callback)
+    return false;
+
+  callback->future = cg_future_retain(future);
+  callback->func = func;
+  callback->userData = userData;
+
+  pthread_mutex_lock(&future->mutexId);
+  if (future->state == CG_FUTURE_PENDING) {
+    callback->next = future->callbacks;
+    future->callbacks = callback;
+    pthread_mutex_unlock(&future->mutexId);
+    return true;
+  }
+  pthread_mutex_unlock(&future->mutexId);
+
+  callback->next = NULL;
+  cg_future_dispatch(future, callback);
+
+  return true;
+}
+
+/****************************************
+ * cg_future_runthen
+ ****************************************/
+
+static void cg_future_runthen(CGFuture* future, void* userData)
+{
+  CGFutureThen* then = (CGFutureThen*)userData;
+
+  if (future->state == CG_FUTURE_FULFILLED)
+    cg_future_settle(then->future, CG_FUTURE_FULFILLED, then->func(future, then->userData), CG_FUTURE_ERROR_NONE);
+  else
+    cg_future_settle(then->future, CG_FUTURE_REJECTED, NULL, future->error);
+
+  cg_future_delete(then->future);
+  free(then);
+}
+
+/****************************************
+ * cg_future_then
+ ****************************************/
+
+CGFuture* cg_future_then(CGFuture* future, CG_FUTURE_THEN_FUNC func, void* userData)
+{
+  CGFutureThen* then;
+  CGFuture* nextFuture;
+
+  if (!future || !func)
+    return NULL;
+
+  then = (CGFutureThen*)malloc(sizeof(CGFutureThen));
+  nextFuture = cg_future_new(future->pool, 2);
+  if (!then || !nextFuture) {
+    free(then);
+    free(nextFuture);
+    return NULL;
+  }
+
+  then->func = func;
+  then->userData = userData;
+  then->future = nextFuture;
+
+  if (!cg_future_addcallback(future, cg_future_runthen, then)) {
+    free(then);
+    cg_future_delete(nextFuture);
+    cg_future_delete(nextFuture);
+    return NULL;
+  }
+
+  return nextFuture;
+}
+
+/****************************************
+ * cg_future_join_new
+ ****************************************/
+
+static CGFutureJoin* cg_future_join_new(size_t futureCnt, CGThreadPool* pool)
+{
+  CGFutureJoin* join;
+
+  join = (CGFutureJoin*)malloc(sizeof(CGFutureJoin));
+  if (!join)
+    return NULL;
+
+  /* The join keeps one reference on its future and releases it with the last callback */
+  join->future = cg_future_new(pool, 2);
+  if (!join->future) {
+    free(join);
+    return NULL;
+  }
+  join->remainCnt = futureCnt;
+  join->refCnt = futureCnt;
+
+  return join;
+}
+
+/****************************************
+ * cg_future_join_release
+ ****************************************/
+
+static void cg_future_join_release(CGFutureJoin* join, size_t refCnt)
+{
+  if (cg_atomic_fetchsub(&join->refCnt, refCnt, CG_ATOMIC_ACQ_REL) != refCnt)
+    return;
+
+  cg_future_delete(join->future);
+  free(join);
+}
+
+/****************************************
+ * cg_future_onall
+ ****************************************/
+
+static void cg_future_onall(CGFuture* future, void* userData)
+{
+  CGFutureJoin* join = (CGFutureJoin*)userData;
+
+  if (future->state == CG_FUTURE_REJECTED)
+    cg_future_settle(join->future, CG_FUTURE_REJECTED, NULL, future->error);
+  else if (cg_atomic_fetchsub(&join->remainCnt, 1, CG_ATOMIC_ACQ_REL) == 1)
+    cg_future_settle(join->future, CG_FUTURE_FULFILLED, NULL, CG_FUTURE_ERROR_NONE);
+
+  cg_future_join_release(join, 1);
+}
+
+/****************************************
+ * cg_future_onany
+ ****************************************/
+
+static void cg_future_onany(CGFuture* future, void* userData)
+{
+  CGFutureJoin* join = (CGFutureJoin*)userData;
+
+  cg_future_settle(join->future, CG_FUTURE_FULFILLED, future, CG_FUTURE_ERROR_NONE);
+  cg_future_join_release(join, 1);
+}
+
+/****************************************
+ * cg_future_join
+ ****************************************/
+
+static CGFuture* cg_future_join(CGFuture** futures, size_t futureCnt, CGThreadPool* pool, CG_FUTURE_CALLBACK func)
+{
+  CGFutureJoin* join;
+  CGFuture* future;
+  size_t n;
+
+  if (!futures || (futureCnt <= 0))
+    return NULL;
+
+  join = cg_future_join_new(futureCnt, pool);
+  if (!join)
+    return NULL;
+
+  future = cg_future_retain(join->future);
+
+  for (n = 0; n < futureCnt; n++) {
+    if (!cg_future_addcallback(futures[n], func, join)) {
+      cg_future_settle(join->future, CG_FUTURE_REJECTED, NULL, CG_FUTURE_ERROR_BROKEN);
+      cg_future_join_release(join, futureCnt - n);
+      break;
+    }
+  }
+
+  /* Drop the reference taken above, the caller owns the one made by cg_future_join_new() */
+  cg_future_delete(future);
+
+  return future;
+}
+
+/****************************************
+ * cg_future_whenall
+ ****************************************/
+
+CGFuture* cg_future_whenall(CGFuture** futures, size_t futureCnt, CGThreadPool* pool)
+{
+  return cg_future_join(futures, futureCnt, pool, cg_future_onall);
+}
+
+/****************************************
+ * cg_future_whenany
+ ****************************************/
+
+CGFuture* cg_future_whenany(CGFuture** futures, size_t futureCnt, CGThreadPool* pool)
+{
+  return cg_future_join(futures, futureCnt, pool, cg_future_onany);
+}
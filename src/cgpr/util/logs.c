@@ -41,7 +41,7 @@ void cg_net_socket_log(int severity, const char* prefix, const char* fromAddr, c
   }
   snprintf((buf + offset), (sizeof(buf) - offset), "%-15s -> %-15s ", fromAddr, toAddr);
   offset = strlen(buf);
-  for (n = 0; n < msgLen; n++) {
+  for (n = 0; (n < msgLen) && ((offset + 2) < sizeof(buf)); n++) {
     snprintf((buf + offset), (sizeof(buf) - offset), "%02X", msgBytes[n]);
     offset += 2;
   }
@@ -0,0 +1,256 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/future.h>
+#include <cgpr/util/parallel.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_PARALLEL_PARTIAL_ALIGN 16
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+/**
+ * Shared by the caller and the helper tasks. Helpers may be scheduled
+ * after all chunks are done, so the context is freed by whoever releases
+ * it last.
+ */
+typedef struct {
+  CG_PARALLEL_FOR_FUNC forFunc;
+  CG_PARALLEL_REDUCE_FUNC reduceFunc;
+  void* userData;
+  size_t begin;
+  size_t end;
+  size_t grainSize;
+  size_t chunkCnt;
+  size_t nextChunk;
+  size_t doneCnt;
+  size_t slotCnt;
+  size_t nextSlot;
+  size_t slotSize;
+  byte* partials;
+  CGPromise* promise;
+  size_t refCnt;
+} CGParallelContext;
+
+/****************************************
+ * static variable
+ ****************************************/
+
+static CGThreadPool* _gParallelPool = NULL;
+static pthread_once_t _gParallelPoolOnce = PTHREAD_ONCE_INIT;
+
+/****************************************
+ * cg_parallel_initdefaultpool
+ ****************************************/
+
+static void cg_parallel_initdefaultpool(void)
+{
+  CGThreadPool* pool;
+
+  pool = cg_thread_pool_new(0);
+  if (!pool)
+    return;
+
+  if (!cg_thread_pool_start(pool)) {
+    cg_thread_pool_delete(pool);
+    return;
+  }
+
+  _gParallelPool = pool;
+}
+
+/****************************************
+ * cg_parallel_getdefaultpool
+ ****************************************/
+
+CGThreadPool* cg_parallel_getdefaultpool(void)
+{
+  pthread_once(&_gParallelPoolOnce, cg_parallel_initdefaultpool);
+  return _gParallelPool;
+}
+
+/****************************************
+ * cg_parallel_context_release
+ ****************************************/
+
+static void cg_parallel_context_release(CGParallelContext* ctx, size_t refCnt)
+{
+  if (cg_atomic_fetchsub(&ctx->refCnt, refCnt, CG_ATOMIC_ACQ_REL) != refCnt)
+    return;
+
+  cg_promise_delete(ctx->promise);
+  free(ctx->partials);
+  free(ctx);
+}
+
+/****************************************
+ * cg_parallel_context_run
+ ****************************************/
+
+static void cg_parallel_context_run(CGParallelContext* ctx)
+{
+  size_t chunkBegin;
+  size_t chunkEnd;
+  size_t doneCnt;
+  size_t chunk;
+  void* partial;
+
+  partial = NULL;
+  if (ctx->partials)
+    partial = ctx->partials + (cg_atomic_fetchadd(&ctx->nextSlot, 1, CG_ATOMIC_RELAXED) * ctx->slotSize);
+
+  doneCnt = 0;
+  while ((chunk = cg_atomic_fetchadd(&ctx->nextChunk, 1, CG_ATOMIC_RELAXED)) < ctx->chunkCnt) {
+    chunkBegin = ctx->begin + (chunk * ctx->grainSize);
+    chunkEnd = ((ctx->end - chunkBegin) < ctx->grainSize) ? ctx->end : (chunkBegin + ctx->grainSize);
+    if (ctx->reduceFunc)
+      ctx->reduceFunc(chunkBegin, chunkEnd, partial, ctx->userData);
+    else
+      ctx->forFunc(chunkBegin, chunkEnd, ctx->userData);
+    doneCnt++;
+  }
+
+  /* Counted once per thread, the release publishes the whole partial */
+  if ((0 < doneCnt) && ((cg_atomic_fetchadd(&ctx->doneCnt, doneCnt, CG_ATOMIC_ACQ_REL) + doneCnt) == ctx->chunkCnt))
+    cg_promise_setvalue(ctx->promise, NULL);
+}
+
+/****************************************
+ * cg_parallel_runhelper
+ ****************************************/
+
+static void cg_parallel_runhelper(void* userData)
+{
+  CGParallelContext* ctx = (CGParallelContext*)userData;
+
+  cg_parallel_context_run(ctx);
+  cg_parallel_context_release(ctx, 1);
+}
+
+/****************************************
+ * cg_parallel_run
+ ****************************************/
+
+static bool cg_parallel_run(CGThreadPool* pool, size_t begin, size_t end, size_t grainSize, CG_PARALLEL_FOR_FUNC forFunc, CG_PARALLEL_REDUCE_FUNC reduceFunc, void* result, const void* identity, size_t resultSize, CG_PARALLEL_JOIN_FUNC joinFunc, void* userData)
+{
+  CGParallelContext* ctx;
+  CGFuture* future;
+  size_t workerCnt;
+  size_t helperCnt;
+  size_t n;
+
+  if (end <= begin)
+    return true;
+
+  if (!pool)
+    pool = cg_parallel_getdefaultpool();
+  workerCnt = (pool && cg_thread_pool_isrunning(pool)) ? cg_thread_pool_getworkercount(pool) : 0;
+
+  ctx = (CGParallelContext*)calloc(1, sizeof(CGParallelContext));
+  if (!ctx)
+    return false;
+
+  ctx->forFunc = forFunc;
+  ctx->reduceFunc = reduceFunc;
+  ctx->userData = userData;
+  ctx->begin = begin;
+  ctx->end = end;
+  ctx->grainSize = grainSize;
+  if (ctx->grainSize == CG_PARALLEL_GRAIN_AUTO)
+    ctx->grainSize = (end - begin) / (((0 < workerCnt) ? workerCnt : 1) * CG_PARALLEL_CHUNKS_PER_WORKER);
+  if (ctx->grainSize <= 0)
+    ctx->grainSize = 1;
+  ctx->chunkCnt = ((end - begin) / ctx->grainSize) + ((((end - begin) % ctx->grainSize) != 0) ? 1 : 0);
+
+  helperCnt = (workerCnt < (ctx->chunkCnt - 1)) ? workerCnt : (ctx->chunkCnt - 1);
+  ctx->slotCnt = helperCnt + 1;
+  ctx->refCnt = helperCnt + 1;
+  ctx->promise = cg_promise_new(NULL);
+  if (!ctx->promise) {
+    free(ctx);
+    return false;
+  }
+
+  if (reduceFunc) {
+    ctx->slotSize = (resultSize + (CG_PARALLEL_PARTIAL_ALIGN - 1)) & ~((size_t)CG_PARALLEL_PARTIAL_ALIGN - 1);
+    ctx->partials = (byte*)malloc(ctx->slotCnt * ctx->slotSize);
+    if (!ctx->partials) {
+      cg_parallel_context_release(ctx, ctx->refCnt);
+      return false;
+    }
+    for (n = 0; n < ctx->slotCnt; n++)
+      memcpy(ctx->partials + (n * ctx->slotSize), identity, resultSize);
+  }
+
+  for (n = 0; n < helperCnt; n++) {
+    if (!cg_thread_pool_submit(pool, cg_parallel_runhelper, ctx)) {
+      cg_parallel_context_release(ctx, helperCnt - n);
+      break;
+    }
+  }
+
+  /* The caller takes chunks too, so it only waits for chunks in progress */
+  cg_parallel_context_run(ctx);
+
+  future = cg_promise_getfuture(ctx->promise);
+  cg_future_wait(future);
+  cg_future_delete(future);
+
+  if (reduceFunc) {
+    for (n = 0; n < ctx->slotCnt; n++)
+      joinFunc(result, ctx->partials + (n * ctx->slotSize), userData);
+  }
+
+  cg_parallel_context_release(ctx, 1);
+
+  return true;
+}
+
+/****************************************
+ * cg_parallel_for
+ ****************************************/
+
+bool cg_parallel_for(CGThreadPool* pool, size_t begin, size_t end, size_t grainSize, CG_PARALLEL_FOR_FUNC func, void* userData)
+{
+  if (!func)
+    return false;
+
+  return cg_parallel_run(pool, begin, end, grainSize, func, NULL, NULL, NULL, 0, NULL, userData);
+}
+
+/****************************************
+ * cg_parallel_reduce
+ ****************************************/
+
+bool cg_parallel_reduce(CGThreadPool* pool, size_t begin, size_t end, size_t grainSize, void* result, const void* identity, size_t resultSize, CG_PARALLEL_REDUCE_FUNC func, CG_PARALLEL_JOIN_FUNC joinFunc, void* userData)
+{
+  if (!result || !identity || (resultSize <= 0) || !func || !joinFunc)
+    return false;
+
+  return cg_parallel_run(pool, begin, end, grainSize, NULL, func, result, identity, resultSize, joinFunc, userData);
+}
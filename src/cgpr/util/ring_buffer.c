@@ -0,0 +1,441 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cgpr/util/ring_buffer.h>
+
+#if !defined(WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/****************************************
+ * cg_ring_buffer_roundup
+ ****************************************/
+
+static size_t cg_ring_buffer_roundup(size_t capacity)
+{
+  size_t roundCapacity;
+
+  roundCapacity = 1;
+  while (roundCapacity < capacity)
+    roundCapacity <<= 1;
+
+  return roundCapacity;
+}
+
+/****************************************
+ * cg_ring_buffer_alloc
+ ****************************************/
+
+static CGRingBuffer* cg_ring_buffer_alloc(size_t capacity)
+{
+  CGRingBuffer* ring;
+
+  ring = (CGRingBuffer*)malloc(sizeof(CGRingBuffer));
+  if (!ring)
+    return NULL;
+
+  ring->buf = NULL;
+  ring->capacity = capacity;
+  ring->mask = capacity - 1;
+  ring->head = 0;
+  ring->tail = 0;
+  ring->mirrored = false;
+
+  return ring;
+}
+
+/****************************************
+ * cg_ring_buffer_new
+ ****************************************/
+
+CGRingBuffer* cg_ring_buffer_new(size_t capacity)
+{
+  CGRingBuffer* ring;
+
+  if ((capacity <= 0) || (CG_RING_BUFFER_CAPACITY_MAX < capacity))
+    return NULL;
+
+  ring = cg_ring_buffer_alloc(cg_ring_buffer_roundup(capacity));
+  if (!ring)
+    return NULL;
+
+  ring->buf = (byte*)malloc(ring->capacity);
+  if (!ring->buf) {
+    free(ring);
+    return NULL;
+  }
+
+  return ring;
+}
+
+/****************************************
+ * cg_ring_buffer_mirrored_new
+ ****************************************/
+
+CGRingBuffer* cg_ring_buffer_mirrored_new(size_t capacity)
+{
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+  CGRingBuffer* ring;
+  size_t pageSize;
+  byte* addr;
+  int fd;
+
+  if ((capacity <= 0) || (CG_RING_BUFFER_CAPACITY_MAX < capacity))
+    return NULL;
+
+  pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  if (capacity < pageSize)
+    capacity = pageSize;
+
+  ring = cg_ring_buffer_alloc(cg_ring_buffer_roundup(capacity));
+  if (!ring)
+    return NULL;
+
+  fd = memfd_create("cgpr-ring-buffer", MFD_CLOEXEC);
+  if (fd < 0) {
+    free(ring);
+    return cg_ring_buffer_new(capacity);
+  }
+
+  if (ftruncate(fd, ring->capacity) != 0) {
+    close(fd);
+    free(ring);
+    return cg_ring_buffer_new(capacity);
+  }
+
+  /* Reserve twice the capacity, then map the same pages into both halves */
+  addr = (byte*)mmap(NULL, ring->capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if ((addr == MAP_FAILED)
+      || (mmap(addr, ring->capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+      || (mmap(addr + ring->capacity, ring->capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)) {
+    if (addr != MAP_FAILED)
+      munmap(addr, ring->capacity * 2);
+    close(fd);
+    free(ring);
+    return cg_ring_buffer_new(capacity);
+  }
+
+  close(fd);
+
+  ring->buf = addr;
+  ring->mirrored = true;
+
+  return ring;
+#else
+  return cg_ring_buffer_new(capacity);
+#endif
+}
+
+/****************************************
+ * cg_ring_buffer_delete
+ ****************************************/
+
+void cg_ring_buffer_delete(CGRingBuffer* ring)
+{
+  if (!ring)
+    return;
+
+#if !defined(WIN32)
+  if (ring->mirrored)
+    munmap(ring->buf, ring->capacity * 2);
+  else
+    free(ring->buf);
+#else
+  free(ring->buf);
+#endif
+
+  free(ring);
+}
+
+/****************************************
+ * cg_ring_buffer_clear
+ ****************************************/
+
+void cg_ring_buffer_clear(CGRingBuffer* ring)
+{
+  if (!ring)
+    return;
+
+  ring->head = 0;
+  ring->tail = 0;
+}
+
+/****************************************
+ * cg_ring_buffer_getreadregion
+ ****************************************/
+
+byte* cg_ring_buffer_getreadregion(CGRingBuffer* ring, size_t* regionLen)
+{
+  size_t offset;
+  size_t len;
+
+  if (!ring)
+    return NULL;
+
+  offset = ring->head & ring->mask;
+  len = cg_ring_buffer_getsize(ring);
+  if (!ring->mirrored && ((ring->capacity - offset) < len))
+    len = ring->capacity - offset;
+
+  if (regionLen)
+    *regionLen = len;
+
+  return ring->buf + offset;
+}
+
+/****************************************
+ * cg_ring_buffer_consume
+ ****************************************/
+
+void cg_ring_buffer_consume(CGRingBuffer* ring, size_t len)
+{
+  if (!ring)
+    return;
+
+  if (cg_ring_buffer_getsize(ring) < len)
+    len = cg_ring_buffer_getsize(ring);
+
+  ring->head += len;
+  if (ring->head == ring->tail) {
+    ring->head = 0;
+    ring->tail = 0;
+  }
+}
+
+/****************************************
+ * cg_ring_buffer_getwriteregion
+ ****************************************/
+
+byte* cg_ring_buffer_getwriteregion(CGRingBuffer* ring, size_t* regionLen)
+{
+  size_t offset;
+  size_t len;
+
+  if (!ring)
+    return NULL;
+
+  offset = ring->tail & ring->mask;
+  len = cg_ring_buffer_getfreesize(ring);
+  if (!ring->mirrored && ((ring->capacity - offset) < len))
+    len = ring->capacity - offset;
+
+  if (regionLen)
+    *regionLen = len;
+
+  return ring->buf + offset;
+}
+
+/****************************************
+ * cg_ring_buffer_commit
+ ****************************************/
+
+void cg_ring_buffer_commit(CGRingBuffer* ring, size_t len)
+{
+  if (!ring)
+    return;
+
+  if (cg_ring_buffer_getfreesize(ring) < len)
+    len = cg_ring_buffer_getfreesize(ring);
+
+  ring->tail += len;
+}
+
+/****************************************
+ * cg_ring_buffer_write
+ ****************************************/
+
+size_t cg_ring_buffer_write(CGRingBuffer* ring, const byte* data, size_t dataLen)
+{
+  size_t writtenLen;
+  size_t regionLen;
+  byte* region;
+
+  if (!ring || !data)
+    return 0;
+
+  writtenLen = 0;
+  while (writtenLen < dataLen) {
+    region = cg_ring_buffer_getwriteregion(ring, &regionLen);
+    if (regionLen <= 0)
+      break;
+    if ((dataLen - writtenLen) < regionLen)
+      regionLen = dataLen - writtenLen;
+    memcpy(region, data + writtenLen, regionLen);
+    cg_ring_buffer_commit(ring, regionLen);
+    writtenLen += regionLen;
+  }
+
+  return writtenLen;
+}
+
+/****************************************
+ * cg_ring_buffer_peek
+ ****************************************/
+
+size_t cg_ring_buffer_peek(CGRingBuffer* ring, byte* buf, size_t bufLen)
+{
+  size_t offset;
+  size_t peekLen;
+  size_t firstLen;
+
+  if (!ring || !buf)
+    return 0;
+
+  peekLen = cg_ring_buffer_getsize(ring);
+  if (bufLen < peekLen)
+    peekLen = bufLen;
+
+  offset = ring->head & ring->mask;
+  firstLen = ring->mirrored ? peekLen : (ring->capacity - offset);
+  if (peekLen < firstLen)
+    firstLen = peekLen;
+
+  memcpy(buf, ring->buf + offset, firstLen);
+  if (firstLen < peekLen)
+    memcpy(buf + firstLen, ring->buf, peekLen - firstLen);
+
+  return peekLen;
+}
+
+/****************************************
+ * cg_ring_buffer_read
+ ****************************************/
+
+size_t cg_ring_buffer_read(CGRingBuffer* ring, byte* buf, size_t bufLen)
+{
+  size_t readLen;
+
+  readLen = cg_ring_buffer_peek(ring, buf, bufLen);
+  cg_ring_buffer_consume(ring, readLen);
+
+  return readLen;
+}
+
+#if !defined(WIN32)
+
+/****************************************
+ * cg_ring_buffer_getreadvec
+ ****************************************/
+
+int cg_ring_buffer_getreadvec(CGRingBuffer* ring, struct iovec* iov)
+{
+  size_t regionLen;
+  size_t size;
+
+  if (!ring || !iov)
+    return 0;
+
+  size = cg_ring_buffer_getsize(ring);
+  if (size <= 0)
+    return 0;
+
+  iov[0].iov_base = cg_ring_buffer_getreadregion(ring, &regionLen);
+  iov[0].iov_len = regionLen;
+  if (size <= regionLen)
+    return 1;
+
+  iov[1].iov_base = ring->buf;
+  iov[1].iov_len = size - regionLen;
+
+  return 2;
+}
+
+/****************************************
+ * cg_ring_buffer_getwritevec
+ ****************************************/
+
+int cg_ring_buffer_getwritevec(CGRingBuffer* ring, struct iovec* iov)
+{
+  size_t regionLen;
+  size_t freeSize;
+
+  if (!ring || !iov)
+    return 0;
+
+  freeSize = cg_ring_buffer_getfreesize(ring);
+  if (freeSize <= 0)
+    return 0;
+
+  iov[0].iov_base = cg_ring_buffer_getwriteregion(ring, &regionLen);
+  iov[0].iov_len = regionLen;
+  if (freeSize <= regionLen)
+    return 1;
+
+  iov[1].iov_base = ring->buf;
+  iov[1].iov_len = freeSize - regionLen;
+
+  return 2;
+}
+
+/****************************************
+ * cg_ring_buffer_readfd
+ ****************************************/
+
+ssize_t cg_ring_buffer_readfd(CGRingBuffer* ring, int fd)
+{
+  struct iovec iov[2];
+  ssize_t readLen;
+  int iovCnt;
+
+  if (!ring)
+    return -1;
+
+  iovCnt = cg_ring_buffer_getwritevec(ring, iov);
+  if (iovCnt <= 0)
+    return 0;
+
+  readLen = readv(fd, iov, iovCnt);
+  if (0 < readLen)
+    cg_ring_buffer_commit(ring, (size_t)readLen);
+
+  return readLen;
+}
+
+/****************************************
+ * cg_ring_buffer_writefd
+ ****************************************/
+
+ssize_t cg_ring_buffer_writefd(CGRingBuffer* ring, int fd)
+{
+  struct iovec iov[2];
+  ssize_t writtenLen;
+  int iovCnt;
+
+  if (!ring)
+    return -1;
+
+  iovCnt = cg_ring_buffer_getreadvec(ring, iov);
+  if (iovCnt <= 0)
+    return 0;
+
+  writtenLen = writev(fd, iov, iovCnt);
+  if (0 < writtenLen)
+    cg_ring_buffer_consume(ring, (size_t)writtenLen);
+
+  return writtenLen;
+}
+
+#endif
@@ -0,0 +1,201 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <cgpr/util/rwlock.h>
+
+/****************************************
+ * cg_rwlock_create
+ ****************************************/
+
+static CGRWLock* cg_rwlock_create(bool writerPreferred)
+{
+  CGRWLock* lock;
+#if !defined(WIN32)
+  pthread_rwlockattr_t lockAttr;
+#endif
+
+  lock = (CGRWLock*)malloc(sizeof(CGRWLock));
+
+  if (!lock)
+    return NULL;
+
+  lock->writerPreferred = false;
+
+#if defined(WIN32)
+  /* SRW locks have no policy, they are fair enough that writers are not starved */
+  InitializeSRWLock(&lock->lockId);
+#else
+  pthread_rwlockattr_init(&lockAttr);
+#if defined(__GLIBC__)
+  /* glibc prefers readers by default, even with PTHREAD_RWLOCK_PREFER_WRITER_NP */
+  if (writerPreferred && (pthread_rwlockattr_setkind_np(&lockAttr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP) == 0))
+    lock->writerPreferred = true;
+#endif
+  if (pthread_rwlock_init(&lock->lockId, &lockAttr) != 0) {
+    pthread_rwlockattr_destroy(&lockAttr);
+    free(lock);
+    return NULL;
+  }
+  pthread_rwlockattr_destroy(&lockAttr);
+#endif
+
+  return lock;
+}
+
+/****************************************
+ * cg_rwlock_new
+ ****************************************/
+
+CGRWLock* cg_rwlock_new(void)
+{
+  return cg_rwlock_create(false);
+}
+
+/****************************************
+ * cg_rwlock_writerpreferred_new
+ ****************************************/
+
+CGRWLock* cg_rwlock_writerpreferred_new(void)
+{
+  return cg_rwlock_create(true);
+}
+
+/****************************************
+ * cg_rwlock_delete
+ ****************************************/
+
+bool cg_rwlock_delete(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if !defined(WIN32)
+  pthread_rwlock_destroy(&lock->lockId);
+#endif
+  free(lock);
+
+  return true;
+}
+
+/****************************************
+ * cg_rwlock_readlock
+ ****************************************/
+
+bool cg_rwlock_readlock(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if defined(WIN32)
+  AcquireSRWLockShared(&lock->lockId);
+  return true;
+#else
+  return (pthread_rwlock_rdlock(&lock->lockId) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_rwlock_tryreadlock
+ ****************************************/
+
+bool cg_rwlock_tryreadlock(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if defined(WIN32)
+  return TryAcquireSRWLockShared(&lock->lockId) ? true : false;
+#else
+  return (pthread_rwlock_tryrdlock(&lock->lockId) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_rwlock_readunlock
+ ****************************************/
+
+bool cg_rwlock_readunlock(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if defined(WIN32)
+  ReleaseSRWLockShared(&lock->lockId);
+  return true;
+#else
+  return (pthread_rwlock_unlock(&lock->lockId) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_rwlock_writelock
+ ****************************************/
+
+bool cg_rwlock_writelock(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if defined(WIN32)
+  AcquireSRWLockExclusive(&lock->lockId);
+  return true;
+#else
+  return (pthread_rwlock_wrlock(&lock->lockId) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_rwlock_trywritelock
+ ****************************************/
+
+bool cg_rwlock_trywritelock(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if defined(WIN32)
+  return TryAcquireSRWLockExclusive(&lock->lockId) ? true : false;
+#else
+  return (pthread_rwlock_trywrlock(&lock->lockId) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_rwlock_writeunlock
+ ****************************************/
+
+bool cg_rwlock_writeunlock(CGRWLock* lock)
+{
+  if (!lock)
+    return false;
+
+#if defined(WIN32)
+  ReleaseSRWLockExclusive(&lock->lockId);
+  return true;
+#else
+  return (pthread_rwlock_unlock(&lock->lockId) == 0) ? true : false;
+#endif
+}
@@ -0,0 +1,696 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <cgpr/util/scheduler.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_SCHEDULER_NSEC_PER_SEC 1000000000ULL
+#define CG_SCHEDULER_NSEC_PER_MSEC 1000000ULL
+#define CG_SCHEDULER_WAKE_NONE ((uint64_t)-1)
+
+#if defined(WIN32)
+#define CG_SCHEDULER_TLS __declspec(thread)
+#else
+#define CG_SCHEDULER_TLS __thread
+#endif
+
+#define cg_scheduler_getlevelspan(level) (1ULL << (CG_SCHEDULER_WHEEL_BITS * (level)))
+
+/****************************************
+ * static variable
+ ****************************************/
+
+/* The timer whose callback runs on the current thread, so that it can delete itself */
+static CG_SCHEDULER_TLS CGSchedulerTimer* _gSchedulerTimer = NULL;
+
+/****************************************
+ * cg_scheduler_timer_new
+ ****************************************/
+
+CGSchedulerTimer* cg_scheduler_timer_new(CG_SCHEDULER_TIMER_FUNC func, void* userData)
+{
+  CGSchedulerTimer* timer;
+
+  timer = (CGSchedulerTimer*)malloc(sizeof(CGSchedulerTimer));
+
+  if (!timer)
+    return NULL;
+
+  cg_scheduler_timer_init(timer, func, userData);
+
+  return timer;
+}
+
+/****************************************
+ * cg_scheduler_timer_init
+ ****************************************/
+
+void cg_scheduler_timer_init(CGSchedulerTimer* timer, CG_SCHEDULER_TIMER_FUNC func, void* userData)
+{
+  if (!timer)
+    return;
+
+  cg_list_node_init((CGList*)timer);
+  timer->scheduler = NULL;
+  timer->expireTick = 0;
+  timer->periodTicks = 0;
+  timer->state = CG_SCHEDULER_TIMER_IDLE;
+  timer->func = func;
+  timer->userData = userData;
+}
+
+/****************************************
+ * cg_scheduler_timer_delete
+ ****************************************/
+
+void cg_scheduler_timer_delete(CGSchedulerTimer* timer)
+{
+  CGScheduler* sched;
+
+  if (!timer)
+    return;
+
+  sched = timer->scheduler;
+  if (sched) {
+    pthread_mutex_lock(&sched->mutexId);
+    if (timer->scheduler == sched) {
+      if (timer->state == CG_SCHEDULER_TIMER_PENDING) {
+        cg_list_remove((CGList*)timer);
+        sched->timerCnt--;
+      }
+      timer->state = CG_SCHEDULER_TIMER_IDLE;
+      if (sched->runningTimer == timer) {
+        if (_gSchedulerTimer == timer)
+          sched->runningTimer = NULL;
+        while (sched->runningTimer == timer)
+          pthread_cond_wait(&sched->condId, &sched->mutexId);
+      }
+      timer->scheduler = NULL;
+    }
+    pthread_mutex_unlock(&sched->mutexId);
+  }
+
+  free(timer);
+}
+
+/****************************************
+ * cg_scheduler_new
+ ****************************************/
+
+CGScheduler* cg_scheduler_new(void)
+{
+  CGScheduler* sched;
+  pthread_condattr_t condAttr;
+  int level, slot;
+
+  sched = (CGScheduler*)malloc(sizeof(CGScheduler));
+
+  if (!sched)
+    return NULL;
+
+  pthread_mutex_init(&sched->mutexId, NULL);
+  pthread_condattr_init(&condAttr);
+#if !defined(__APPLE__)
+  pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+#endif
+  pthread_cond_init(&sched->condId, &condAttr);
+  pthread_condattr_destroy(&condAttr);
+
+  for (level = 0; level < CG_SCHEDULER_WHEEL_LEVELS; level++) {
+    for (slot = 0; slot < CG_SCHEDULER_WHEEL_SIZE; slot++)
+      cg_list_header_init(&sched->wheel[level][slot]);
+  }
+
+  sched->startTime = cg_getmonotonicnanotime();
+  sched->resolution = CG_SCHEDULER_DEFAULT_RESOLUTION * CG_SCHEDULER_NSEC_PER_MSEC;
+  sched->currentTick = 0;
+  sched->wakeTick = 0;
+  sched->timerCnt = 0;
+  sched->runningTimer = NULL;
+  sched->runnable = false;
+  sched->thread = NULL;
+
+  return sched;
+}
+
+/****************************************
+ * cg_scheduler_delete
+ ****************************************/
+
+void cg_scheduler_delete(CGScheduler* sched)
+{
+  CGSchedulerTimer* timer;
+  int level, slot;
+
+  if (!sched)
+    return;
+
+  cg_scheduler_stop(sched);
+
+  /* Timers are owned by the caller, they are only detached */
+  for (level = 0; level < CG_SCHEDULER_WHEEL_LEVELS; level++) {
+    for (slot = 0; slot < CG_SCHEDULER_WHEEL_SIZE; slot++) {
+      while ((timer = (CGSchedulerTimer*)cg_list_next(&sched->wheel[level][slot]))) {
+        cg_list_remove((CGList*)timer);
+        timer->state = CG_SCHEDULER_TIMER_IDLE;
+        timer->scheduler = NULL;
+      }
+    }
+  }
+
+  pthread_mutex_destroy(&sched->mutexId);
+  pthread_cond_destroy(&sched->condId);
+
+  free(sched);
+}
+
+/****************************************
+ * cg_scheduler_getnowtick
+ ****************************************/
+
+static uint64_t cg_scheduler_getnowtick(CGScheduler* sched)
+{
+  return (cg_getmonotonicnanotime() - sched->startTime) / sched->resolution;
+}
+
+/****************************************
+ * cg_scheduler_msec2ticks
+ ****************************************/
+
+static uint64_t cg_scheduler_msec2ticks(CGScheduler* sched, clock_t mtime)
+{
+  if (mtime <= 0)
+    return 0;
+  return (((uint64_t)mtime * CG_SCHEDULER_NSEC_PER_MSEC) + sched->resolution - 1) / sched->resolution;
+}
+
+/****************************************
+ * cg_scheduler_insert
+ ****************************************/
+
+static void cg_scheduler_insert(CGScheduler* sched, CGSchedulerTimer* timer)
+{
+  uint64_t expireTick;
+  uint64_t delta;
+  int level;
+
+  expireTick = timer->expireTick;
+  if (expireTick < sched->currentTick)
+    expireTick = sched->currentTick;
+
+  delta = expireTick - sched->currentTick;
+  for (level = 0; level < (CG_SCHEDULER_WHEEL_LEVELS - 1); level++) {
+    if (delta < cg_scheduler_getlevelspan(level + 1))
+      break;
+  }
+
+  /* Beyond the wheel, park in the farthest slot and place again when it comes round */
+  if (cg_scheduler_getlevelspan(CG_SCHEDULER_WHEEL_LEVELS) <= delta)
+    expireTick = sched->currentTick + cg_scheduler_getlevelspan(CG_SCHEDULER_WHEEL_LEVELS) - 1;
+
+  cg_list_add(&sched->wheel[level][(expireTick >> (CG_SCHEDULER_WHEEL_BITS * level)) & CG_SCHEDULER_WHEEL_MASK], (CGList*)timer);
+}
+
+/****************************************
+ * cg_scheduler_moveslot
+ ****************************************/
+
+static void cg_scheduler_moveslot(CGList* slotList, CGList* toList)
+{
+  CGList* node;
+
+  while ((node = cg_list_next(slotList))) {
+    cg_list_remove(node);
+    cg_list_add(toList, node);
+  }
+}
+
+/****************************************
+ * cg_scheduler_cascade
+ ****************************************/
+
+static void cg_scheduler_cascade(CGScheduler* sched, int level, int slot)
+{
+  CGList cascadeList;
+  CGSchedulerTimer* timer;
+
+  cg_list_header_init(&cascadeList);
+  cg_scheduler_moveslot(&sched->wheel[level][slot], &cascadeList);
+
+  while ((timer = (CGSchedulerTimer*)cg_list_next(&cascadeList))) {
+    cg_list_remove((CGList*)timer);
+    cg_scheduler_insert(sched, timer);
+  }
+}
+
+/****************************************
+ * cg_scheduler_expire
+ ****************************************/
+
+static size_t cg_scheduler_expire(CGScheduler* sched)
+{
+  CGList expiredList;
+  CGSchedulerTimer* timer;
+  uint64_t tick;
+  size_t fireCnt;
+  int level, slot;
+
+  tick = sched->currentTick;
+
+  /* Every full turn of a level brings the next slot of the level above down */
+  if ((tick & CG_SCHEDULER_WHEEL_MASK) == 0) {
+    for (level = 1; level < CG_SCHEDULER_WHEEL_LEVELS; level++) {
+      slot = (int)((tick >> (CG_SCHEDULER_WHEEL_BITS * level)) & CG_SCHEDULER_WHEEL_MASK);
+      cg_scheduler_cascade(sched, level, slot);
+      if (slot != 0)
+        break;
+    }
+  }
+
+  cg_list_header_init(&expiredList);
+  cg_scheduler_moveslot(&sched->wheel[0][tick & CG_SCHEDULER_WHEEL_MASK], &expiredList);
+
+  fireCnt = 0;
+  while ((timer = (CGSchedulerTimer*)cg_list_next(&expiredList))) {
+    cg_list_remove((CGList*)timer);
+    if (tick < timer->expireTick) {
+      cg_scheduler_insert(sched, timer);
+      continue;
+    }
+
+    sched->timerCnt--;
+    timer->state = CG_SCHEDULER_TIMER_RUNNING;
+    sched->runningTimer = timer;
+
+    pthread_mutex_unlock(&sched->mutexId);
+    _gSchedulerTimer = timer;
+    timer->func(timer, timer->userData);
+    _gSchedulerTimer = NULL;
+    pthread_mutex_lock(&sched->mutexId);
+
+    fireCnt++;
+
+    /* The callback may have deleted, cancelled or rescheduled the timer */
+    if (sched->runningTimer != timer)
+      continue;
+    sched->runningTimer = NULL;
+
+    if (timer->state == CG_SCHEDULER_TIMER_RUNNING) {
+      if (0 < timer->periodTicks) {
+        timer->expireTick += timer->periodTicks;
+        if (timer->expireTick <= tick)
+          timer->expireTick += (((tick - timer->expireTick) / timer->periodTicks) + 1) * timer->periodTicks;
+        timer->state = CG_SCHEDULER_TIMER_PENDING;
+        sched->timerCnt++;
+        cg_scheduler_insert(sched, timer);
+      }
+      else {
+        timer->state = CG_SCHEDULER_TIMER_IDLE;
+      }
+    }
+    if (timer->state == CG_SCHEDULER_TIMER_IDLE)
+      timer->scheduler = NULL;
+
+    pthread_cond_broadcast(&sched->condId);
+  }
+
+  return fireCnt;
+}
+
+/****************************************
+ * cg_scheduler_process
+ ****************************************/
+
+static size_t cg_scheduler_process(CGScheduler* sched)
+{
+  uint64_t nowTick;
+  uint64_t tick;
+  size_t fireCnt;
+
+  nowTick = cg_scheduler_getnowtick(sched);
+
+  fireCnt = 0;
+  while (sched->currentTick < nowTick) {
+    /* An empty wheel has nothing to cascade, so idle time is skipped at once */
+    if (sched->timerCnt == 0) {
+      sched->currentTick = nowTick;
+      break;
+    }
+    tick = sched->currentTick;
+    fireCnt += cg_scheduler_expire(sched);
+    if (sched->currentTick <= tick)
+      sched->currentTick = tick + 1;
+  }
+
+  return fireCnt;
+}
+
+/****************************************
+ * cg_scheduler_getnexttick
+ ****************************************/
+
+static uint64_t cg_scheduler_getnexttick(CGScheduler* sched)
+{
+  uint64_t tick;
+  int n;
+
+  for (n = 0; n < CG_SCHEDULER_WHEEL_SIZE; n++) {
+    tick = sched->currentTick + n;
+    if ((tick & CG_SCHEDULER_WHEEL_MASK) == 0)
+      return tick;
+    if (cg_list_next(&sched->wheel[0][tick & CG_SCHEDULER_WHEEL_MASK]))
+      return tick;
+  }
+
+  return sched->currentTick + CG_SCHEDULER_WHEEL_SIZE;
+}
+
+/****************************************
+ * cg_scheduler_waituntil
+ ****************************************/
+
+static void cg_scheduler_waituntil(CGScheduler* sched, uint64_t wakeTime)
+{
+  struct timespec deadline;
+  uint64_t now;
+  uint64_t waitTime;
+
+  now = cg_getmonotonicnanotime();
+  if (wakeTime <= now)
+    return;
+  waitTime = wakeTime - now;
+
+#if !defined(__APPLE__)
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+#else
+  clock_gettime(CLOCK_REALTIME, &deadline);
+#endif
+  deadline.tv_sec += (time_t)(waitTime / CG_SCHEDULER_NSEC_PER_SEC);
+  deadline.tv_nsec += (long)(waitTime % CG_SCHEDULER_NSEC_PER_SEC);
+  if (CG_SCHEDULER_NSEC_PER_SEC <= (uint64_t)deadline.tv_nsec) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= CG_SCHEDULER_NSEC_PER_SEC;
+  }
+
+  pthread_cond_timedwait(&sched->condId, &sched->mutexId, &deadline);
+}
+
+/****************************************
+ * cg_scheduler_action
+ ****************************************/
+
+static void cg_scheduler_action(CGThread* thread)
+{
+  CGScheduler* sched;
+
+  sched = (CGScheduler*)cg_thread_getuserdata(thread);
+
+  pthread_mutex_lock(&sched->mutexId);
+  while (sched->runnable) {
+    sched->wakeTick = 0;
+    cg_scheduler_process(sched);
+    if (!sched->runnable)
+      break;
+    if (sched->timerCnt == 0) {
+      sched->wakeTick = CG_SCHEDULER_WAKE_NONE;
+      pthread_cond_wait(&sched->condId, &sched->mutexId);
+      continue;
+    }
+    /* A tick is processed once it has passed completely */
+    sched->wakeTick = cg_scheduler_getnexttick(sched);
+    cg_scheduler_waituntil(sched, sched->startTime + ((sched->wakeTick + 1) * sched->resolution));
+  }
+  sched->wakeTick = 0;
+  pthread_mutex_unlock(&sched->mutexId);
+}
+
+/****************************************
+ * cg_scheduler_start
+ ****************************************/
+
+bool cg_scheduler_start(CGScheduler* sched)
+{
+  CGThread* thread;
+
+  if (!sched)
+    return false;
+
+  if (sched->thread)
+    return true;
+
+  thread = cg_thread_new();
+  if (!thread)
+    return false;
+
+  cg_thread_setaction(thread, cg_scheduler_action);
+  cg_thread_setuserdata(thread, sched);
+  cg_thread_setjoinable(thread, true);
+
+  sched->runnable = true;
+  if (!cg_thread_start(thread)) {
+    sched->runnable = false;
+    cg_thread_delete(thread);
+    return false;
+  }
+
+  sched->thread = thread;
+
+  return true;
+}
+
+/****************************************
+ * cg_scheduler_stop
+ ****************************************/
+
+bool cg_scheduler_stop(CGScheduler* sched)
+{
+  if (!sched)
+    return false;
+
+  if (!sched->thread)
+    return true;
+
+  pthread_mutex_lock(&sched->mutexId);
+  sched->runnable = false;
+  pthread_cond_broadcast(&sched->condId);
+  pthread_mutex_unlock(&sched->mutexId);
+
+  cg_thread_stop(sched->thread);
+  cg_thread_delete(sched->thread);
+  sched->thread = NULL;
+
+  return true;
+}
+
+/****************************************
+ * cg_scheduler_setresolution
+ ****************************************/
+
+bool cg_scheduler_setresolution(CGScheduler* sched, clock_t mtime)
+{
+  bool isChanged;
+
+  if (!sched || (mtime <= 0))
+    return false;
+
+  pthread_mutex_lock(&sched->mutexId);
+  isChanged = ((sched->timerCnt == 0) && !sched->runningTimer) ? true : false;
+  if (isChanged) {
+    sched->resolution = (uint64_t)mtime * CG_SCHEDULER_NSEC_PER_MSEC;
+    sched->startTime = cg_getmonotonicnanotime();
+    sched->currentTick = 0;
+  }
+  pthread_mutex_unlock(&sched->mutexId);
+
+  return isChanged;
+}
+
+/****************************************
+ * cg_scheduler_getresolution
+ ****************************************/
+
+clock_t cg_scheduler_getresolution(CGScheduler* sched)
+{
+  clock_t mtime;
+
+  if (!sched)
+    return 0;
+
+  pthread_mutex_lock(&sched->mutexId);
+  mtime = (clock_t)(sched->resolution / CG_SCHEDULER_NSEC_PER_MSEC);
+  pthread_mutex_unlock(&sched->mutexId);
+
+  return mtime;
+}
+
+/****************************************
+ * cg_scheduler_size
+ ****************************************/
+
+size_t cg_scheduler_size(CGScheduler* sched)
+{
+  size_t timerCnt;
+
+  if (!sched)
+    return 0;
+
+  pthread_mutex_lock(&sched->mutexId);
+  timerCnt = sched->timerCnt;
+  pthread_mutex_unlock(&sched->mutexId);
+
+  return timerCnt;
+}
+
+/****************************************
+ * cg_scheduler_arm
+ ****************************************/
+
+static bool cg_scheduler_arm(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay, clock_t period, bool keepPeriod)
+{
+  uint64_t nowTick;
+
+  if (!sched || !timer || !timer->func)
+    return false;
+
+  pthread_mutex_lock(&sched->mutexId);
+
+  if (timer->scheduler && (timer->scheduler != sched)) {
+    pthread_mutex_unlock(&sched->mutexId);
+    return false;
+  }
+
+  nowTick = cg_scheduler_getnowtick(sched);
+
+  if (timer->state == CG_SCHEDULER_TIMER_PENDING) {
+    cg_list_remove((CGList*)timer);
+    sched->timerCnt--;
+  }
+
+  /* An empty wheel may be far behind the clock, catch it up before placing the timer */
+  if ((sched->timerCnt == 0) && (sched->currentTick < nowTick))
+    sched->currentTick = nowTick;
+
+  if (!keepPeriod)
+    timer->periodTicks = cg_scheduler_msec2ticks(sched, period);
+  timer->expireTick = nowTick + cg_scheduler_msec2ticks(sched, delay);
+  timer->state = CG_SCHEDULER_TIMER_PENDING;
+  timer->scheduler = sched;
+  sched->timerCnt++;
+  cg_scheduler_insert(sched, timer);
+
+  /* Wake the thread only when the timer is due before its current sleep ends */
+  if (timer->expireTick < sched->wakeTick)
+    pthread_cond_broadcast(&sched->condId);
+
+  pthread_mutex_unlock(&sched->mutexId);
+
+  return true;
+}
+
+/****************************************
+ * cg_scheduler_scheduleonce
+ ****************************************/
+
+bool cg_scheduler_scheduleonce(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay)
+{
+  return cg_scheduler_arm(sched, timer, delay, 0, false);
+}
+
+/****************************************
+ * cg_scheduler_scheduleevery
+ ****************************************/
+
+bool cg_scheduler_scheduleevery(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay, clock_t period)
+{
+  if (period <= 0)
+    return false;
+
+  return cg_scheduler_arm(sched, timer, delay, period, false);
+}
+
+/****************************************
+ * cg_scheduler_reschedule
+ ****************************************/
+
+bool cg_scheduler_reschedule(CGScheduler* sched, CGSchedulerTimer* timer, clock_t delay)
+{
+  return cg_scheduler_arm(sched, timer, delay, 0, true);
+}
+
+/****************************************
+ * cg_scheduler_cancel
+ ****************************************/
+
+bool cg_scheduler_cancel(CGScheduler* sched, CGSchedulerTimer* timer)
+{
+  bool isCancelled;
+
+  if (!sched || !timer)
+    return false;
+
+  pthread_mutex_lock(&sched->mutexId);
+
+  if (timer->scheduler != sched) {
+    pthread_mutex_unlock(&sched->mutexId);
+    return false;
+  }
+
+  isCancelled = false;
+  if (timer->state == CG_SCHEDULER_TIMER_PENDING) {
+    cg_list_remove((CGList*)timer);
+    sched->timerCnt--;
+    isCancelled = true;
+  }
+  else if (timer->state == CG_SCHEDULER_TIMER_RUNNING) {
+    isCancelled = (0 < timer->periodTicks) ? true : false;
+  }
+
+  timer->state = CG_SCHEDULER_TIMER_IDLE;
+  if (sched->runningTimer != timer)
+    timer->scheduler = NULL;
+
+  pthread_mutex_unlock(&sched->mutexId);
+
+  return isCancelled;
+}
+
+/****************************************
+ * cg_scheduler_poll
+ ****************************************/
+
+size_t cg_scheduler_poll(CGScheduler* sched)
+{
+  size_t fireCnt;
+
+  if (!sched)
+    return 0;
+
+  pthread_mutex_lock(&sched->mutexId);
+  fireCnt = cg_scheduler_process(sched);
+  pthread_mutex_unlock(&sched->mutexId);
+
+  return fireCnt;
+}
@@ -0,0 +1,261 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <string.h>
+
+#include <cgpr/util/scratch.h>
+#include <cgpr/util/thread.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define cg_scratch_align(size) (((size) + (CG_SCRATCH_ALIGNMENT - 1)) & ~((size_t)CG_SCRATCH_ALIGNMENT - 1))
+#define CG_SCRATCH_BLOCK_HEADER_SIZE cg_scratch_align(sizeof(CGScratchBlock))
+#define cg_scratch_block_getdata(block) ((byte*)(block) + CG_SCRATCH_BLOCK_HEADER_SIZE)
+
+/****************************************
+ * Thread arena
+ ****************************************/
+
+static CGThreadKey* _gScratchKey = NULL;
+static pthread_once_t _gScratchKeyOnce = PTHREAD_ONCE_INIT;
+
+/****************************************
+ * cg_scratch_new
+ ****************************************/
+
+CGScratch* cg_scratch_new(void)
+{
+  CGScratch* scratch;
+
+  scratch = (CGScratch*)malloc(sizeof(CGScratch));
+
+  if (!scratch)
+    return NULL;
+
+  scratch->blocks = NULL;
+  scratch->current = NULL;
+  scratch->blockSize = CG_SCRATCH_BLOCK_DEFAULT_SIZE;
+
+  return scratch;
+}
+
+/****************************************
+ * cg_scratch_delete
+ ****************************************/
+
+void cg_scratch_delete(CGScratch* scratch)
+{
+  CGScratchBlock* block;
+  CGScratchBlock* nextBlock;
+
+  if (!scratch)
+    return;
+
+  for (block = scratch->blocks; block; block = nextBlock) {
+    nextBlock = block->next;
+    free(block);
+  }
+
+  free(scratch);
+}
+
+/****************************************
+ * cg_scratch_initkey
+ ****************************************/
+
+static void cg_scratch_initkey(void)
+{
+  _gScratchKey = cg_thread_key_new((CG_THREAD_KEY_DESTRUCTORFUNC)cg_scratch_delete);
+}
+
+/****************************************
+ * cg_scratch_get
+ ****************************************/
+
+CGScratch* cg_scratch_get(void)
+{
+  CGScratch* scratch;
+
+  pthread_once(&_gScratchKeyOnce, cg_scratch_initkey);
+  if (!_gScratchKey)
+    return NULL;
+
+  scratch = (CGScratch*)cg_thread_key_getvalue(_gScratchKey);
+  if (scratch)
+    return scratch;
+
+  scratch = cg_scratch_new();
+  if (!scratch)
+    return NULL;
+
+  if (!cg_thread_key_setvalue(_gScratchKey, scratch)) {
+    cg_scratch_delete(scratch);
+    return NULL;
+  }
+
+  return scratch;
+}
+
+/****************************************
+ * cg_scratch_alloc
+ ****************************************/
+
+void* cg_scratch_alloc(CGScratch* scratch, size_t size)
+{
+  CGScratchBlock* block;
+  CGScratchBlock* lastBlock;
+  size_t blockSize;
+  void* ptr;
+
+  if (!scratch)
+    return NULL;
+
+  size = cg_scratch_align((0 < size) ? size : 1);
+
+  /* Blocks behind the current one are free, they were only kept for reuse */
+  block = scratch->current;
+  if (!block) {
+    block = scratch->blocks;
+    if (block)
+      block->used = 0;
+  }
+
+  lastBlock = NULL;
+  while (block) {
+    if (size <= (block->size - block->used)) {
+      ptr = cg_scratch_block_getdata(block) + block->used;
+      block->used += size;
+      scratch->current = block;
+      return ptr;
+    }
+    lastBlock = block;
+    block = block->next;
+    if (block)
+      block->used = 0;
+  }
+
+  blockSize = (size < scratch->blockSize) ? scratch->blockSize : size;
+  block = (CGScratchBlock*)malloc(CG_SCRATCH_BLOCK_HEADER_SIZE + blockSize);
+  if (!block)
+    return NULL;
+
+  block->next = NULL;
+  block->size = blockSize;
+  block->used = size;
+
+  if (lastBlock)
+    lastBlock->next = block;
+  else
+    scratch->blocks = block;
+  scratch->current = block;
+
+  return cg_scratch_block_getdata(block);
+}
+
+/****************************************
+ * cg_scratch_strdup
+ ****************************************/
+
+char* cg_scratch_strdup(CGScratch* scratch, const char* str)
+{
+  size_t strLen;
+  char* buf;
+
+  if (!str)
+    return NULL;
+
+  strLen = strlen(str);
+  buf = (char*)cg_scratch_alloc(scratch, strLen + 1);
+  if (!buf)
+    return NULL;
+
+  memcpy(buf, str, strLen + 1);
+
+  return buf;
+}
+
+/****************************************
+ * cg_scratch_mark
+ ****************************************/
+
+CGScratchMark cg_scratch_mark(CGScratch* scratch)
+{
+  CGScratchMark mark;
+
+  mark.block = NULL;
+  mark.used = 0;
+
+  if (scratch && scratch->current) {
+    mark.block = scratch->current;
+    mark.used = scratch->current->used;
+  }
+
+  return mark;
+}
+
+/****************************************
+ * cg_scratch_restore
+ ****************************************/
+
+void cg_scratch_restore(CGScratch* scratch, CGScratchMark mark)
+{
+  if (!scratch)
+    return;
+
+  if (!mark.block) {
+    cg_scratch_reset(scratch);
+    return;
+  }
+
+  scratch->current = mark.block;
+  scratch->current->used = mark.used;
+}
+
+/****************************************
+ * cg_scratch_reset
+ ****************************************/
+
+void cg_scratch_reset(CGScratch* scratch)
+{
+  if (!scratch)
+    return;
+
+  scratch->current = NULL;
+}
+
+/****************************************
+ * cg_scratch_getcapacity
+ ****************************************/
+
+size_t cg_scratch_getcapacity(CGScratch* scratch)
+{
+  CGScratchBlock* block;
+  size_t capacity;
+
+  if (!scratch)
+    return 0;
+
+  capacity = 0;
+  for (block = scratch->blocks; block; block = block->next)
+    capacity += block->size;
+
+  return capacity;
+}
@@ -0,0 +1,210 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/seqlock.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_SEQLOCK_SPIN_COUNT 64
+
+/****************************************
+ * cg_seqlock_new
+ ****************************************/
+
+CGSeqLock* cg_seqlock_new(void)
+{
+  CGSeqLock* lock;
+
+  lock = (CGSeqLock*)malloc(sizeof(CGSeqLock));
+
+  if (!lock)
+    return NULL;
+
+  cg_seqlock_init(lock);
+
+  return lock;
+}
+
+/****************************************
+ * cg_seqlock_delete
+ ****************************************/
+
+bool cg_seqlock_delete(CGSeqLock* lock)
+{
+  if (!lock)
+    return false;
+
+  free(lock);
+
+  return true;
+}
+
+/****************************************
+ * cg_seqlock_init
+ ****************************************/
+
+void cg_seqlock_init(CGSeqLock* lock)
+{
+  if (!lock)
+    return;
+
+  cg_atomic_store(&lock->seq, 0, CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_seqlock_yield
+ ****************************************/
+
+static void cg_seqlock_yield(void)
+{
+#if defined(WIN32)
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+/****************************************
+ * cg_seqlock_writebegin
+ ****************************************/
+
+void cg_seqlock_writebegin(CGSeqLock* lock)
+{
+  unsigned int seq;
+  int spinCnt;
+
+  spinCnt = 0;
+  while (true) {
+    seq = cg_atomic_load(&lock->seq, CG_ATOMIC_RELAXED);
+    if (!(seq & 1) && cg_atomic_cas(&lock->seq, &seq, seq + 1, CG_ATOMIC_ACQUIRE))
+      break;
+    if (CG_SEQLOCK_SPIN_COUNT <= ++spinCnt) {
+      cg_seqlock_yield();
+      spinCnt = 0;
+    }
+  }
+
+  /* The odd sequence has to be visible before any of the data stores */
+  cg_atomic_fence(CG_ATOMIC_RELEASE);
+}
+
+/****************************************
+ * cg_seqlock_writeend
+ ****************************************/
+
+void cg_seqlock_writeend(CGSeqLock* lock)
+{
+  cg_atomic_store(&lock->seq, cg_atomic_load(&lock->seq, CG_ATOMIC_RELAXED) + 1, CG_ATOMIC_RELEASE);
+}
+
+/****************************************
+ * cg_seqlock_readbegin
+ ****************************************/
+
+unsigned int cg_seqlock_readbegin(CGSeqLock* lock)
+{
+  unsigned int seq;
+  int spinCnt;
+
+  spinCnt = 0;
+  while ((seq = cg_atomic_load(&lock->seq, CG_ATOMIC_ACQUIRE)) & 1) {
+    if (CG_SEQLOCK_SPIN_COUNT <= ++spinCnt) {
+      cg_seqlock_yield();
+      spinCnt = 0;
+    }
+  }
+
+  return seq;
+}
+
+/****************************************
+ * cg_seqlock_readretry
+ ****************************************/
+
+bool cg_seqlock_readretry(CGSeqLock* lock, unsigned int seq)
+{
+  /* The data loads must not be reordered after the second sequence load */
+  cg_atomic_fence(CG_ATOMIC_ACQUIRE);
+  return (cg_atomic_load(&lock->seq, CG_ATOMIC_RELAXED) != seq) ? true : false;
+}
+
+/****************************************
+ * cg_seqlock_copy
+ ****************************************/
+
+void cg_seqlock_copy(void* dst, const void* src, size_t size)
+{
+  byte* dstBytes;
+  const byte* srcBytes;
+  size_t n;
+
+  dstBytes = (byte*)dst;
+  srcBytes = (const byte*)src;
+
+  n = 0;
+  if ((((uintptr_t)dstBytes | (uintptr_t)srcBytes) % sizeof(size_t)) == 0) {
+    for (; (n + sizeof(size_t)) <= size; n += sizeof(size_t))
+      cg_atomic_store((size_t*)(dstBytes + n), cg_atomic_load((const size_t*)(srcBytes + n), CG_ATOMIC_RELAXED), CG_ATOMIC_RELAXED);
+  }
+  for (; n < size; n++)
+    cg_atomic_store(dstBytes + n, cg_atomic_load(srcBytes + n, CG_ATOMIC_RELAXED), CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_seqlock_write
+ ****************************************/
+
+void cg_seqlock_write(CGSeqLock* lock, void* data, const void* value, size_t size)
+{
+  if (!lock || !data || !value)
+    return;
+
+  cg_seqlock_writebegin(lock);
+  cg_seqlock_copy(data, value, size);
+  cg_seqlock_writeend(lock);
+}
+
+/****************************************
+ * cg_seqlock_read
+ ****************************************/
+
+void cg_seqlock_read(CGSeqLock* lock, const void* data, void* value, size_t size)
+{
+  unsigned int seq;
+
+  if (!lock || !data || !value)
+    return;
+
+  do {
+    seq = cg_seqlock_readbegin(lock);
+    cg_seqlock_copy(value, data, size);
+  } while (cg_seqlock_readretry(lock, seq));
+}
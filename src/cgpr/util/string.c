@@ -17,6 +17,7 @@
  ******************************************************************/
 
 #include <cgpr/util/log.h>
+#include <cgpr/util/scratch.h>
 #include <cgpr/util/string.h>
 
 #include <string.h>
@@ -113,6 +114,13 @@ void cg_string_setlongvalue(CGString* str, long value)
 void cg_string_setnvalue(CGString* str, const char* value, size_t len)
 {
   if (NULL != str) {
+    /* Reuse the current buffer when the value fits, memmove allows setting a part of itself */
+    if ((value != NULL) && (str->value != NULL) && (len < str->memSize)) {
+      memmove(str->value, value, len);
+      str->value[len] = '\0';
+      str->valueSize = len;
+      return;
+    }
     cg_string_clear(str);
     if (value != NULL) {
       str->valueSize = len;
@@ -271,49 +279,71 @@ char* cg_string_replace(CGString* str, char* fromStr[], char* toStr[], size_t fr
   int n = 0;
   int copyPos = 0;
   size_t* fromStrLen = NULL;
-  CGString* repValue = NULL;
+  size_t* toStrLen = NULL;
+  char* repValue = NULL;
+  size_t repValueLen = 0;
+  int pass = 0;
+  CGScratch* scratch = NULL;
+  CGScratchMark scratchMark;
   bool isReplaced = false;
 
   if (NULL == str)
     return NULL;
 
-  repValue = cg_string_new();
+  /* Temporaries live in the thread's scratch arena, so a replace does not touch the heap */
+  scratch = cg_scratch_get();
+  scratchMark = cg_scratch_mark(scratch);
+  fromStrLen = (size_t*)cg_scratch_alloc(scratch, sizeof(size_t) * fromStrCnt);
+  toStrLen = (size_t*)cg_scratch_alloc(scratch, sizeof(size_t) * fromStrCnt);
 
-  fromStrLen = (size_t*)malloc(sizeof(size_t) * fromStrCnt);
-
-  if (NULL == fromStrLen) {
-    cg_string_delete(repValue);
+  if ((NULL == fromStrLen) || (NULL == toStrLen)) {
+    cg_scratch_restore(scratch, scratchMark);
     return NULL;
   }
 
-  for (n = 0; n < fromStrCnt; n++)
+  for (n = 0; n < fromStrCnt; n++) {
     fromStrLen[n] = cg_strlen(fromStr[n]);
+    toStrLen[n] = cg_strlen(toStr[n]);
+  }
 
   orgValue = cg_string_getvalue(str);
   orgValueLen = cg_string_length(str);
 
-  copyPos = 0;
-  while (copyPos < orgValueLen) {
-    isReplaced = false;
-    for (n = 0; n < fromStrCnt; n++) {
-      if (strncmp(fromStr[n], orgValue + copyPos, fromStrLen[n]) == 0) {
-        cg_string_addvalue(repValue, toStr[n]);
-        copyPos += fromStrLen[n];
-        isReplaced = true;
-        continue;
+  /* The first pass measures the result and the second one writes it */
+  for (pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      repValue = (char*)cg_scratch_alloc(scratch, repValueLen + 1);
+      if (NULL == repValue) {
+        cg_scratch_restore(scratch, scratchMark);
+        return NULL;
       }
     }
-    if (isReplaced == true)
-      continue;
-    cg_string_naddvalue(repValue, orgValue + copyPos, 1);
-    copyPos++;
+    repValueLen = 0;
+    copyPos = 0;
+    while (copyPos < orgValueLen) {
+      isReplaced = false;
+      for (n = 0; n < fromStrCnt; n++) {
+        if (strncmp(fromStr[n], orgValue + copyPos, fromStrLen[n]) == 0) {
+          if (repValue)
+            memcpy(repValue + repValueLen, toStr[n], toStrLen[n]);
+          repValueLen += toStrLen[n];
+          copyPos += fromStrLen[n];
+          isReplaced = true;
+          continue;
+        }
+      }
+      if (isReplaced == true)
+        continue;
+      if (repValue)
+        repValue[repValueLen] = orgValue[copyPos];
+      repValueLen++;
+      copyPos++;
+    }
   }
 
-  free(fromStrLen);
-
-  cg_string_setvalue(str, cg_string_getvalue(repValue));
+  cg_string_setnvalue(str, repValue, repValueLen);
 
-  cg_string_delete(repValue);
+  cg_scratch_restore(scratch, scratchMark);
 
   return cg_string_getvalue(str);
 }
@@ -0,0 +1,653 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/sync.h>
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_SYNC_NSEC_PER_SEC 1000000000ULL
+#define CG_SYNC_NSEC_PER_MSEC 1000000ULL
+#define CG_SYNC_DEADLINE_NONE 0
+#define CG_SYNC_WAKE_ALL INT_MAX
+
+#if !defined(__linux__)
+#define CG_SYNC_BUCKET_SIZE 64
+#endif
+
+/****************************************
+ * Data Type
+ ****************************************/
+
+#if !defined(__linux__)
+typedef struct {
+  pthread_mutex_t mutexId;
+  pthread_cond_t condId;
+} CGSyncBucket;
+#endif
+
+/****************************************
+ * static variable
+ ****************************************/
+
+#if !defined(__linux__)
+static CGSyncBucket _gSyncBuckets[CG_SYNC_BUCKET_SIZE];
+static pthread_once_t _gSyncBucketsOnce = PTHREAD_ONCE_INIT;
+#endif
+
+/****************************************
+ * cg_sync_getdeadline
+ ****************************************/
+
+static uint64_t cg_sync_getdeadline(clock_t mtime)
+{
+  uint64_t now;
+
+  now = cg_getmonotonicnanotime();
+  if (mtime <= 0)
+    return now;
+
+  return now + ((uint64_t)mtime * CG_SYNC_NSEC_PER_MSEC);
+}
+
+#if !defined(__linux__)
+
+/****************************************
+ * cg_sync_initbuckets
+ ****************************************/
+
+static void cg_sync_initbuckets(void)
+{
+  pthread_condattr_t condAttr;
+  int n;
+
+  pthread_condattr_init(&condAttr);
+#if !defined(__APPLE__)
+  pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+#endif
+  for (n = 0; n < CG_SYNC_BUCKET_SIZE; n++) {
+    pthread_mutex_init(&_gSyncBuckets[n].mutexId, NULL);
+    pthread_cond_init(&_gSyncBuckets[n].condId, &condAttr);
+  }
+  pthread_condattr_destroy(&condAttr);
+}
+
+/****************************************
+ * cg_sync_getbucket
+ ****************************************/
+
+static CGSyncBucket* cg_sync_getbucket(int* addr)
+{
+  pthread_once(&_gSyncBucketsOnce, cg_sync_initbuckets);
+  return &_gSyncBuckets[((uintptr_t)addr / sizeof(int)) % CG_SYNC_BUCKET_SIZE];
+}
+
+#endif
+
+/****************************************
+ * cg_sync_wordwait
+ ****************************************/
+
+/* Sleep while the word still has the expected value, false only when the deadline has passed */
+static bool cg_sync_wordwait(int* addr, int val, uint64_t deadline)
+{
+  struct timespec timeout;
+  uint64_t now;
+  uint64_t waitTime;
+#if defined(__linux__)
+  struct timespec* timeoutp;
+#else
+  CGSyncBucket* bucket;
+  int waitRet;
+#endif
+
+  waitTime = 0;
+  if (deadline != CG_SYNC_DEADLINE_NONE) {
+    now = cg_getmonotonicnanotime();
+    if (deadline <= now)
+      return false;
+    waitTime = deadline - now;
+  }
+
+#if defined(__linux__)
+  timeoutp = NULL;
+  if (deadline != CG_SYNC_DEADLINE_NONE) {
+    timeout.tv_sec = (time_t)(waitTime / CG_SYNC_NSEC_PER_SEC);
+    timeout.tv_nsec = (long)(waitTime % CG_SYNC_NSEC_PER_SEC);
+    timeoutp = &timeout;
+  }
+  if (syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, timeoutp, NULL, 0) == 0)
+    return true;
+  return (errno == ETIMEDOUT) ? false : true;
+#else
+  bucket = cg_sync_getbucket(addr);
+  waitRet = 0;
+  pthread_mutex_lock(&bucket->mutexId);
+  if (cg_atomic_load(addr, CG_ATOMIC_SEQ_CST) == val) {
+    if (deadline != CG_SYNC_DEADLINE_NONE) {
+#if !defined(__APPLE__)
+      clock_gettime(CLOCK_MONOTONIC, &timeout);
+#else
+      clock_gettime(CLOCK_REALTIME, &timeout);
+#endif
+      timeout.tv_sec += (time_t)(waitTime / CG_SYNC_NSEC_PER_SEC);
+      timeout.tv_nsec += (long)(waitTime % CG_SYNC_NSEC_PER_SEC);
+      if (CG_SYNC_NSEC_PER_SEC <= (uint64_t)timeout.tv_nsec) {
+        timeout.tv_sec++;
+        timeout.tv_nsec -= CG_SYNC_NSEC_PER_SEC;
+      }
+      waitRet = pthread_cond_timedwait(&bucket->condId, &bucket->mutexId, &timeout);
+    }
+    else {
+      pthread_cond_wait(&bucket->condId, &bucket->mutexId);
+    }
+  }
+  pthread_mutex_unlock(&bucket->mutexId);
+  return (waitRet == ETIMEDOUT) ? false : true;
+#endif
+}
+
+/****************************************
+ * cg_sync_wordwake
+ ****************************************/
+
+static void cg_sync_wordwake(int* addr, int cnt)
+{
+#if defined(__linux__)
+  syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, cnt, NULL, NULL, 0);
+#else
+  CGSyncBucket* bucket;
+
+  /* Buckets are shared, so every waiter is woken to check its own word */
+  bucket = cg_sync_getbucket(addr);
+  pthread_mutex_lock(&bucket->mutexId);
+  pthread_cond_broadcast(&bucket->condId);
+  pthread_mutex_unlock(&bucket->mutexId);
+#endif
+}
+
+/****************************************
+ * cg_event_new
+ ****************************************/
+
+CGEvent* cg_event_new(bool manualReset)
+{
+  CGEvent* ev;
+
+  ev = (CGEvent*)malloc(sizeof(CGEvent));
+
+  if (!ev)
+    return NULL;
+
+  ev->state = 0;
+  ev->waiterCnt = 0;
+  ev->manualReset = manualReset;
+
+  return ev;
+}
+
+/****************************************
+ * cg_event_delete
+ ****************************************/
+
+bool cg_event_delete(CGEvent* ev)
+{
+  if (!ev)
+    return false;
+
+  free(ev);
+
+  return true;
+}
+
+/****************************************
+ * cg_event_trytake
+ ****************************************/
+
+static bool cg_event_trytake(CGEvent* ev)
+{
+  int state;
+
+  if (ev->manualReset)
+    return (cg_atomic_load(&ev->state, CG_ATOMIC_SEQ_CST) != 0) ? true : false;
+
+  state = 1;
+  return cg_atomic_cas(&ev->state, &state, 0, CG_ATOMIC_SEQ_CST);
+}
+
+/****************************************
+ * cg_event_waituntil
+ ****************************************/
+
+static bool cg_event_waituntil(CGEvent* ev, uint64_t deadline)
+{
+  bool isSet;
+
+  if (cg_event_trytake(ev))
+    return true;
+
+  /* The waiter count is raised before the state is checked again, so a set in between wakes this thread */
+  cg_atomic_fetchadd(&ev->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+  isSet = false;
+  while (!(isSet = cg_event_trytake(ev))) {
+    if (!cg_sync_wordwait(&ev->state, 0, deadline)) {
+      isSet = cg_event_trytake(ev);
+      break;
+    }
+  }
+  cg_atomic_fetchsub(&ev->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+
+  return isSet;
+}
+
+/****************************************
+ * cg_event_set
+ ****************************************/
+
+bool cg_event_set(CGEvent* ev)
+{
+  if (!ev)
+    return false;
+
+  cg_atomic_store(&ev->state, 1, CG_ATOMIC_SEQ_CST);
+  if (0 < cg_atomic_load(&ev->waiterCnt, CG_ATOMIC_SEQ_CST))
+    cg_sync_wordwake(&ev->state, ev->manualReset ? CG_SYNC_WAKE_ALL : 1);
+
+  return true;
+}
+
+/****************************************
+ * cg_event_reset
+ ****************************************/
+
+bool cg_event_reset(CGEvent* ev)
+{
+  if (!ev)
+    return false;
+
+  cg_atomic_store(&ev->state, 0, CG_ATOMIC_SEQ_CST);
+
+  return true;
+}
+
+/****************************************
+ * cg_event_wait
+ ****************************************/
+
+bool cg_event_wait(CGEvent* ev)
+{
+  if (!ev)
+    return false;
+
+  return cg_event_waituntil(ev, CG_SYNC_DEADLINE_NONE);
+}
+
+/****************************************
+ * cg_event_timedwait
+ ****************************************/
+
+bool cg_event_timedwait(CGEvent* ev, clock_t mtime)
+{
+  if (!ev)
+    return false;
+
+  return cg_event_waituntil(ev, cg_sync_getdeadline(mtime));
+}
+
+/****************************************
+ * cg_event_isset
+ ****************************************/
+
+bool cg_event_isset(CGEvent* ev)
+{
+  if (!ev)
+    return false;
+
+  return (cg_atomic_load(&ev->state, CG_ATOMIC_ACQUIRE) != 0) ? true : false;
+}
+
+/****************************************
+ * cg_semaphore_new
+ ****************************************/
+
+CGSemaphore* cg_semaphore_new(int count)
+{
+  CGSemaphore* sem;
+
+  if (count < 0)
+    return NULL;
+
+  sem = (CGSemaphore*)malloc(sizeof(CGSemaphore));
+
+  if (!sem)
+    return NULL;
+
+  sem->count = count;
+  sem->waiterCnt = 0;
+
+  return sem;
+}
+
+/****************************************
+ * cg_semaphore_delete
+ ****************************************/
+
+bool cg_semaphore_delete(CGSemaphore* sem)
+{
+  if (!sem)
+    return false;
+
+  free(sem);
+
+  return true;
+}
+
+/****************************************
+ * cg_semaphore_post
+ ****************************************/
+
+bool cg_semaphore_post(CGSemaphore* sem, int count)
+{
+  if (!sem || (count <= 0))
+    return false;
+
+  cg_atomic_fetchadd(&sem->count, count, CG_ATOMIC_SEQ_CST);
+  if (0 < cg_atomic_load(&sem->waiterCnt, CG_ATOMIC_SEQ_CST))
+    cg_sync_wordwake(&sem->count, count);
+
+  return true;
+}
+
+/****************************************
+ * cg_semaphore_trywait
+ ****************************************/
+
+bool cg_semaphore_trywait(CGSemaphore* sem)
+{
+  int count;
+
+  if (!sem)
+    return false;
+
+  count = cg_atomic_load(&sem->count, CG_ATOMIC_SEQ_CST);
+  while (0 < count) {
+    if (cg_atomic_cas(&sem->count, &count, count - 1, CG_ATOMIC_SEQ_CST))
+      return true;
+  }
+
+  return false;
+}
+
+/****************************************
+ * cg_semaphore_waituntil
+ ****************************************/
+
+static bool cg_semaphore_waituntil(CGSemaphore* sem, uint64_t deadline)
+{
+  bool isAcquired;
+
+  if (cg_semaphore_trywait(sem))
+    return true;
+
+  cg_atomic_fetchadd(&sem->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+  isAcquired = false;
+  while (!(isAcquired = cg_semaphore_trywait(sem))) {
+    if (!cg_sync_wordwait(&sem->count, 0, deadline)) {
+      isAcquired = cg_semaphore_trywait(sem);
+      break;
+    }
+  }
+  cg_atomic_fetchsub(&sem->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+
+  return isAcquired;
+}
+
+/****************************************
+ * cg_semaphore_wait
+ ****************************************/
+
+bool cg_semaphore_wait(CGSemaphore* sem)
+{
+  if (!sem)
+    return false;
+
+  return cg_semaphore_waituntil(sem, CG_SYNC_DEADLINE_NONE);
+}
+
+/****************************************
+ * cg_semaphore_timedwait
+ ****************************************/
+
+bool cg_semaphore_timedwait(CGSemaphore* sem, clock_t mtime)
+{
+  if (!sem)
+    return false;
+
+  return cg_semaphore_waituntil(sem, cg_sync_getdeadline(mtime));
+}
+
+/****************************************
+ * cg_semaphore_getcount
+ ****************************************/
+
+int cg_semaphore_getcount(CGSemaphore* sem)
+{
+  if (!sem)
+    return 0;
+
+  return cg_atomic_load(&sem->count, CG_ATOMIC_ACQUIRE);
+}
+
+/****************************************
+ * cg_barrier_new
+ ****************************************/
+
+CGBarrier* cg_barrier_new(int threshold)
+{
+  CGBarrier* barrier;
+
+  if (threshold <= 0)
+    return NULL;
+
+  barrier = (CGBarrier*)malloc(sizeof(CGBarrier));
+
+  if (!barrier)
+    return NULL;
+
+  barrier->threshold = threshold;
+  barrier->arrivedCnt = 0;
+  barrier->generation = 0;
+
+  return barrier;
+}
+
+/****************************************
+ * cg_barrier_delete
+ ****************************************/
+
+bool cg_barrier_delete(CGBarrier* barrier)
+{
+  if (!barrier)
+    return false;
+
+  free(barrier);
+
+  return true;
+}
+
+/****************************************
+ * cg_barrier_wait
+ ****************************************/
+
+bool cg_barrier_wait(CGBarrier* barrier)
+{
+  int generation;
+
+  if (!barrier)
+    return false;
+
+  generation = cg_atomic_load(&barrier->generation, CG_ATOMIC_ACQUIRE);
+
+  if ((cg_atomic_fetchadd(&barrier->arrivedCnt, 1, CG_ATOMIC_ACQ_REL) + 1) == barrier->threshold) {
+    /* The count is reset before the next generation is published, so the next round starts from zero */
+    cg_atomic_store(&barrier->arrivedCnt, 0, CG_ATOMIC_RELAXED);
+    cg_atomic_fetchadd(&barrier->generation, 1, CG_ATOMIC_RELEASE);
+    if (1 < barrier->threshold)
+      cg_sync_wordwake(&barrier->generation, CG_SYNC_WAKE_ALL);
+    return true;
+  }
+
+  while (cg_atomic_load(&barrier->generation, CG_ATOMIC_ACQUIRE) == generation)
+    cg_sync_wordwait(&barrier->generation, generation, CG_SYNC_DEADLINE_NONE);
+
+  return false;
+}
+
+/****************************************
+ * cg_waitgroup_new
+ ****************************************/
+
+CGWaitGroup* cg_waitgroup_new(void)
+{
+  CGWaitGroup* wg;
+
+  wg = (CGWaitGroup*)malloc(sizeof(CGWaitGroup));
+
+  if (!wg)
+    return NULL;
+
+  wg->count = 0;
+  wg->waiterCnt = 0;
+
+  return wg;
+}
+
+/****************************************
+ * cg_waitgroup_delete
+ ****************************************/
+
+bool cg_waitgroup_delete(CGWaitGroup* wg)
+{
+  if (!wg)
+    return false;
+
+  free(wg);
+
+  return true;
+}
+
+/****************************************
+ * cg_waitgroup_add
+ ****************************************/
+
+bool cg_waitgroup_add(CGWaitGroup* wg, int count)
+{
+  int currCount;
+
+  if (!wg)
+    return false;
+
+  currCount = cg_atomic_load(&wg->count, CG_ATOMIC_SEQ_CST);
+  do {
+    if ((currCount + count) < 0)
+      return false;
+  } while (!cg_atomic_cas(&wg->count, &currCount, currCount + count, CG_ATOMIC_SEQ_CST));
+
+  if (((currCount + count) == 0) && (0 < cg_atomic_load(&wg->waiterCnt, CG_ATOMIC_SEQ_CST)))
+    cg_sync_wordwake(&wg->count, CG_SYNC_WAKE_ALL);
+
+  return true;
+}
+
+/****************************************
+ * cg_waitgroup_waituntil
+ ****************************************/
+
+static bool cg_waitgroup_waituntil(CGWaitGroup* wg, uint64_t deadline)
+{
+  int count;
+  bool isDone;
+
+  if (cg_atomic_load(&wg->count, CG_ATOMIC_SEQ_CST) == 0)
+    return true;
+
+  cg_atomic_fetchadd(&wg->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+  isDone = true;
+  while ((count = cg_atomic_load(&wg->count, CG_ATOMIC_SEQ_CST)) != 0) {
+    if (!cg_sync_wordwait(&wg->count, count, deadline)) {
+      isDone = (cg_atomic_load(&wg->count, CG_ATOMIC_SEQ_CST) == 0) ? true : false;
+      break;
+    }
+  }
+  cg_atomic_fetchsub(&wg->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+
+  return isDone;
+}
+
+/****************************************
+ * cg_waitgroup_wait
+ ****************************************/
+
+bool cg_waitgroup_wait(CGWaitGroup* wg)
+{
+  if (!wg)
+    return false;
+
+  return cg_waitgroup_waituntil(wg, CG_SYNC_DEADLINE_NONE);
+}
+
+/****************************************
+ * cg_waitgroup_timedwait
+ ****************************************/
+
+bool cg_waitgroup_timedwait(CGWaitGroup* wg, clock_t mtime)
+{
+  if (!wg)
+    return false;
+
+  return cg_waitgroup_waituntil(wg, cg_sync_getdeadline(mtime));
+}
+
+/****************************************
+ * cg_waitgroup_getcount
+ ****************************************/
+
+int cg_waitgroup_getcount(CGWaitGroup* wg)
+{
+  if (!wg)
+    return 0;
+
+  return cg_atomic_load(&wg->count, CG_ATOMIC_ACQUIRE);
+}
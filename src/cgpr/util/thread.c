@@ -16,15 +16,49 @@
  *
  ******************************************************************/
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #if !defined(WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
 #include <signal.h>
+#include <sys/resource.h>
+#include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+
+#include <cgpr/util/_atomic.h>
 #include <cgpr/util/thread.h>
 #include <cgpr/util/time.h>
 #include <string.h>
 
+#if defined(HAVE_LIBNUMA)
+#include <numa.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_THREAD_JOIN_MAX_WAIT_NSEC 10000000ULL
+
+/* Memory policy modes of set_mempolicy(2), used without libnuma */
+#define CG_THREAD_MPOL_DEFAULT 0
+#define CG_THREAD_MPOL_PREFERRED 1
+
 static void cg_sig_handler(int sign);
+static bool cg_thread_isstarted(CGThread* thread);
+#if !defined(WIN32)
+static bool cg_thread_applynumanode(int node);
+#endif
 
 /****************************************
  * Thread Function
@@ -39,6 +73,8 @@ static DWORD WINAPI Win32ThreadProc(LPVOID lpParam)
   if (thread->action != NULL)
     thread->action(thread);
 
+  cg_atomic_store(&thread->exitFlag, true, CG_ATOMIC_RELEASE);
+
   return 0;
 }
 #else
@@ -58,9 +94,21 @@ static void* cg_posix_thread_proc(void* param)
   actions.sa_handler = cg_sig_handler;
   sigaction(SIGQUIT, &actions, NULL);
 
+#if defined(__linux__)
+  /* Published before the nice value is read, so a concurrent cg_thread_setnice() is never lost */
+  cg_atomic_store(&thread->tid, (pid_t)syscall(SYS_gettid), CG_ATOMIC_SEQ_CST);
+#endif
+  if (cg_atomic_load(&thread->niceFlag, CG_ATOMIC_SEQ_CST))
+    setpriority(PRIO_PROCESS, 0, cg_atomic_load(&thread->niceValue, CG_ATOMIC_SEQ_CST));
+  if (thread->numaNode != CG_CPU_NODE_NONE)
+    cg_thread_applynumanode(thread->numaNode);
+
   if (thread->action != NULL)
     thread->action(thread);
 
+  /* The thread may be deleted as soon as this is seen, so it must be the last access */
+  cg_atomic_store(&thread->exitFlag, true, CG_ATOMIC_RELEASE);
+
   return 0;
 }
 #endif
@@ -83,6 +131,20 @@ CGThread* cg_thread_new(void)
   thread->runnableFlag = false;
   thread->action = NULL;
   thread->userData = NULL;
+  thread->joinable = false;
+  thread->joinPending = false;
+  thread->exitFlag = true;
+  thread->affinity = NULL;
+  thread->numaNode = CG_CPU_NODE_NONE;
+  thread->niceValue = 0;
+  thread->niceFlag = false;
+  thread->schedPolicy = CG_THREAD_SCHED_OTHER;
+  thread->schedPriority = 0;
+#if !defined(WIN32)
+  thread->stopFds[0] = -1;
+  thread->stopFds[1] = -1;
+  thread->tid = 0;
+#endif
 
   return thread;
 }
@@ -96,17 +158,176 @@ bool cg_thread_delete(CGThread* thread)
   if (!thread)
     return false;
 
-  if (thread->runnableFlag == true) {
-    cg_thread_stop(thread);
+  /* Whatever the runnable flag says, a started thread is freed only after it has left its worker function */
+  if (cg_thread_isstarted(thread)) {
+    cg_thread_signalstop(thread);
+#if defined(WIN32)
+    if (!cg_thread_join(thread, CG_THREAD_MIN_SLEEP)) {
+      TerminateThread(thread->hThread, 0);
+      WaitForSingleObject(thread->hThread, INFINITE);
+    }
+#else
+    if (!cg_thread_join(thread, CG_THREAD_MIN_SLEEP)) {
+      /* The thread still writes to the struct, so it is leaked rather than freed */
+      if (thread->joinPending)
+        pthread_detach(thread->pThread);
+      cg_thread_remove(thread);
+      return false;
+    }
+#endif
   }
 
+#if !defined(WIN32)
+  if (thread->joinPending)
+    pthread_join(thread->pThread, NULL);
+  if (0 <= thread->stopFds[0])
+    close(thread->stopFds[0]);
+  if (thread->stopFds[1] != thread->stopFds[0])
+    close(thread->stopFds[1]);
+#endif
+
   cg_thread_remove(thread);
 
+  free(thread->affinity);
   free(thread);
 
   return true;
 }
 
+/****************************************
+ * cg_thread_initstopfds
+ ****************************************/
+
+#if !defined(WIN32)
+static bool cg_thread_initstopfds(CGThread* thread)
+{
+  char stopBuf[8];
+
+  /* A token left from the previous run is consumed */
+  if (0 <= thread->stopFds[0]) {
+    while (0 < read(thread->stopFds[0], stopBuf, sizeof(stopBuf)))
+      ;
+    return true;
+  }
+
+#if defined(__linux__)
+  thread->stopFds[0] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  thread->stopFds[1] = thread->stopFds[0];
+  return (0 <= thread->stopFds[0]) ? true : false;
+#else
+  if (pipe(thread->stopFds) != 0) {
+    thread->stopFds[0] = thread->stopFds[1] = -1;
+    return false;
+  }
+  fcntl(thread->stopFds[0], F_SETFL, fcntl(thread->stopFds[0], F_GETFL, 0) | O_NONBLOCK);
+  fcntl(thread->stopFds[1], F_SETFL, fcntl(thread->stopFds[1], F_GETFL, 0) | O_NONBLOCK);
+  return true;
+#endif
+}
+#endif
+
+/****************************************
+ * cg_thread_tocpuset
+ ****************************************/
+
+#if defined(__linux__)
+static void cg_thread_tocpuset(const CGCpuSet* cpuSet, cpu_set_t* sysCpuSet)
+{
+  int cpu;
+
+  CPU_ZERO(sysCpuSet);
+  for (cpu = 0; (cpu < CPU_SETSIZE) && (cpu < CG_CPU_SET_MAXSIZE); cpu++) {
+    if (!cpuSet || cg_cpuset_contains(cpuSet, cpu))
+      CPU_SET(cpu, sysCpuSet);
+  }
+}
+#endif
+
+/****************************************
+ * cg_thread_tosyspolicy
+ ****************************************/
+
+#if !defined(WIN32)
+static int cg_thread_tosyspolicy(int policy)
+{
+  switch (policy) {
+  case CG_THREAD_SCHED_FIFO:
+    return SCHED_FIFO;
+  case CG_THREAD_SCHED_RR:
+    return SCHED_RR;
+  }
+  return SCHED_OTHER;
+}
+
+/****************************************
+ * cg_thread_initattr
+ ****************************************/
+
+static bool cg_thread_initattr(CGThread* thread, pthread_attr_t* threadAttr)
+{
+#if defined(__linux__)
+  cpu_set_t sysCpuSet;
+#endif
+  struct sched_param schedParam;
+
+  if (pthread_attr_setdetachstate(threadAttr, thread->joinable ? PTHREAD_CREATE_JOINABLE : PTHREAD_CREATE_DETACHED) != 0)
+    return false;
+
+#if defined(__linux__)
+  if (thread->affinity) {
+    cg_thread_tocpuset(thread->affinity, &sysCpuSet);
+    if (pthread_attr_setaffinity_np(threadAttr, sizeof(sysCpuSet), &sysCpuSet) != 0)
+      return false;
+  }
+#endif
+
+  /* Real-time policies are set on creation, so a refused policy fails the start */
+  if (thread->schedPolicy != CG_THREAD_SCHED_OTHER) {
+    memset(&schedParam, 0, sizeof(schedParam));
+    schedParam.sched_priority = thread->schedPriority;
+    if ((pthread_attr_setinheritsched(threadAttr, PTHREAD_EXPLICIT_SCHED) != 0) || (pthread_attr_setschedpolicy(threadAttr, cg_thread_tosyspolicy(thread->schedPolicy)) != 0) || (pthread_attr_setschedparam(threadAttr, &schedParam) != 0))
+      return false;
+  }
+
+  return true;
+}
+#endif
+
+/****************************************
+ * cg_thread_isstarted
+ ****************************************/
+
+static bool cg_thread_isstarted(CGThread* thread)
+{
+  return (cg_atomic_load(&thread->exitFlag, CG_ATOMIC_ACQUIRE) == false) ? true : false;
+}
+
+/****************************************
+ * cg_thread_applyaffinity
+ ****************************************/
+
+static bool cg_thread_applyaffinity(CGThread* thread)
+{
+#if defined(WIN32)
+  DWORD_PTR mask;
+  int cpu;
+
+  mask = 0;
+  for (cpu = 0; cpu < (int)(sizeof(DWORD_PTR) * 8); cpu++) {
+    if (!thread->affinity || cg_cpuset_contains(thread->affinity, cpu))
+      mask |= ((DWORD_PTR)1 << cpu);
+  }
+  return (SetThreadAffinityMask(thread->hThread, mask) != 0) ? true : false;
+#elif defined(__linux__)
+  cpu_set_t sysCpuSet;
+
+  cg_thread_tocpuset(thread->affinity, &sysCpuSet);
+  return (pthread_setaffinity_np(thread->pThread, sizeof(sysCpuSet), &sysCpuSet) == 0) ? true : false;
+#else
+  return false;
+#endif
+}
+
 /****************************************
  * cg_thread_start
  ****************************************/
@@ -116,34 +337,127 @@ bool cg_thread_start(CGThread* thread)
   if (!thread)
     return false;
 
-  thread->runnableFlag = true;
+#if !defined(WIN32)
+  /* A joinable thread from the previous run has to be reaped before its handle is reused */
+  if (thread->joinPending && !cg_thread_join(thread, CG_THREAD_MIN_SLEEP))
+    return false;
+  if (!cg_thread_initstopfds(thread))
+    return false;
+#endif
+
+  cg_atomic_store(&thread->runnableFlag, true, CG_ATOMIC_RELEASE);
+  cg_atomic_store(&thread->exitFlag, false, CG_ATOMIC_RELEASE);
 
 #if defined(WIN32)
   thread->hThread = CreateThread(NULL, 0, Win32ThreadProc, (LPVOID)thread, 0, &thread->threadID);
+  if (thread->affinity)
+    cg_thread_applyaffinity(thread);
 #else
   pthread_attr_t threadAttr;
   if (pthread_attr_init(&threadAttr) != 0) {
-    thread->runnableFlag = false;
+    cg_atomic_store(&thread->runnableFlag, false, CG_ATOMIC_RELEASE);
+    cg_atomic_store(&thread->exitFlag, true, CG_ATOMIC_RELEASE);
     return false;
   }
 
-  if (pthread_attr_setdetachstate(&threadAttr, PTHREAD_CREATE_DETACHED) != 0) {
-    thread->runnableFlag = false;
+  thread->tid = 0;
+  if (!cg_thread_initattr(thread, &threadAttr) || (pthread_create(&thread->pThread, &threadAttr, cg_posix_thread_proc, thread) != 0)) {
+    cg_atomic_store(&thread->runnableFlag, false, CG_ATOMIC_RELEASE);
+    cg_atomic_store(&thread->exitFlag, true, CG_ATOMIC_RELEASE);
     pthread_attr_destroy(&threadAttr);
     return false;
   }
+  pthread_attr_destroy(&threadAttr);
 
-  if (pthread_create(&thread->pThread, &threadAttr, cg_posix_thread_proc, thread) != 0) {
-    thread->runnableFlag = false;
-    pthread_attr_destroy(&threadAttr);
+  thread->joinPending = thread->joinable;
+#endif
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_signalstop
+ ****************************************/
+
+bool cg_thread_signalstop(CGThread* thread)
+{
+#if !defined(WIN32)
+  uint64_t stopToken = 1;
+#endif
+
+  if (!thread)
     return false;
+
+  cg_atomic_store(&thread->runnableFlag, false, CG_ATOMIC_RELEASE);
+
+#if !defined(WIN32)
+  if (0 <= thread->stopFds[1]) {
+    if (write(thread->stopFds[1], &stopToken, sizeof(stopToken)) < 0)
+      return true;
   }
-  pthread_attr_destroy(&threadAttr);
 #endif
 
   return true;
 }
 
+/****************************************
+ * cg_thread_join
+ ****************************************/
+
+bool cg_thread_join(CGThread* thread, clock_t timeout)
+{
+#if !defined(WIN32)
+  struct timespec joinTime;
+  uint64_t deadline;
+  uint64_t waitTime;
+  uint64_t now;
+#endif
+
+  if (!thread)
+    return false;
+
+#if defined(WIN32)
+  if (cg_atomic_load(&thread->exitFlag, CG_ATOMIC_ACQUIRE))
+    return true;
+  return (WaitForSingleObject(thread->hThread, (DWORD)timeout) == WAIT_OBJECT_0) ? true : false;
+#else
+#if defined(__linux__)
+  if (thread->joinPending) {
+    clock_gettime(CLOCK_REALTIME, &joinTime);
+    joinTime.tv_sec += timeout / 1000;
+    joinTime.tv_nsec += (timeout % 1000) * 1000000L;
+    if (1000000000L <= joinTime.tv_nsec) {
+      joinTime.tv_sec++;
+      joinTime.tv_nsec -= 1000000000L;
+    }
+    if (pthread_timedjoin_np(thread->pThread, NULL, &joinTime) != 0)
+      return false;
+    thread->joinPending = false;
+    return true;
+  }
+#endif
+
+  /* Detached threads are polled with a backoff from 50 usec up to 10 msec */
+  deadline = cg_getmonotonicnanotime() + ((uint64_t)timeout * 1000000ULL);
+  waitTime = 50000ULL;
+  while (!cg_atomic_load(&thread->exitFlag, CG_ATOMIC_ACQUIRE)) {
+    now = cg_getmonotonicnanotime();
+    if (deadline <= now)
+      return false;
+    cg_waitnano(((deadline - now) < waitTime) ? (deadline - now) : waitTime);
+    if (waitTime < CG_THREAD_JOIN_MAX_WAIT_NSEC)
+      waitTime *= 2;
+  }
+
+  if (thread->joinPending) {
+    pthread_join(thread->pThread, NULL);
+    thread->joinPending = false;
+  }
+
+  return true;
+#endif
+}
+
 /****************************************
  * cg_thread_stop
  ****************************************/
@@ -153,22 +467,296 @@ bool cg_thread_stop(CGThread* thread)
   if (!thread)
     return false;
 
-  if (thread->runnableFlag == true) {
-    thread->runnableFlag = false;
+  if (cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE)) {
+    cg_thread_signalstop(thread);
 #if defined(WIN32)
-    TerminateThread(thread->hThread, 0);
-    WaitForSingleObject(thread->hThread, INFINITE);
+    if (!cg_thread_join(thread, CG_THREAD_MIN_SLEEP)) {
+      TerminateThread(thread->hThread, 0);
+      WaitForSingleObject(thread->hThread, INFINITE);
+    }
 #else
-    pthread_kill(thread->pThread, 0);
-    /* Now we wait one second for thread termination instead of using
-     * pthread_join */
-    cg_sleep(CG_THREAD_MIN_SLEEP);
+    /* Wait at most as long as the former fixed sleep for a thread which ignores the stop request */
+    cg_thread_join(thread, CG_THREAD_MIN_SLEEP);
 #endif
   }
 
   return true;
 }
 
+/****************************************
+ * cg_thread_waitstop
+ ****************************************/
+
+bool cg_thread_waitstop(CGThread* thread, clock_t mtime)
+{
+#if !defined(WIN32)
+  struct pollfd pfd;
+#endif
+
+  if (!thread)
+    return true;
+
+  if (!cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE))
+    return true;
+
+#if !defined(WIN32)
+  if (0 <= thread->stopFds[0]) {
+    pfd.fd = thread->stopFds[0];
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if ((poll(&pfd, 1, (int)mtime) < 0) && (errno != EINTR))
+      cg_wait(mtime);
+    return cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE) ? false : true;
+  }
+#endif
+
+  cg_wait(mtime);
+
+  return cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE) ? false : true;
+}
+
+/****************************************
+ * cg_thread_getstopfd
+ ****************************************/
+
+int cg_thread_getstopfd(CGThread* thread)
+{
+  if (!thread)
+    return -1;
+
+#if defined(WIN32)
+  return -1;
+#else
+  return thread->stopFds[0];
+#endif
+}
+
+/****************************************
+ * cg_thread_setaffinity
+ ****************************************/
+
+bool cg_thread_setaffinity(CGThread* thread, const CGCpuSet* cpuSet)
+{
+  if (!thread)
+    return false;
+
+  if (cpuSet) {
+    if (cg_cpuset_size(cpuSet) <= 0)
+      return false;
+    if (!thread->affinity) {
+      thread->affinity = (CGCpuSet*)malloc(sizeof(CGCpuSet));
+      if (!thread->affinity)
+        return false;
+    }
+    memcpy(thread->affinity, cpuSet, sizeof(CGCpuSet));
+  }
+  else {
+    free(thread->affinity);
+    thread->affinity = NULL;
+  }
+
+#if !defined(WIN32) && !defined(__linux__)
+  if (cpuSet)
+    return false;
+#endif
+
+  if (!cg_thread_isstarted(thread))
+    return true;
+
+  return cg_thread_applyaffinity(thread);
+}
+
+/****************************************
+ * cg_thread_setcpu
+ ****************************************/
+
+bool cg_thread_setcpu(CGThread* thread, int cpu)
+{
+  CGCpuSet cpuSet;
+
+  cg_cpuset_clear(&cpuSet);
+  if (!cg_cpuset_add(&cpuSet, cpu))
+    return false;
+
+  return cg_thread_setaffinity(thread, &cpuSet);
+}
+
+/****************************************
+ * cg_thread_getaffinity
+ ****************************************/
+
+bool cg_thread_getaffinity(CGThread* thread, CGCpuSet* cpuSet)
+{
+#if defined(__linux__)
+  cpu_set_t sysCpuSet;
+#endif
+  size_t cpuCnt;
+  int cpu;
+
+  if (!thread || !cpuSet)
+    return false;
+
+  cg_cpuset_clear(cpuSet);
+
+#if defined(__linux__)
+  if (cg_thread_isstarted(thread)) {
+    if (pthread_getaffinity_np(thread->pThread, sizeof(sysCpuSet), &sysCpuSet) != 0)
+      return false;
+    for (cpu = 0; (cpu < CPU_SETSIZE) && (cpu < CG_CPU_SET_MAXSIZE); cpu++) {
+      if (CPU_ISSET(cpu, &sysCpuSet))
+        cg_cpuset_add(cpuSet, cpu);
+    }
+    return true;
+  }
+#endif
+
+  if (thread->affinity) {
+    memcpy(cpuSet, thread->affinity, sizeof(CGCpuSet));
+    return true;
+  }
+
+  cpuCnt = cg_cpu_getonlinecount();
+  for (cpu = 0; (size_t)cpu < cpuCnt; cpu++)
+    cg_cpuset_add(cpuSet, cpu);
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_applynumanode
+ ****************************************/
+
+#if !defined(WIN32)
+static bool cg_thread_applynumanode(int node)
+{
+#if defined(HAVE_LIBNUMA)
+  if (numa_available() < 0)
+    return false;
+  if (node == CG_CPU_NODE_NONE)
+    numa_set_localalloc();
+  else
+    numa_set_preferred(node);
+  return true;
+#elif defined(__linux__) && defined(SYS_set_mempolicy)
+  unsigned long nodeMask[CG_CPU_SET_MAXSIZE / (8 * sizeof(unsigned long))];
+  size_t nodeBits;
+
+  if (node == CG_CPU_NODE_NONE)
+    return (syscall(SYS_set_mempolicy, CG_THREAD_MPOL_DEFAULT, NULL, 0) == 0) ? true : false;
+
+  nodeBits = 8 * sizeof(unsigned long);
+  memset(nodeMask, 0, sizeof(nodeMask));
+  nodeMask[node / nodeBits] |= (1UL << (node % nodeBits));
+
+  return (syscall(SYS_set_mempolicy, CG_THREAD_MPOL_PREFERRED, nodeMask, (sizeof(nodeMask) * 8) + 1) == 0) ? true : false;
+#else
+  return false;
+#endif
+}
+#endif
+
+/****************************************
+ * cg_thread_setnumanode
+ ****************************************/
+
+bool cg_thread_setnumanode(CGThread* thread, int node)
+{
+  CGCpuSet nodeSet;
+
+  if (!thread || (node < CG_CPU_NODE_NONE) || (CG_CPU_SET_MAXSIZE <= node))
+    return false;
+
+  if (node == CG_CPU_NODE_NONE) {
+    if (!cg_thread_setaffinity(thread, NULL))
+      return false;
+  }
+  else {
+    if (!cg_cpu_getnodecpus(node, &nodeSet) || !cg_thread_setaffinity(thread, &nodeSet))
+      return false;
+  }
+
+  thread->numaNode = node;
+
+#if defined(WIN32)
+  return true;
+#else
+  if (!cg_thread_isstarted(thread) || !pthread_equal(pthread_self(), thread->pThread))
+    return true;
+
+  return cg_thread_applynumanode(node);
+#endif
+}
+
+/****************************************
+ * cg_thread_setnice
+ ****************************************/
+
+bool cg_thread_setnice(CGThread* thread, int niceValue)
+{
+#if defined(__linux__)
+  pid_t tid;
+#endif
+
+  if (!thread)
+    return false;
+
+#if defined(WIN32)
+  return false;
+#else
+  cg_atomic_store(&thread->niceValue, niceValue, CG_ATOMIC_SEQ_CST);
+  cg_atomic_store(&thread->niceFlag, true, CG_ATOMIC_SEQ_CST);
+
+  if (!cg_thread_isstarted(thread))
+    return true;
+
+#if defined(__linux__)
+  /* Before the thread has published its id it applies the value by itself */
+  tid = cg_atomic_load(&thread->tid, CG_ATOMIC_SEQ_CST);
+  if (tid == 0)
+    return true;
+  return (setpriority(PRIO_PROCESS, (id_t)tid, niceValue) == 0) ? true : false;
+#else
+  return false;
+#endif
+#endif
+}
+
+/****************************************
+ * cg_thread_setschedpolicy
+ ****************************************/
+
+bool cg_thread_setschedpolicy(CGThread* thread, int policy, int priority)
+{
+#if !defined(WIN32)
+  struct sched_param schedParam;
+#endif
+
+  if (!thread)
+    return false;
+
+  if ((policy != CG_THREAD_SCHED_OTHER) && (policy != CG_THREAD_SCHED_FIFO) && (policy != CG_THREAD_SCHED_RR))
+    return false;
+
+#if defined(WIN32)
+  return false;
+#else
+  if (policy == CG_THREAD_SCHED_OTHER)
+    priority = 0;
+  if ((priority < sched_get_priority_min(cg_thread_tosyspolicy(policy))) || (sched_get_priority_max(cg_thread_tosyspolicy(policy)) < priority))
+    return false;
+
+  thread->schedPolicy = policy;
+  thread->schedPriority = priority;
+
+  if (!cg_thread_isstarted(thread))
+    return true;
+
+  memset(&schedParam, 0, sizeof(schedParam));
+  schedParam.sched_priority = priority;
+  return (pthread_setschedparam(thread->pThread, cg_thread_tosyspolicy(policy), &schedParam) == 0) ? true : false;
+#endif
+}
+
 /****************************************
  * cg_thread_restart
  ****************************************/
@@ -192,7 +780,7 @@ bool cg_thread_isrunnable(CGThread* thread)
   pthread_testcancel();
 #endif
 
-  return thread->runnableFlag;
+  return cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE);
 }
 
 /****************************************
@@ -204,7 +792,7 @@ bool cg_thread_isrunning(CGThread* thread)
   if (!thread)
     return false;
 
-  return thread->runnableFlag;
+  return cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE);
 }
 
 /****************************************
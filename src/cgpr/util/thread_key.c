@@ -0,0 +1,102 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <cgpr/util/thread.h>
+
+/****************************************
+ * cg_thread_key_new
+ ****************************************/
+
+CGThreadKey* cg_thread_key_new(CG_THREAD_KEY_DESTRUCTORFUNC destructor)
+{
+  CGThreadKey* key;
+
+  key = (CGThreadKey*)malloc(sizeof(CGThreadKey));
+
+  if (!key)
+    return NULL;
+
+  key->destructor = destructor;
+
+#if defined(WIN32) && !defined(ITRON)
+  /* TLS slots have no destructors on Windows, the owner has to release the values */
+  key->index = TlsAlloc();
+  if (key->index == TLS_OUT_OF_INDEXES) {
+    free(key);
+    return NULL;
+  }
+#else
+  if (pthread_key_create(&key->key, destructor) != 0) {
+    free(key);
+    return NULL;
+  }
+#endif
+
+  return key;
+}
+
+/****************************************
+ * cg_thread_key_delete
+ ****************************************/
+
+void cg_thread_key_delete(CGThreadKey* key)
+{
+  if (!key)
+    return;
+
+#if defined(WIN32) && !defined(ITRON)
+  TlsFree(key->index);
+#else
+  pthread_key_delete(key->key);
+#endif
+
+  free(key);
+}
+
+/****************************************
+ * cg_thread_key_setvalue
+ ****************************************/
+
+bool cg_thread_key_setvalue(CGThreadKey* key, void* value)
+{
+  if (!key)
+    return false;
+
+#if defined(WIN32) && !defined(ITRON)
+  return TlsSetValue(key->index, value) ? true : false;
+#else
+  return (pthread_setspecific(key->key, value) == 0) ? true : false;
+#endif
+}
+
+/****************************************
+ * cg_thread_key_getvalue
+ ****************************************/
+
+void* cg_thread_key_getvalue(CGThreadKey* key)
+{
+  if (!key)
+    return NULL;
+
+#if defined(WIN32) && !defined(ITRON)
+  return TlsGetValue(key->index);
+#else
+  return pthread_getspecific(key->key);
+#endif
+}
@@ -16,6 +16,7 @@
  *
  ******************************************************************/
 
+#include <cgpr/util/_atomic.h>
 #include <cgpr/util/thread.h>
 
 /****************************************
@@ -35,6 +36,20 @@ CGThreadList* cg_threadlist_new(void)
   threadList->runnableFlag = false;
   threadList->action = NULL;
   threadList->userData = NULL;
+  threadList->joinable = false;
+  threadList->joinPending = false;
+  threadList->exitFlag = true;
+  threadList->affinity = NULL;
+  threadList->numaNode = CG_CPU_NODE_NONE;
+  threadList->niceValue = 0;
+  threadList->niceFlag = false;
+  threadList->schedPolicy = CG_THREAD_SCHED_OTHER;
+  threadList->schedPriority = 0;
+#if !defined(WIN32)
+  threadList->stopFds[0] = -1;
+  threadList->stopFds[1] = -1;
+  threadList->tid = 0;
+#endif
 
   return threadList;
 }
@@ -82,9 +97,16 @@ bool cg_threadlist_stop(CGThreadList* threadList)
   if (!threadList)
     return false;
 
+  /* All threads are asked first, so the waits below overlap */
+  for (thread = cg_threadlist_gets(threadList); thread != NULL;
+       thread = cg_thread_next(thread)) {
+    if (cg_atomic_load(&thread->runnableFlag, CG_ATOMIC_ACQUIRE))
+      cg_thread_signalstop(thread);
+  }
+
   for (thread = cg_threadlist_gets(threadList); thread != NULL;
        thread = cg_thread_next(thread))
-    cg_thread_stop(thread);
+    cg_thread_join(thread, CG_THREAD_MIN_SLEEP);
 
   return true;
 }
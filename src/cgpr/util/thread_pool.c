@@ -0,0 +1,666 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/thread_pool.h>
+#include <cgpr/util/time.h>
+
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+/****************************************
+ * Define
+ ****************************************/
+
+#define CG_THREAD_POOL_STOP_WAIT 10
+
+#if defined(WIN32)
+#define CG_THREAD_POOL_TLS __declspec(thread)
+#else
+#define CG_THREAD_POOL_TLS __thread
+#endif
+
+/****************************************
+ * static variable
+ ****************************************/
+
+/* The worker running on the current thread, so that nested submits go to its own deque */
+static CG_THREAD_POOL_TLS CGThreadPoolWorker* _gThreadPoolWorker = NULL;
+
+/****************************************
+ * cg_thread_pool_taskarray_new
+ ****************************************/
+
+static CGThreadPoolTaskArray* cg_thread_pool_taskarray_new(int64_t capacity)
+{
+  CGThreadPoolTaskArray* array;
+
+  array = (CGThreadPoolTaskArray*)malloc(sizeof(CGThreadPoolTaskArray) + ((size_t)(capacity - 1) * sizeof(CGThreadPoolTask)));
+  if (!array)
+    return NULL;
+
+  array->capacity = capacity;
+  array->retired = NULL;
+
+  return array;
+}
+
+/****************************************
+ * cg_thread_pool_taskarray_delete
+ ****************************************/
+
+static void cg_thread_pool_taskarray_delete(CGThreadPoolTaskArray* array)
+{
+  CGThreadPoolTaskArray* retired;
+
+  while (array) {
+    retired = array->retired;
+    free(array);
+    array = retired;
+  }
+}
+
+/****************************************
+ * cg_thread_pool_taskarray_set
+ ****************************************/
+
+static void cg_thread_pool_taskarray_set(CGThreadPoolTaskArray* array, int64_t idx, CG_THREAD_POOL_FUNC func, void* userData)
+{
+  CGThreadPoolTask* task;
+
+  task = &array->tasks[idx & (array->capacity - 1)];
+  cg_atomic_store(&task->func, func, CG_ATOMIC_RELAXED);
+  cg_atomic_store(&task->userData, userData, CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_thread_pool_taskarray_get
+ ****************************************/
+
+static void cg_thread_pool_taskarray_get(CGThreadPoolTaskArray* array, int64_t idx, CGThreadPoolTask* task)
+{
+  CGThreadPoolTask* arrayTask;
+
+  arrayTask = &array->tasks[idx & (array->capacity - 1)];
+  task->func = cg_atomic_load(&arrayTask->func, CG_ATOMIC_RELAXED);
+  task->userData = cg_atomic_load(&arrayTask->userData, CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_thread_pool_deque_push
+ ****************************************/
+
+static bool cg_thread_pool_deque_push(CGThreadPoolDeque* deque, CG_THREAD_POOL_FUNC func, void* userData)
+{
+  CGThreadPoolTaskArray* array;
+  CGThreadPoolTaskArray* newArray;
+  int64_t top;
+  int64_t bottom;
+  int64_t idx;
+
+  bottom = cg_atomic_load(&deque->bottom, CG_ATOMIC_RELAXED);
+  top = cg_atomic_load(&deque->top, CG_ATOMIC_ACQUIRE);
+  array = cg_atomic_load(&deque->array, CG_ATOMIC_RELAXED);
+
+  if ((array->capacity - 1) < (bottom - top)) {
+    newArray = cg_thread_pool_taskarray_new(array->capacity * 2);
+    if (!newArray)
+      return false;
+    for (idx = top; idx < bottom; idx++)
+      newArray->tasks[idx & (newArray->capacity - 1)] = array->tasks[idx & (array->capacity - 1)];
+    newArray->retired = array;
+    cg_atomic_store(&deque->array, newArray, CG_ATOMIC_RELEASE);
+    array = newArray;
+  }
+
+  cg_thread_pool_taskarray_set(array, bottom, func, userData);
+  cg_atomic_fence(CG_ATOMIC_RELEASE);
+  cg_atomic_store(&deque->bottom, bottom + 1, CG_ATOMIC_RELAXED);
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_pool_deque_take
+ ****************************************/
+
+static bool cg_thread_pool_deque_take(CGThreadPoolDeque* deque, CGThreadPoolTask* task)
+{
+  CGThreadPoolTaskArray* array;
+  int64_t top;
+  int64_t bottom;
+  bool isTaken;
+
+  bottom = cg_atomic_load(&deque->bottom, CG_ATOMIC_RELAXED) - 1;
+  array = cg_atomic_load(&deque->array, CG_ATOMIC_RELAXED);
+  cg_atomic_store(&deque->bottom, bottom, CG_ATOMIC_RELAXED);
+  cg_atomic_fence(CG_ATOMIC_SEQ_CST);
+  top = cg_atomic_load(&deque->top, CG_ATOMIC_RELAXED);
+
+  if (bottom < top) {
+    cg_atomic_store(&deque->bottom, bottom + 1, CG_ATOMIC_RELAXED);
+    return false;
+  }
+
+  cg_thread_pool_taskarray_get(array, bottom, task);
+  if (top < bottom)
+    return true;
+
+  /* The last task is raced for with the thieves */
+  isTaken = cg_atomic_cas(&deque->top, &top, top + 1, CG_ATOMIC_SEQ_CST);
+  cg_atomic_store(&deque->bottom, bottom + 1, CG_ATOMIC_RELAXED);
+
+  return isTaken;
+}
+
+/****************************************
+ * cg_thread_pool_deque_steal
+ ****************************************/
+
+static bool cg_thread_pool_deque_steal(CGThreadPoolDeque* deque, CGThreadPoolTask* task)
+{
+  CGThreadPoolTaskArray* array;
+  int64_t top;
+  int64_t bottom;
+
+  top = cg_atomic_load(&deque->top, CG_ATOMIC_ACQUIRE);
+  cg_atomic_fence(CG_ATOMIC_SEQ_CST);
+  bottom = cg_atomic_load(&deque->bottom, CG_ATOMIC_ACQUIRE);
+
+  if (bottom <= top)
+    return false;
+
+  array = cg_atomic_load(&deque->array, CG_ATOMIC_ACQUIRE);
+  cg_thread_pool_taskarray_get(array, top, task);
+
+  return cg_atomic_cas(&deque->top, &top, top + 1, CG_ATOMIC_SEQ_CST);
+}
+
+/****************************************
+ * cg_thread_pool_deque_isempty
+ ****************************************/
+
+static bool cg_thread_pool_deque_isempty(CGThreadPoolDeque* deque)
+{
+  return (cg_atomic_load(&deque->bottom, CG_ATOMIC_RELAXED) <= cg_atomic_load(&deque->top, CG_ATOMIC_RELAXED)) ? true : false;
+}
+
+/****************************************
+ * cg_thread_pool_new
+ ****************************************/
+
+CGThreadPool* cg_thread_pool_new(size_t workerCnt)
+{
+  CGThreadPool* pool;
+  size_t n;
+
+  pool = (CGThreadPool*)calloc(1, sizeof(CGThreadPool));
+  if (!pool)
+    return NULL;
+
+  pool->wakePipe[0] = pool->wakePipe[1] = -1;
+  pool->donePipe[0] = pool->donePipe[1] = -1;
+
+  pool->workerCnt = (0 < workerCnt) ? workerCnt : cg_cpu_getonlinecount();
+  pool->workers = (CGThreadPoolWorker*)calloc(pool->workerCnt, sizeof(CGThreadPoolWorker));
+  pool->mutex = cg_mutex_new();
+  pool->queueCapacity = CG_THREAD_POOL_QUEUE_INITIAL_CAPACITY;
+  pool->queue = (CGThreadPoolTask*)malloc(pool->queueCapacity * sizeof(CGThreadPoolTask));
+  if (!pool->workers || !pool->mutex || !pool->queue || (pipe(pool->wakePipe) != 0) || (pipe(pool->donePipe) != 0)) {
+    cg_thread_pool_delete(pool);
+    return NULL;
+  }
+  fcntl(pool->wakePipe[0], F_SETFL, fcntl(pool->wakePipe[0], F_GETFL, 0) | O_NONBLOCK);
+  fcntl(pool->wakePipe[1], F_SETFL, fcntl(pool->wakePipe[1], F_GETFL, 0) | O_NONBLOCK);
+  fcntl(pool->donePipe[1], F_SETFL, fcntl(pool->donePipe[1], F_GETFL, 0) | O_NONBLOCK);
+
+  for (n = 0; n < pool->workerCnt; n++) {
+    pool->workers[n].pool = pool;
+    pool->workers[n].randState = n + 1;
+    pool->workers[n].deque.array = cg_thread_pool_taskarray_new(CG_THREAD_POOL_DEQUE_INITIAL_CAPACITY);
+    if (!pool->workers[n].deque.array) {
+      cg_thread_pool_delete(pool);
+      return NULL;
+    }
+  }
+
+  return pool;
+}
+
+/****************************************
+ * cg_thread_pool_delete
+ ****************************************/
+
+void cg_thread_pool_delete(CGThreadPool* pool)
+{
+  size_t n;
+
+  if (!pool)
+    return;
+
+  cg_thread_pool_stop(pool);
+
+  for (n = 0; pool->workers && (n < pool->workerCnt); n++)
+    cg_thread_pool_taskarray_delete(pool->workers[n].deque.array);
+  free(pool->workers);
+
+  for (n = 0; n < 2; n++) {
+    if (0 <= pool->wakePipe[n])
+      close(pool->wakePipe[n]);
+    if (0 <= pool->donePipe[n])
+      close(pool->donePipe[n]);
+  }
+
+  if (pool->mutex)
+    cg_mutex_delete(pool->mutex);
+  free(pool->queue);
+  free(pool);
+}
+
+/****************************************
+ * cg_thread_pool_pushqueue
+ ****************************************/
+
+static bool cg_thread_pool_pushqueue(CGThreadPool* pool, CG_THREAD_POOL_FUNC func, void* userData)
+{
+  CGThreadPoolTask* queue;
+  size_t queueCapacity;
+  size_t n;
+
+  cg_mutex_lock(pool->mutex);
+
+  if (pool->queueCapacity <= pool->queueCnt) {
+    queueCapacity = pool->queueCapacity * 2;
+    queue = (CGThreadPoolTask*)malloc(queueCapacity * sizeof(CGThreadPoolTask));
+    if (!queue) {
+      cg_mutex_unlock(pool->mutex);
+      return false;
+    }
+    for (n = 0; n < pool->queueCnt; n++)
+      queue[n] = pool->queue[(pool->queueHead + n) % pool->queueCapacity];
+    free(pool->queue);
+    pool->queue = queue;
+    pool->queueHead = 0;
+    pool->queueCapacity = queueCapacity;
+  }
+
+  queue = &pool->queue[(pool->queueHead + pool->queueCnt) % pool->queueCapacity];
+  queue->func = func;
+  queue->userData = userData;
+  cg_atomic_store(&pool->queueCnt, pool->queueCnt + 1, CG_ATOMIC_RELAXED);
+
+  cg_mutex_unlock(pool->mutex);
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_pool_popqueue
+ ****************************************/
+
+static bool cg_thread_pool_popqueue(CGThreadPool* pool, CGThreadPoolTask* task)
+{
+  if (cg_atomic_load(&pool->queueCnt, CG_ATOMIC_RELAXED) <= 0)
+    return false;
+
+  cg_mutex_lock(pool->mutex);
+
+  if (pool->queueCnt <= 0) {
+    cg_mutex_unlock(pool->mutex);
+    return false;
+  }
+
+  *task = pool->queue[pool->queueHead];
+  pool->queueHead = (pool->queueHead + 1) % pool->queueCapacity;
+  cg_atomic_store(&pool->queueCnt, pool->queueCnt - 1, CG_ATOMIC_RELAXED);
+
+  cg_mutex_unlock(pool->mutex);
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_pool_haswork
+ ****************************************/
+
+static bool cg_thread_pool_haswork(CGThreadPool* pool)
+{
+  size_t n;
+
+  if (0 < cg_atomic_load(&pool->queueCnt, CG_ATOMIC_RELAXED))
+    return true;
+
+  for (n = 0; n < pool->workerCnt; n++) {
+    if (!cg_thread_pool_deque_isempty(&pool->workers[n].deque))
+      return true;
+  }
+
+  return false;
+}
+
+/****************************************
+ * cg_thread_pool_findtask
+ ****************************************/
+
+static bool cg_thread_pool_findtask(CGThreadPoolWorker* worker, CGThreadPoolTask* task)
+{
+  CGThreadPool* pool;
+  size_t startIdx;
+  size_t victimIdx;
+  size_t n;
+
+  pool = worker->pool;
+
+  if (cg_thread_pool_deque_take(&worker->deque, task))
+    return true;
+
+  if (cg_thread_pool_popqueue(pool, task))
+    return true;
+
+  /* Victims are visited from a random worker so that thieves spread out */
+  worker->randState ^= worker->randState << 13;
+  worker->randState ^= worker->randState >> 7;
+  worker->randState ^= worker->randState << 17;
+  startIdx = (size_t)(worker->randState % pool->workerCnt);
+
+  for (n = 0; n < pool->workerCnt; n++) {
+    victimIdx = (startIdx + n) % pool->workerCnt;
+    if (&pool->workers[victimIdx] == worker)
+      continue;
+    if (cg_thread_pool_deque_steal(&pool->workers[victimIdx].deque, task))
+      return true;
+  }
+
+  return false;
+}
+
+/****************************************
+ * cg_thread_pool_notify
+ ****************************************/
+
+static void cg_thread_pool_notify(int fd, int wakeCnt)
+{
+  char wakeBytes[64];
+  ssize_t writtenLen;
+  int n;
+
+  /* One byte per reader to wake. The write end is non-blocking and a full pipe already wakes every reader */
+  memset(wakeBytes, 0, sizeof(wakeBytes));
+  for (n = 0; n < wakeCnt; n += (int)writtenLen) {
+    writtenLen = write(fd, wakeBytes, ((size_t)(wakeCnt - n) < sizeof(wakeBytes)) ? (size_t)(wakeCnt - n) : sizeof(wakeBytes));
+    if (writtenLen <= 0)
+      break;
+  }
+}
+
+/****************************************
+ * cg_thread_pool_runtask
+ ****************************************/
+
+static void cg_thread_pool_runtask(CGThreadPool* pool, CGThreadPoolTask* task)
+{
+  int waiterCnt;
+
+  task->func(task->userData);
+
+  if (cg_atomic_fetchsub(&pool->pendingCnt, 1, CG_ATOMIC_SEQ_CST) != 1)
+    return;
+
+  waiterCnt = cg_atomic_load(&pool->waiterCnt, CG_ATOMIC_SEQ_CST);
+  if (0 < waiterCnt)
+    cg_thread_pool_notify(pool->donePipe[1], waiterCnt);
+}
+
+/****************************************
+ * cg_thread_pool_action
+ ****************************************/
+
+static void cg_thread_pool_action(CGThread* thread)
+{
+  CGThreadPoolWorker* worker;
+  CGThreadPool* pool;
+  CGThreadPoolTask task;
+  struct pollfd pfds[2];
+  char wakeByte;
+
+  worker = (CGThreadPoolWorker*)cg_thread_getuserdata(thread);
+  pool = worker->pool;
+  _gThreadPoolWorker = worker;
+
+  /* The wake pipe is non-blocking, a worker which loses the byte to another one just looks for work again */
+  pfds[0].fd = pool->wakePipe[0];
+  pfds[0].events = POLLIN;
+  pfds[1].fd = cg_thread_getstopfd(thread);
+  pfds[1].events = POLLIN;
+
+  while (cg_thread_isrunnable(thread)) {
+    if (cg_thread_pool_findtask(worker, &task)) {
+      cg_thread_pool_runtask(pool, &task);
+      continue;
+    }
+
+    /* Announce the sleep before the last look, so that a submitter either sees the sleeper or the worker sees the task */
+    cg_atomic_fetchadd(&pool->sleeperCnt, 1, CG_ATOMIC_SEQ_CST);
+    cg_atomic_fence(CG_ATOMIC_SEQ_CST);
+    if (!cg_thread_pool_haswork(pool) && cg_thread_isrunnable(thread)) {
+      pfds[0].revents = pfds[1].revents = 0;
+      if ((0 < poll(pfds, 2, -1)) && (pfds[0].revents & POLLIN)) {
+        /* Another worker may have taken the byte already */
+        if (read(pool->wakePipe[0], &wakeByte, 1) != 1)
+          wakeByte = 0;
+      }
+    }
+    cg_atomic_fetchsub(&pool->sleeperCnt, 1, CG_ATOMIC_SEQ_CST);
+  }
+
+  _gThreadPoolWorker = NULL;
+}
+
+/****************************************
+ * cg_thread_pool_getpendingcount
+ ****************************************/
+
+size_t cg_thread_pool_getpendingcount(CGThreadPool* pool)
+{
+  if (!pool)
+    return 0;
+
+  return (size_t)cg_atomic_load(&pool->pendingCnt, CG_ATOMIC_RELAXED);
+}
+
+/****************************************
+ * cg_thread_pool_pinworkers
+ ****************************************/
+
+static bool cg_thread_pool_pinworkers(CGThreadPool* pool)
+{
+  CGCpuTopology* topology;
+  size_t coreCnt;
+  bool isSuccess;
+  int* cpus;
+  size_t n;
+
+  topology = cg_cpu_topology_new();
+  cpus = (int*)malloc(pool->workerCnt * sizeof(int));
+  if (!topology || !cpus) {
+    cg_cpu_topology_delete(topology);
+    free(cpus);
+    return false;
+  }
+
+  /* One worker per physical core, wrapping around when there are more workers than cores */
+  coreCnt = cg_cpu_topology_getcorecpus(topology, cpus, pool->workerCnt);
+  isSuccess = (0 < coreCnt) ? true : false;
+  for (n = 0; isSuccess && (n < pool->workerCnt); n++) {
+    if (!cg_thread_setcpu(pool->workers[n].thread, cpus[n % coreCnt]))
+      isSuccess = false;
+  }
+
+  cg_cpu_topology_delete(topology);
+  free(cpus);
+
+  return isSuccess;
+}
+
+/****************************************
+ * cg_thread_pool_start
+ ****************************************/
+
+bool cg_thread_pool_start(CGThreadPool* pool)
+{
+  CGThreadPoolWorker* worker;
+  size_t n;
+
+  if (!pool)
+    return false;
+
+  if (pool->running)
+    return true;
+
+  cg_atomic_store(&pool->running, true, CG_ATOMIC_RELEASE);
+
+  for (n = 0; n < pool->workerCnt; n++) {
+    worker = &pool->workers[n];
+    worker->thread = cg_thread_new();
+    if (!worker->thread) {
+      cg_thread_pool_stop(pool);
+      return false;
+    }
+    cg_thread_setaction(worker->thread, cg_thread_pool_action);
+    cg_thread_setuserdata(worker->thread, worker);
+    cg_thread_setjoinable(worker->thread, true);
+    if (!cg_thread_start(worker->thread)) {
+      cg_thread_pool_stop(pool);
+      return false;
+    }
+  }
+
+  if (pool->corePinned)
+    cg_thread_pool_pinworkers(pool);
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_pool_stop
+ ****************************************/
+
+bool cg_thread_pool_stop(CGThreadPool* pool)
+{
+  size_t n;
+
+  if (!pool)
+    return false;
+
+  if (!pool->running)
+    return true;
+
+  /* Queued tasks are drained first when a worker is left to run them, then new submissions are refused */
+  if ((0 < pool->workerCnt) && cg_thread_isrunnable(pool->workers[0].thread))
+    cg_thread_pool_wait(pool);
+  cg_atomic_store(&pool->running, false, CG_ATOMIC_RELEASE);
+
+  /* The stop tokens wake the sleeping workers */
+  for (n = 0; n < pool->workerCnt; n++) {
+    if (pool->workers[n].thread)
+      cg_thread_signalstop(pool->workers[n].thread);
+  }
+
+  /* A worker may still be in a long task, so the joins have no deadline */
+  for (n = 0; n < pool->workerCnt; n++) {
+    if (!pool->workers[n].thread)
+      continue;
+    while (!cg_thread_join(pool->workers[n].thread, CG_THREAD_POOL_STOP_WAIT))
+      ;
+    cg_thread_delete(pool->workers[n].thread);
+    pool->workers[n].thread = NULL;
+  }
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_pool_isrunning
+ ****************************************/
+
+bool cg_thread_pool_isrunning(CGThreadPool* pool)
+{
+  if (!pool)
+    return false;
+
+  return cg_atomic_load(&pool->running, CG_ATOMIC_ACQUIRE);
+}
+
+/****************************************
+ * cg_thread_pool_submit
+ ****************************************/
+
+bool cg_thread_pool_submit(CGThreadPool* pool, CG_THREAD_POOL_FUNC func, void* userData)
+{
+  CGThreadPoolWorker* worker;
+  bool isPushed;
+
+  if (!pool || !func || !cg_atomic_load(&pool->running, CG_ATOMIC_ACQUIRE))
+    return false;
+
+  cg_atomic_fetchadd(&pool->pendingCnt, 1, CG_ATOMIC_RELAXED);
+
+  worker = _gThreadPoolWorker;
+  if (worker && (worker->pool == pool))
+    isPushed = cg_thread_pool_deque_push(&worker->deque, func, userData);
+  else
+    isPushed = cg_thread_pool_pushqueue(pool, func, userData);
+
+  if (!isPushed) {
+    cg_atomic_fetchsub(&pool->pendingCnt, 1, CG_ATOMIC_SEQ_CST);
+    return false;
+  }
+
+  cg_atomic_fence(CG_ATOMIC_SEQ_CST);
+  if (0 < cg_atomic_load(&pool->sleeperCnt, CG_ATOMIC_RELAXED))
+    cg_thread_pool_notify(pool->wakePipe[1], 1);
+
+  return true;
+}
+
+/****************************************
+ * cg_thread_pool_wait
+ ****************************************/
+
+void cg_thread_pool_wait(CGThreadPool* pool)
+{
+  char doneByte;
+
+  if (!pool)
+    return;
+
+  /* Must not be called from a task of the pool, whose own pending count would never drop */
+  cg_atomic_fetchadd(&pool->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+  while (0 < cg_atomic_load(&pool->pendingCnt, CG_ATOMIC_SEQ_CST)) {
+    if (read(pool->donePipe[0], &doneByte, 1) != 1)
+      cg_wait(1);
+  }
+  cg_atomic_fetchsub(&pool->waiterCnt, 1, CG_ATOMIC_SEQ_CST);
+}
@@ -16,6 +16,7 @@
  *
  ******************************************************************/
 
+#include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -80,3 +81,42 @@ float cg_random(void)
 
   return (float)rand() / (float)RAND_MAX;
 }
+
+/****************************************
+ * cg_getmonotonicnanotime
+ ****************************************/
+
+uint64_t cg_getmonotonicnanotime(void)
+{
+#if defined(WIN32)
+  LARGE_INTEGER freq;
+  LARGE_INTEGER counter;
+
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&counter);
+  return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)freq.QuadPart);
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/****************************************
+ * cg_waitnano
+ ****************************************/
+
+void cg_waitnano(uint64_t nsec)
+{
+#if defined(WIN32)
+  Sleep((DWORD)((nsec + 999999) / 1000000));
+#else
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)(nsec / 1000000000ULL);
+  ts.tv_nsec = (long)(nsec % 1000000000ULL);
+  while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR)) {
+  }
+#endif
+}
@@ -45,3 +45,22 @@ BOOST_AUTO_TEST_CASE(Bytes)
     free(ibytes);
   }
 }
+
+BOOST_AUTO_TEST_CASE(BytesVarint)
+{
+  byte buf[CG_BYTES_VARINT_MAXSIZE];
+  uint64_t vals[] = { 0, 1, 0x7F, 0x80, 0x3FFF, 0x4000, 0xFFFFFFFF, 0xFFFFFFFFFFFFFFFFULL };
+  size_t lens[] = { 1, 1, 1, 2, 2, 3, 5, 10 };
+  uint64_t val;
+
+  for (size_t n = 0; n < (sizeof(vals) / sizeof(vals[0])); n++) {
+    BOOST_REQUIRE_EQUAL(cg_bytes_setvarint(buf, vals[n]), lens[n]);
+    BOOST_REQUIRE_EQUAL(cg_bytes_getvarint(buf, lens[n], &val), lens[n]);
+    BOOST_CHECK_EQUAL(val, vals[n]);
+    BOOST_CHECK_EQUAL(cg_bytes_getvarint(buf, lens[n] - 1, &val), 0);
+  }
+
+  BOOST_CHECK_EQUAL(cg_bytes_toint(cg_bytes_setint(buf, 0x1234, 2), 2), 0x1234);
+  BOOST_CHECK_EQUAL(buf[0], 0x12);
+  BOOST_CHECK_EQUAL(buf[1], 0x34);
+}
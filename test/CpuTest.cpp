@@ -0,0 +1,90 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/util/cpu.h>
+
+BOOST_AUTO_TEST_CASE(CpuSetTest)
+{
+  CGCpuSet cpuSet;
+
+  cg_cpuset_clear(&cpuSet);
+  BOOST_REQUIRE_EQUAL(cg_cpuset_size(&cpuSet), 0);
+  BOOST_REQUIRE(cg_cpuset_parselist(&cpuSet, "0-3,8,10-11\n"));
+  BOOST_REQUIRE_EQUAL(cg_cpuset_size(&cpuSet), 7);
+  BOOST_REQUIRE(cg_cpuset_contains(&cpuSet, 2));
+  BOOST_REQUIRE(cg_cpuset_contains(&cpuSet, 8));
+  BOOST_REQUIRE(cg_cpuset_contains(&cpuSet, 11));
+  BOOST_REQUIRE(!cg_cpuset_contains(&cpuSet, 9));
+
+  BOOST_REQUIRE(cg_cpuset_remove(&cpuSet, 8));
+  BOOST_REQUIRE(!cg_cpuset_contains(&cpuSet, 8));
+  BOOST_REQUIRE(!cg_cpuset_add(&cpuSet, CG_CPU_SET_MAXSIZE));
+
+  BOOST_REQUIRE(!cg_cpuset_parselist(&cpuSet, "3-1"));
+  BOOST_REQUIRE(!cg_cpuset_parselist(&cpuSet, "1;2"));
+}
+
+BOOST_AUTO_TEST_CASE(CpuTopologyTest)
+{
+  CGCpuTopology* topology = cg_cpu_topology_new();
+  BOOST_REQUIRE(topology);
+
+  size_t cpuCnt = cg_cpu_topology_size(topology);
+  BOOST_REQUIRE(0 < cpuCnt);
+  BOOST_REQUIRE(0 < cg_cpu_topology_getcorecount(topology));
+  BOOST_REQUIRE(cg_cpu_topology_getcorecount(topology) <= cpuCnt);
+  BOOST_REQUIRE(0 < cg_cpu_topology_getpackagecount(topology));
+
+  // One CPU per core and no two of them on the same core
+
+  int* cpus = new int[cpuCnt];
+  size_t coreCnt = cg_cpu_topology_getcorecpus(topology, cpus, cpuCnt);
+  BOOST_REQUIRE_EQUAL(coreCnt, cg_cpu_topology_getcorecount(topology));
+  for (size_t n = 0; n < coreCnt; n++) {
+    CGCpuInfo* cpuInfo = NULL;
+    for (size_t i = 0; i < cpuCnt; i++) {
+      if (cg_cpu_topology_getcpu(topology, i)->cpu == cpus[n])
+        cpuInfo = cg_cpu_topology_getcpu(topology, i);
+    }
+    BOOST_REQUIRE(cpuInfo);
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < cpuCnt; j++) {
+        CGCpuInfo* otherInfo = cg_cpu_topology_getcpu(topology, j);
+        if (otherInfo->cpu == cpus[i])
+          BOOST_CHECK(!((otherInfo->core == cpuInfo->core) && (otherInfo->package == cpuInfo->package)));
+      }
+    }
+  }
+  delete[] cpus;
+
+  // NUMA nodes cover the CPUs they report
+
+  for (size_t n = 0; n < cpuCnt; n++) {
+    CGCpuInfo* cpuInfo = cg_cpu_topology_getcpu(topology, n);
+    if (cpuInfo->node == CG_CPU_NODE_NONE)
+      continue;
+    CGCpuSet nodeSet;
+    BOOST_REQUIRE(cg_cpu_getnodecpus(cpuInfo->node, &nodeSet));
+    BOOST_CHECK(cg_cpuset_contains(&nodeSet, cpuInfo->cpu));
+  }
+
+  cg_cpu_topology_delete(topology);
+}
@@ -0,0 +1,283 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <errno.h>
+#include <string.h>
+
+#include <cgpr/net/socket.h>
+#include <cgpr/util/fiber.h>
+#include <cgpr/util/ring_buffer.h>
+
+#define CG_TEST_FIBER_CNT 3
+#define CG_TEST_FIBER_LOOP_CNT 3
+#define CG_TEST_FIBER_SLEEP 20
+#define CG_TEST_FIBER_ADDR "127.0.0.1"
+#define CG_TEST_FIBER_PORT 19111
+#define CG_TEST_FIBER_CLIENT_CNT 200
+#define CG_TEST_FIBER_MSG "hello fiber\n"
+
+typedef struct {
+  int order[CG_TEST_FIBER_CNT * CG_TEST_FIBER_LOOP_CNT];
+  int orderCnt;
+  int id;
+} CGTestFiberContext;
+
+typedef struct {
+  CGSocket* sock;
+  CGRingBuffer* ring;
+  ssize_t ringLen;
+} CGTestFiberRing;
+
+typedef struct {
+  CGSocket* sock;
+  ssize_t readLen;
+  int readErr;
+} CGTestFiberTimeout;
+
+typedef struct {
+  CGSocket* serverSock;
+  int acceptedCnt;
+  int echoedCnt;
+} CGTestFiberServer;
+
+static void cg_test_fiber_func(CGFiber* fiber)
+{
+  CGTestFiberContext* ctx = (CGTestFiberContext*)cg_fiber_getuserdata(fiber);
+  int id = ctx->id++;
+  for (int n = 0; n < CG_TEST_FIBER_LOOP_CNT; n++) {
+    ctx->order[ctx->orderCnt++] = id;
+    BOOST_CHECK(cg_fiber_yield());
+  }
+}
+
+static void cg_test_fiber_sleep(CGFiber* fiber)
+{
+  uint64_t* elapsedTime = (uint64_t*)cg_fiber_getuserdata(fiber);
+  uint64_t startTime = cg_getmonotonicnanotime();
+  cg_fiber_sleep(CG_TEST_FIBER_SLEEP);
+  *elapsedTime = cg_getmonotonicnanotime() - startTime;
+}
+
+static void cg_test_fiber_echo(CGFiber* fiber)
+{
+  CGSocket* sock = (CGSocket*)cg_fiber_getuserdata(fiber);
+  char buf[64];
+
+  ssize_t readLen = cg_socket_readline(sock, buf, sizeof(buf));
+  if (0 < readLen)
+    cg_socket_write(sock, buf, readLen);
+  cg_socket_delete(sock);
+}
+
+static void cg_test_fiber_accept(CGFiber* fiber)
+{
+  CGTestFiberServer* server = (CGTestFiberServer*)cg_fiber_getuserdata(fiber);
+  for (int n = 0; n < CG_TEST_FIBER_CLIENT_CNT; n++) {
+    CGSocket* clientSock = cg_socket_stream_new();
+    if (!cg_socket_accept(server->serverSock, clientSock)) {
+      cg_socket_delete(clientSock);
+      return;
+    }
+    server->acceptedCnt++;
+    cg_fiber_new(cg_fiber_getscheduler(fiber), cg_test_fiber_echo, clientSock);
+  }
+}
+
+static void cg_test_fiber_client(CGFiber* fiber)
+{
+  CGTestFiberServer* server = (CGTestFiberServer*)cg_fiber_getuserdata(fiber);
+  CGSocket* sock = cg_socket_stream_new();
+  char buf[64];
+
+  if (cg_socket_connect(sock, CG_TEST_FIBER_ADDR, CG_TEST_FIBER_PORT) && (cg_socket_write(sock, CG_TEST_FIBER_MSG, strlen(CG_TEST_FIBER_MSG)) == strlen(CG_TEST_FIBER_MSG))) {
+    if ((cg_socket_readline(sock, buf, sizeof(buf)) == (ssize_t)strlen(CG_TEST_FIBER_MSG)) && (strcmp(buf, CG_TEST_FIBER_MSG) == 0))
+      server->echoedCnt++;
+  }
+  cg_socket_delete(sock);
+}
+
+static void cg_test_fiber_readring(CGFiber* fiber)
+{
+  CGTestFiberRing* ctx = (CGTestFiberRing*)cg_fiber_getuserdata(fiber);
+  ctx->ringLen = cg_socket_readring(ctx->sock, ctx->ring);
+}
+
+static void cg_test_fiber_writering(CGFiber* fiber)
+{
+  CGTestFiberRing* ctx = (CGTestFiberRing*)cg_fiber_getuserdata(fiber);
+  cg_ring_buffer_write(ctx->ring, (const byte*)CG_TEST_FIBER_MSG, strlen(CG_TEST_FIBER_MSG));
+  ctx->ringLen = cg_socket_writering(ctx->sock, ctx->ring);
+}
+
+static void cg_test_fiber_readbyte(CGFiber* fiber)
+{
+  CGTestFiberRing* ctx = (CGTestFiberRing*)cg_fiber_getuserdata(fiber);
+  char buf[1];
+  ctx->ringLen = cg_socket_read(ctx->sock, buf, sizeof(buf));
+}
+
+static void cg_test_fiber_writebytes(CGFiber* fiber)
+{
+  CGTestFiberRing* ctx = (CGTestFiberRing*)cg_fiber_getuserdata(fiber);
+  cg_fiber_sleep(CG_TEST_FIBER_SLEEP);
+  ctx->ringLen = cg_socket_write(ctx->sock, "ab", 2);
+}
+
+static void cg_test_fiber_readtimeout(CGFiber* fiber)
+{
+  CGTestFiberTimeout* ctx = (CGTestFiberTimeout*)cg_fiber_getuserdata(fiber);
+  char buf[64];
+  ctx->readLen = cg_socket_read(ctx->sock, buf, sizeof(buf));
+  ctx->readErr = errno;
+}
+
+BOOST_AUTO_TEST_CASE(FiberTest)
+{
+  BOOST_REQUIRE(!cg_fiber_isactive());
+  BOOST_REQUIRE(!cg_fiber_yield());
+
+  CGFiberScheduler* scheduler = cg_fiber_scheduler_new();
+  BOOST_REQUIRE(scheduler);
+
+  // Yielding fibers take turns
+
+  CGTestFiberContext ctx;
+  ctx.orderCnt = 0;
+  ctx.id = 0;
+  for (int n = 0; n < CG_TEST_FIBER_CNT; n++)
+    BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_func, &ctx));
+  BOOST_REQUIRE_EQUAL(cg_fiber_scheduler_size(scheduler), CG_TEST_FIBER_CNT);
+  BOOST_REQUIRE(cg_fiber_scheduler_run(scheduler));
+  BOOST_REQUIRE_EQUAL(cg_fiber_scheduler_size(scheduler), 0);
+  BOOST_REQUIRE_EQUAL(ctx.orderCnt, CG_TEST_FIBER_CNT * CG_TEST_FIBER_LOOP_CNT);
+  for (int n = 0; n < ctx.orderCnt; n++)
+    BOOST_CHECK_EQUAL(ctx.order[n], n % CG_TEST_FIBER_CNT);
+
+  // Sleeping
+
+  uint64_t elapsedTime = 0;
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_sleep, &elapsedTime));
+  BOOST_REQUIRE(cg_fiber_scheduler_run(scheduler));
+  BOOST_CHECK((CG_TEST_FIBER_SLEEP * 1000000ULL) <= elapsedTime);
+
+  cg_fiber_scheduler_delete(scheduler);
+}
+
+BOOST_AUTO_TEST_CASE(FiberSocketTest)
+{
+  CGTestFiberServer server;
+  server.serverSock = cg_socket_stream_new();
+  server.acceptedCnt = 0;
+  server.echoedCnt = 0;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setreuseaddress(opt, true);
+  BOOST_REQUIRE(cg_socket_bind(server.serverSock, CG_TEST_FIBER_PORT, CG_TEST_FIBER_ADDR, opt));
+  BOOST_REQUIRE(cg_socket_listen(server.serverSock));
+
+  // Blocking style servers and clients share one thread
+
+  CGFiberScheduler* scheduler = cg_fiber_scheduler_new();
+  cg_fiber_scheduler_setstacksize(scheduler, 32 * 1024);
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_accept, &server));
+  for (int n = 0; n < CG_TEST_FIBER_CLIENT_CNT; n++)
+    BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_client, &server));
+  BOOST_REQUIRE(cg_fiber_scheduler_run(scheduler));
+
+  BOOST_CHECK_EQUAL(server.acceptedCnt, CG_TEST_FIBER_CLIENT_CNT);
+  BOOST_CHECK_EQUAL(server.echoedCnt, CG_TEST_FIBER_CLIENT_CNT);
+
+  cg_fiber_scheduler_delete(scheduler);
+  cg_socket_option_delete(opt);
+  cg_socket_delete(server.serverSock);
+}
+
+BOOST_AUTO_TEST_CASE(FiberRingTest)
+{
+  CGSocket* sock = cg_socket_stream_new();
+  CGSocket* peerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+
+  // The reader is scheduled first and has to yield until the writer runs
+
+  CGTestFiberRing reader = { peerSock, cg_ring_buffer_new(64), 0 };
+  CGTestFiberRing writer = { sock, cg_ring_buffer_new(64), 0 };
+  CGFiberScheduler* scheduler = cg_fiber_scheduler_new();
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_readring, &reader));
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_writering, &writer));
+  BOOST_REQUIRE(cg_fiber_scheduler_run(scheduler));
+
+  BOOST_CHECK_EQUAL(writer.ringLen, (ssize_t)strlen(CG_TEST_FIBER_MSG));
+  BOOST_CHECK_EQUAL(reader.ringLen, (ssize_t)strlen(CG_TEST_FIBER_MSG));
+
+  cg_fiber_scheduler_delete(scheduler);
+  cg_ring_buffer_delete(reader.ring);
+  cg_ring_buffer_delete(writer.ring);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+}
+
+BOOST_AUTO_TEST_CASE(FiberSharedFdTest)
+{
+  CGSocket* sock = cg_socket_stream_new();
+  CGSocket* peerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+
+  // Two fibers wait on the same descriptor and both are woken by its data
+
+  CGTestFiberRing readers[2] = { { peerSock, NULL, 0 }, { peerSock, NULL, 0 } };
+  CGTestFiberRing writer = { sock, NULL, 0 };
+  CGFiberScheduler* scheduler = cg_fiber_scheduler_new();
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_readbyte, &readers[0]));
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_readbyte, &readers[1]));
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_writebytes, &writer));
+  BOOST_REQUIRE(cg_fiber_scheduler_run(scheduler));
+
+  BOOST_CHECK_EQUAL(writer.ringLen, 2);
+  BOOST_CHECK_EQUAL(readers[0].ringLen, 1);
+  BOOST_CHECK_EQUAL(readers[1].ringLen, 1);
+
+  cg_fiber_scheduler_delete(scheduler);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+}
+
+BOOST_AUTO_TEST_CASE(FiberSocketTimeoutTest)
+{
+  CGSocket* sock = cg_socket_stream_new();
+  CGSocket* peerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+  BOOST_REQUIRE(cg_socket_settimeout(peerSock, 1));
+
+  // Nobody writes, so the read gives up after the socket timeout like a blocking one
+
+  CGTestFiberTimeout reader = { peerSock, 0, 0 };
+  CGFiberScheduler* scheduler = cg_fiber_scheduler_new();
+  BOOST_REQUIRE(cg_fiber_new(scheduler, cg_test_fiber_readtimeout, &reader));
+  BOOST_REQUIRE(cg_fiber_scheduler_run(scheduler));
+
+  BOOST_CHECK_LT(reader.readLen, 0);
+  BOOST_CHECK((reader.readErr == EAGAIN) || (reader.readErr == EWOULDBLOCK));
+
+  cg_fiber_scheduler_delete(scheduler);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+}
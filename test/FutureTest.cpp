@@ -0,0 +1,161 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdint.h>
+
+#include <cgpr/util/future.h>
+
+#define CG_TEST_FUTURE_CNT 64
+#define CG_TEST_FUTURE_ERROR 5
+
+static void* cg_test_future_square(void* userData)
+{
+  intptr_t n = (intptr_t)userData;
+  return (void*)(n * n);
+}
+
+static void* cg_test_future_inc(CGFuture* future, void* userData)
+{
+  int* callCnt = (int*)userData;
+  __atomic_fetch_add(callCnt, 1, __ATOMIC_RELAXED);
+  return (void*)((intptr_t)cg_future_getvalue(future) + 1);
+}
+
+static void cg_test_future_setvalue(CGThread* thread)
+{
+  CGPromise* promise = (CGPromise*)cg_thread_getuserdata(thread);
+  cg_wait(50);
+  cg_promise_setvalue(promise, (void*)1);
+}
+
+BOOST_AUTO_TEST_CASE(PromiseTest)
+{
+  CGPromise* promise = cg_promise_new(NULL);
+  BOOST_REQUIRE(promise);
+  CGFuture* future = cg_promise_getfuture(promise);
+  BOOST_REQUIRE(!cg_future_isready(future));
+  BOOST_REQUIRE(!cg_future_timedwait(future, 10));
+
+  // A value set by another thread wakes the waiter
+
+  CGThread* thread = cg_thread_new();
+  cg_thread_setaction(thread, cg_test_future_setvalue);
+  cg_thread_setuserdata(thread, promise);
+  cg_thread_setjoinable(thread, true);
+  BOOST_REQUIRE(cg_thread_start(thread));
+  BOOST_REQUIRE(cg_future_timedwait(future, 5000));
+  BOOST_REQUIRE(cg_future_isfulfilled(future));
+  BOOST_REQUIRE_EQUAL((intptr_t)cg_future_getvalue(future), 1);
+  BOOST_REQUIRE(!cg_promise_setvalue(promise, (void*)2));
+  BOOST_REQUIRE(!cg_promise_seterror(promise, CG_TEST_FUTURE_ERROR));
+  cg_thread_delete(thread);
+
+  cg_promise_delete(promise);
+  cg_future_delete(future);
+
+  // A promise deleted before it is settled breaks its future
+
+  promise = cg_promise_new(NULL);
+  future = cg_promise_getfuture(promise);
+  cg_promise_delete(promise);
+  BOOST_REQUIRE(cg_future_wait(future));
+  BOOST_REQUIRE(cg_future_isrejected(future));
+  BOOST_REQUIRE_EQUAL(cg_future_geterror(future), CG_FUTURE_ERROR_BROKEN);
+  cg_future_delete(future);
+}
+
+BOOST_AUTO_TEST_CASE(FutureTest)
+{
+  CGThreadPool* pool = cg_thread_pool_new(4);
+  BOOST_REQUIRE(cg_thread_pool_start(pool));
+
+  // Fan out and fan in
+
+  CGFuture* futures[CG_TEST_FUTURE_CNT];
+  for (intptr_t n = 0; n < CG_TEST_FUTURE_CNT; n++) {
+    futures[n] = cg_future_run(pool, cg_test_future_square, (void*)n);
+    BOOST_REQUIRE(futures[n]);
+  }
+  CGFuture* allFuture = cg_future_whenall(futures, CG_TEST_FUTURE_CNT, pool);
+  BOOST_REQUIRE(allFuture);
+  BOOST_REQUIRE(cg_future_timedwait(allFuture, 5000));
+  BOOST_REQUIRE(cg_future_isfulfilled(allFuture));
+  intptr_t sum = 0;
+  for (intptr_t n = 0; n < CG_TEST_FUTURE_CNT; n++) {
+    BOOST_REQUIRE(cg_future_isready(futures[n]));
+    sum += (intptr_t)cg_future_getvalue(futures[n]);
+    cg_future_delete(futures[n]);
+  }
+  BOOST_REQUIRE_EQUAL(sum, (CG_TEST_FUTURE_CNT - 1) * CG_TEST_FUTURE_CNT * (2 * CG_TEST_FUTURE_CNT - 1) / 6);
+  cg_future_delete(allFuture);
+
+  // Continuations
+
+  int callCnt = 0;
+  CGFuture* future = cg_future_run(pool, cg_test_future_square, (void*)3);
+  CGFuture* nextFuture = cg_future_then(future, cg_test_future_inc, &callCnt);
+  CGFuture* lastFuture = cg_future_then(nextFuture, cg_test_future_inc, &callCnt);
+  BOOST_REQUIRE_EQUAL((intptr_t)cg_future_getvalue(lastFuture), 11);
+  BOOST_REQUIRE_EQUAL(callCnt, 2);
+  cg_future_delete(lastFuture);
+  cg_future_delete(nextFuture);
+  cg_future_delete(future);
+
+  // A rejection skips the continuation and is passed on
+
+  CGPromise* promise = cg_promise_new(pool);
+  future = cg_promise_getfuture(promise);
+  nextFuture = cg_future_then(future, cg_test_future_inc, &callCnt);
+  BOOST_REQUIRE(cg_promise_seterror(promise, CG_TEST_FUTURE_ERROR));
+  BOOST_REQUIRE(cg_future_wait(nextFuture));
+  BOOST_REQUIRE(cg_future_isrejected(nextFuture));
+  BOOST_REQUIRE_EQUAL(cg_future_geterror(nextFuture), CG_TEST_FUTURE_ERROR);
+  BOOST_REQUIRE(cg_future_getvalue(nextFuture) == NULL);
+  BOOST_REQUIRE_EQUAL(callCnt, 2);
+  cg_future_delete(nextFuture);
+  cg_future_delete(future);
+  cg_promise_delete(promise);
+
+  // The first settled future wins
+
+  CGPromise* promises[2];
+  for (int n = 0; n < 2; n++) {
+    promises[n] = cg_promise_new(pool);
+    futures[n] = cg_promise_getfuture(promises[n]);
+  }
+  CGFuture* anyFuture = cg_future_whenany(futures, 2, pool);
+  allFuture = cg_future_whenall(futures, 2, pool);
+  BOOST_REQUIRE(!cg_future_timedwait(anyFuture, 10));
+  BOOST_REQUIRE(cg_promise_setvalue(promises[1], NULL));
+  BOOST_REQUIRE(cg_future_getvalue(anyFuture) == futures[1]);
+  BOOST_REQUIRE(!cg_future_isready(allFuture));
+  BOOST_REQUIRE(cg_promise_seterror(promises[0], CG_TEST_FUTURE_ERROR));
+  BOOST_REQUIRE(cg_future_wait(allFuture));
+  BOOST_REQUIRE_EQUAL(cg_future_geterror(allFuture), CG_TEST_FUTURE_ERROR);
+  cg_future_delete(allFuture);
+  cg_future_delete(anyFuture);
+  for (int n = 0; n < 2; n++) {
+    cg_future_delete(futures[n]);
+    cg_promise_delete(promises[n]);
+  }
+
+  cg_thread_pool_delete(pool);
+}
@@ -0,0 +1,75 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/net/multicast_sender.h>
+
+#define CG_TEST_MULTICAST_ADDR "239.255.255.100"
+#define CG_TEST_MULTICAST_PORT 19100
+#define CG_TEST_MULTICAST_MSG "hello multicast"
+
+BOOST_AUTO_TEST_CASE(MulticastSenderTest)
+{
+  CGNetworkInterfaceList* netIfList = cg_net_interfacelist_new();
+  BOOST_REQUIRE(0 < cg_net_gethostinterfaces(netIfList));
+
+  CGMulticastSender* sender = cg_multicast_sender_new();
+  BOOST_REQUIRE(sender);
+  BOOST_REQUIRE(cg_multicast_sender_setloop(sender, true));
+  BOOST_REQUIRE(cg_multicast_sender_setttl(sender, 1));
+  BOOST_REQUIRE_EQUAL(cg_multicast_sender_getttl(sender), 1);
+
+  // Only the IPv4 interfaces, the receiver is joined on the first one
+
+  CGNetworkInterface* netIf = NULL;
+  for (CGNetworkInterface* ipv4If = cg_net_interfacelist_gets(netIfList); ipv4If; ipv4If = cg_net_interface_next(ipv4If)) {
+    if (cg_net_isipv6address(cg_net_interface_getaddress(ipv4If)))
+      continue;
+    BOOST_REQUIRE(cg_multicast_sender_addinterface(sender, ipv4If));
+    if (!netIf)
+      netIf = ipv4If;
+  }
+  BOOST_REQUIRE(netIf);
+
+  CGSocket* sock = cg_socket_dgram_new();
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setreuseaddress(opt, true);
+  BOOST_REQUIRE(cg_socket_bind(sock, CG_TEST_MULTICAST_PORT, "0.0.0.0", opt));
+  BOOST_REQUIRE(cg_socket_joingroup(sock, CG_TEST_MULTICAST_ADDR, cg_net_interface_getaddress(netIf)));
+  BOOST_REQUIRE(cg_socket_settimeout(sock, 1));
+
+  size_t sentCnt = cg_multicast_sender_sendto(sender, CG_TEST_MULTICAST_ADDR, CG_TEST_MULTICAST_PORT, (const byte*)CG_TEST_MULTICAST_MSG, strlen(CG_TEST_MULTICAST_MSG));
+  BOOST_REQUIRE_EQUAL(sentCnt, cg_multicast_sender_size(sender));
+
+  CGDatagramPacket* dgmPkt = cg_socket_datagram_packet_new();
+  BOOST_REQUIRE_EQUAL(cg_socket_recv(sock, dgmPkt), (ssize_t)strlen(CG_TEST_MULTICAST_MSG));
+  BOOST_REQUIRE(memcmp(cg_socket_datagram_packet_getdata(dgmPkt), CG_TEST_MULTICAST_MSG, strlen(CG_TEST_MULTICAST_MSG)) == 0);
+
+  // IPv6 groups are not sent on IPv4 interfaces
+
+  BOOST_REQUIRE_EQUAL(cg_multicast_sender_sendto(sender, "ff02::c", CG_TEST_MULTICAST_PORT, (const byte*)CG_TEST_MULTICAST_MSG, strlen(CG_TEST_MULTICAST_MSG)), 0);
+
+  cg_socket_datagram_packet_delete(dgmPkt);
+  cg_socket_option_delete(opt);
+  cg_socket_delete(sock);
+  cg_multicast_sender_delete(sender);
+  cg_net_interfacelist_delete(netIfList);
+}
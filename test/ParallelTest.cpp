@@ -0,0 +1,119 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdint.h>
+
+#include <cgpr/util/parallel.h>
+
+#define CG_TEST_PARALLEL_SIZE 100000
+#define CG_TEST_PARALLEL_ROW_CNT 16
+#define CG_TEST_PARALLEL_COL_CNT 1000
+
+typedef struct {
+  CGThreadPool* pool;
+  uint64_t* values;
+} CGTestParallelContext;
+
+static void cg_test_parallel_fill(size_t begin, size_t end, void* userData)
+{
+  uint64_t* values = (uint64_t*)userData;
+  for (size_t n = begin; n < end; n++)
+    values[n] = n * 2;
+}
+
+static void cg_test_parallel_sum(size_t begin, size_t end, void* partial, void* userData)
+{
+  uint64_t* values = (uint64_t*)userData;
+  for (size_t n = begin; n < end; n++)
+    *(uint64_t*)partial += values[n];
+}
+
+static void cg_test_parallel_add(void* result, const void* partial, void* userData)
+{
+  *(uint64_t*)result += *(const uint64_t*)partial;
+}
+
+static void cg_test_parallel_fillrow(size_t begin, size_t end, void* userData)
+{
+  CGTestParallelContext* ctx = (CGTestParallelContext*)userData;
+  for (size_t row = begin; row < end; row++)
+    cg_parallel_for(ctx->pool, 0, CG_TEST_PARALLEL_COL_CNT, 10, cg_test_parallel_fill, ctx->values + (row * CG_TEST_PARALLEL_COL_CNT));
+}
+
+BOOST_AUTO_TEST_CASE(ParallelTest)
+{
+  CGThreadPool* pool = cg_thread_pool_new(4);
+  BOOST_REQUIRE(cg_thread_pool_start(pool));
+
+  uint64_t* values = new uint64_t[CG_TEST_PARALLEL_SIZE];
+
+  BOOST_REQUIRE(cg_parallel_for(pool, 0, CG_TEST_PARALLEL_SIZE, CG_PARALLEL_GRAIN_AUTO, cg_test_parallel_fill, values));
+  for (size_t n = 0; n < CG_TEST_PARALLEL_SIZE; n++)
+    BOOST_REQUIRE_EQUAL(values[n], n * 2);
+
+  // Reductions with automatic, fixed and uneven grain sizes
+
+  uint64_t expected = (uint64_t)(CG_TEST_PARALLEL_SIZE - 1) * CG_TEST_PARALLEL_SIZE;
+  size_t grainSizes[] = { CG_PARALLEL_GRAIN_AUTO, 1000, 7, CG_TEST_PARALLEL_SIZE * 2 };
+  for (size_t n = 0; n < sizeof(grainSizes) / sizeof(grainSizes[0]); n++) {
+    uint64_t sum = 0;
+    uint64_t identity = 0;
+    BOOST_REQUIRE(cg_parallel_reduce(pool, 0, CG_TEST_PARALLEL_SIZE, grainSizes[n], &sum, &identity, sizeof(sum), cg_test_parallel_sum, cg_test_parallel_add, values));
+    BOOST_REQUIRE_EQUAL(sum, expected);
+  }
+
+  // Subranges and empty ranges
+
+  uint64_t sum = 0;
+  uint64_t identity = 0;
+  BOOST_REQUIRE(cg_parallel_reduce(pool, 10, 20, 3, &sum, &identity, sizeof(sum), cg_test_parallel_sum, cg_test_parallel_add, values));
+  BOOST_REQUIRE_EQUAL(sum, 290);
+  BOOST_REQUIRE(cg_parallel_for(pool, 5, 5, 1, cg_test_parallel_fill, values));
+
+  // Nested loops on the same pool
+
+  for (size_t n = 0; n < CG_TEST_PARALLEL_SIZE; n++)
+    values[n] = 0;
+  CGTestParallelContext ctx;
+  ctx.pool = pool;
+  ctx.values = values;
+  BOOST_REQUIRE(cg_parallel_for(pool, 0, CG_TEST_PARALLEL_ROW_CNT, 1, cg_test_parallel_fillrow, &ctx));
+  for (size_t row = 0; row < CG_TEST_PARALLEL_ROW_CNT; row++) {
+    for (size_t col = 0; col < CG_TEST_PARALLEL_COL_CNT; col++)
+      BOOST_REQUIRE_EQUAL(values[(row * CG_TEST_PARALLEL_COL_CNT) + col], col * 2);
+  }
+
+  // A stopped pool runs everything on the caller
+
+  BOOST_REQUIRE(cg_thread_pool_stop(pool));
+  sum = 0;
+  BOOST_REQUIRE(cg_parallel_reduce(pool, 0, CG_TEST_PARALLEL_SIZE, 100, &sum, &identity, sizeof(sum), cg_test_parallel_sum, cg_test_parallel_add, values));
+  BOOST_REQUIRE(0 < sum);
+  cg_thread_pool_delete(pool);
+
+  // The default pool
+
+  BOOST_REQUIRE(cg_parallel_getdefaultpool());
+  BOOST_REQUIRE(cg_parallel_for(NULL, 0, CG_TEST_PARALLEL_SIZE, CG_PARALLEL_GRAIN_AUTO, cg_test_parallel_fill, values));
+  BOOST_REQUIRE_EQUAL(values[CG_TEST_PARALLEL_SIZE - 1], (CG_TEST_PARALLEL_SIZE - 1) * 2);
+
+  delete[] values;
+}
@@ -0,0 +1,93 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/net/interface.h>
+
+static void cg_test_prefixtable_addinterface(CGNetworkInterfaceList* netIfList, const char* addr, const char* netmask)
+{
+  CGNetworkInterface* netIf = cg_net_interface_new();
+  cg_net_interface_setaddress(netIf, (char*)addr);
+  cg_net_interface_setnetmask(netIf, (char*)netmask);
+  cg_net_interfacelist_add(netIfList, netIf);
+}
+
+static bool cg_test_prefixtable_lookup(CGNetworkPrefixTable* table, const char* remoteAddr, char* addrBuf, size_t addrBufLen)
+{
+  struct sockaddr_storage ss;
+  memset(&ss, 0, sizeof(ss));
+  if (inet_pton(AF_INET, remoteAddr, &((struct sockaddr_in*)&ss)->sin_addr) == 1) {
+    ss.ss_family = AF_INET;
+  }
+  else if (inet_pton(AF_INET6, remoteAddr, &((struct sockaddr_in6*)&ss)->sin6_addr) == 1) {
+    ss.ss_family = AF_INET6;
+  }
+  return cg_net_prefixtable_lookup(table, (struct sockaddr*)&ss, addrBuf, addrBufLen, NULL);
+}
+
+BOOST_AUTO_TEST_CASE(PrefixTableTest)
+{
+  char addr[CG_NET_ADDRSTRING_MAXSIZE];
+
+  CGNetworkPrefixTable* table = cg_net_prefixtable_new();
+  BOOST_REQUIRE(table);
+  BOOST_REQUIRE(!cg_test_prefixtable_lookup(table, "10.1.2.3", addr, sizeof(addr)));
+
+  CGNetworkInterfaceList* netIfList = cg_net_interfacelist_new();
+  cg_test_prefixtable_addinterface(netIfList, "169.254.10.1", "255.255.0.0");
+  cg_test_prefixtable_addinterface(netIfList, "192.168.1.10", "255.255.255.0");
+  cg_test_prefixtable_addinterface(netIfList, "10.0.0.5", "255.0.0.0");
+  cg_test_prefixtable_addinterface(netIfList, "10.1.0.5", "255.255.0.0");
+  cg_test_prefixtable_addinterface(netIfList, "fd00::2", "ffff:ffff:ffff:ffff::");
+  cg_test_prefixtable_addinterface(netIfList, "fd00:0:0:1::2", "ffff:ffff:ffff:ffff::");
+
+  BOOST_REQUIRE(cg_net_prefixtable_setinterfaces(table, netIfList));
+  BOOST_REQUIRE_EQUAL(cg_net_prefixtable_size(table), 6);
+
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "10.1.2.3", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "10.1.0.5");
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "10.2.0.1", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "10.0.0.5");
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "192.168.1.99", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "192.168.1.10");
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "169.254.3.4", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "169.254.10.1");
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "172.16.0.1", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "192.168.1.10");
+
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "fd00::99", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "fd00::2");
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "fd00:0:0:1::99", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "fd00:0:0:1::2");
+
+  cg_net_interfacelist_clear(netIfList);
+  cg_test_prefixtable_addinterface(netIfList, "172.16.0.1", "255.240.0.0");
+  BOOST_REQUIRE(cg_net_prefixtable_setinterfaces(table, netIfList));
+  BOOST_REQUIRE_EQUAL(cg_net_prefixtable_size(table), 1);
+  BOOST_REQUIRE(cg_test_prefixtable_lookup(table, "10.1.2.3", addr, sizeof(addr)));
+  BOOST_CHECK_EQUAL(addr, "172.16.0.1");
+  BOOST_REQUIRE(!cg_test_prefixtable_lookup(table, "fd00::99", addr, sizeof(addr)));
+
+  BOOST_REQUIRE(cg_net_prefixtable_update(table));
+
+  cg_net_interfacelist_delete(netIfList);
+  cg_net_prefixtable_delete(table);
+}
@@ -0,0 +1,52 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/util/rwlock.h>
+#include <cgpr/util/thread.h>
+
+BOOST_AUTO_TEST_CASE(RWLockTest)
+{
+  CGRWLock* locks[] = { cg_rwlock_new(), cg_rwlock_writerpreferred_new() };
+
+  for (CGRWLock* lock : locks) {
+    BOOST_REQUIRE(lock);
+
+    // Readers share the lock and keep writers out
+
+    BOOST_REQUIRE(cg_rwlock_readlock(lock));
+    BOOST_REQUIRE(cg_rwlock_tryreadlock(lock));
+    BOOST_REQUIRE(!cg_rwlock_trywritelock(lock));
+    BOOST_REQUIRE(cg_rwlock_readunlock(lock));
+    BOOST_REQUIRE(cg_rwlock_readunlock(lock));
+
+    // A writer holds the lock alone
+
+    BOOST_REQUIRE(cg_rwlock_writelock(lock));
+    BOOST_REQUIRE(!cg_rwlock_tryreadlock(lock));
+    BOOST_REQUIRE(!cg_rwlock_trywritelock(lock));
+    BOOST_REQUIRE(cg_rwlock_writeunlock(lock));
+
+    BOOST_REQUIRE(cg_rwlock_trywritelock(lock));
+    BOOST_REQUIRE(cg_rwlock_writeunlock(lock));
+
+    BOOST_REQUIRE(cg_rwlock_delete(lock));
+  }
+}
@@ -0,0 +1,117 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+#include <unistd.h>
+
+#include <cgpr/util/ring_buffer.h>
+
+static void cg_test_ring_buffer(CGRingBuffer* ring)
+{
+  byte data[64];
+  byte buf[64];
+  size_t regionLen;
+
+  for (size_t n = 0; n < sizeof(data); n++)
+    data[n] = (byte)n;
+
+  BOOST_REQUIRE(cg_ring_buffer_isempty(ring));
+  size_t capacity = cg_ring_buffer_getcapacity(ring);
+  BOOST_REQUIRE_EQUAL(capacity & (capacity - 1), 0);
+
+  // Leave one byte just before the end so that the next write wraps
+
+  size_t fillLen = capacity - 8;
+  for (size_t n = 0; n < fillLen; n += sizeof(data))
+    cg_ring_buffer_write(ring, data, ((fillLen - n) < sizeof(data)) ? (fillLen - n) : sizeof(data));
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_getsize(ring), fillLen);
+  cg_ring_buffer_consume(ring, fillLen - 1);
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_getsize(ring), 1);
+
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_write(ring, data, 32), 32);
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_getsize(ring), 33);
+
+  byte* region = cg_ring_buffer_getreadregion(ring, &regionLen);
+  if (cg_ring_buffer_ismirrored(ring)) {
+    BOOST_CHECK_EQUAL(regionLen, 33);
+    BOOST_CHECK(memcmp(region + 1, data, 32) == 0);
+  }
+  else {
+    BOOST_CHECK_EQUAL(regionLen, 9);
+  }
+
+  struct iovec iov[2];
+  int iovCnt = cg_ring_buffer_getreadvec(ring, iov);
+  BOOST_CHECK_EQUAL(iovCnt, cg_ring_buffer_ismirrored(ring) ? 1 : 2);
+  cg_ring_buffer_consume(ring, 1);
+
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_peek(ring, buf, sizeof(buf)), 32);
+  BOOST_CHECK(memcmp(buf, data, 32) == 0);
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_read(ring, buf, 10), 10);
+  BOOST_CHECK(memcmp(buf, data, 10) == 0);
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_read(ring, buf, sizeof(buf)), 22);
+  BOOST_CHECK(memcmp(buf, data + 10, 22) == 0);
+  BOOST_REQUIRE(cg_ring_buffer_isempty(ring));
+
+  // Pipe round trip through readv/writev
+
+  int fds[2];
+  BOOST_REQUIRE_EQUAL(pipe(fds), 0);
+  BOOST_REQUIRE_EQUAL(write(fds[1], data, sizeof(data)), (ssize_t)sizeof(data));
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_readfd(ring, fds[0]), (ssize_t)sizeof(data));
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_writefd(ring, fds[1]), (ssize_t)sizeof(data));
+  BOOST_REQUIRE(cg_ring_buffer_isempty(ring));
+  BOOST_REQUIRE_EQUAL(read(fds[0], buf, sizeof(buf)), (ssize_t)sizeof(data));
+  BOOST_CHECK(memcmp(buf, data, sizeof(data)) == 0);
+  close(fds[0]);
+  close(fds[1]);
+
+  // Full buffer
+
+  cg_ring_buffer_clear(ring);
+  while (!cg_ring_buffer_isfull(ring))
+    cg_ring_buffer_write(ring, data, sizeof(data));
+  BOOST_CHECK_EQUAL(cg_ring_buffer_getfreesize(ring), 0);
+  BOOST_CHECK_EQUAL(cg_ring_buffer_write(ring, data, 1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RingBufferTest)
+{
+  CGRingBuffer* ring = cg_ring_buffer_new(1000);
+  BOOST_REQUIRE(ring);
+  BOOST_REQUIRE_EQUAL(cg_ring_buffer_getcapacity(ring), 1024);
+  BOOST_REQUIRE(!cg_ring_buffer_ismirrored(ring));
+  cg_test_ring_buffer(ring);
+  cg_ring_buffer_delete(ring);
+
+  ring = cg_ring_buffer_mirrored_new(1000);
+  BOOST_REQUIRE(ring);
+#if defined(__linux__)
+  BOOST_CHECK(cg_ring_buffer_ismirrored(ring));
+#endif
+  cg_test_ring_buffer(ring);
+  cg_ring_buffer_delete(ring);
+
+  // Capacities which cannot be rounded up to a power of two
+
+  BOOST_CHECK(!cg_ring_buffer_new(CG_RING_BUFFER_CAPACITY_MAX + 1));
+  BOOST_CHECK(!cg_ring_buffer_new(SIZE_MAX));
+  BOOST_CHECK(!cg_ring_buffer_mirrored_new(SIZE_MAX));
+}
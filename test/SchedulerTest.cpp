@@ -0,0 +1,163 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/scheduler.h>
+
+#define CG_TEST_SCHEDULER_TIMER_NUM 2000
+#define CG_TEST_SCHEDULER_MAX_DELAY 600
+#define CG_TEST_SCHEDULER_WAIT_LOOP 300
+
+typedef struct {
+  uint64_t scheduledTime;
+  clock_t delay;
+  uint64_t firedTime;
+  int fireCnt;
+} CGTestSchedulerTimerData;
+
+static void cg_test_scheduler_timer_func(CGSchedulerTimer* timer, void* userData)
+{
+  CGTestSchedulerTimerData* data = (CGTestSchedulerTimerData*)userData;
+  data->firedTime = cg_getmonotonicnanotime();
+  cg_atomic_inc(&data->fireCnt);
+}
+
+static void cg_test_scheduler_selfdelete_func(CGSchedulerTimer* timer, void* userData)
+{
+  cg_atomic_inc((int*)userData);
+  cg_scheduler_timer_delete(timer);
+}
+
+BOOST_AUTO_TEST_CASE(SchedulerPollTest)
+{
+  CGScheduler* sched = cg_scheduler_new();
+  BOOST_REQUIRE(sched);
+  BOOST_REQUIRE_EQUAL(cg_scheduler_getresolution(sched), CG_SCHEDULER_DEFAULT_RESOLUTION);
+
+  CGTestSchedulerTimerData onceData = {};
+  CGTestSchedulerTimerData everyData = {};
+  CGTestSchedulerTimerData cancelData = {};
+  CGSchedulerTimer* onceTimer = cg_scheduler_timer_new(cg_test_scheduler_timer_func, &onceData);
+  CGSchedulerTimer* everyTimer = cg_scheduler_timer_new(cg_test_scheduler_timer_func, &everyData);
+  CGSchedulerTimer* cancelTimer = cg_scheduler_timer_new(cg_test_scheduler_timer_func, &cancelData);
+
+  uint64_t startTime = cg_getmonotonicnanotime();
+  BOOST_REQUIRE(cg_scheduler_scheduleonce(sched, onceTimer, 30));
+  BOOST_REQUIRE(cg_scheduler_scheduleevery(sched, everyTimer, 10, 10));
+  BOOST_REQUIRE(cg_scheduler_scheduleonce(sched, cancelTimer, 20));
+  BOOST_REQUIRE(!cg_scheduler_scheduleevery(sched, everyTimer, 10, 0));
+  BOOST_REQUIRE_EQUAL(cg_scheduler_size(sched), 3);
+  BOOST_REQUIRE(cg_scheduler_timer_ispending(cancelTimer));
+  BOOST_REQUIRE(cg_scheduler_cancel(sched, cancelTimer));
+  BOOST_REQUIRE(!cg_scheduler_cancel(sched, cancelTimer));
+  BOOST_REQUIRE_EQUAL(cg_scheduler_size(sched), 2);
+
+  // Nothing fires before it is due
+
+  BOOST_CHECK_EQUAL(cg_scheduler_poll(sched), 0);
+
+  for (int n = 0; n < CG_TEST_SCHEDULER_WAIT_LOOP && (onceData.fireCnt == 0 || everyData.fireCnt < 5); n++) {
+    cg_wait(5);
+    cg_scheduler_poll(sched);
+  }
+  BOOST_CHECK_EQUAL(onceData.fireCnt, 1);
+  BOOST_CHECK((startTime + 30 * 1000000ULL) <= onceData.firedTime);
+  BOOST_CHECK(5 <= everyData.fireCnt);
+  BOOST_CHECK_EQUAL(cancelData.fireCnt, 0);
+  BOOST_CHECK(!cg_scheduler_timer_ispending(onceTimer));
+  BOOST_CHECK(cg_scheduler_timer_ispending(everyTimer));
+  BOOST_CHECK_EQUAL(cg_scheduler_size(sched), 1);
+
+  // A timer beyond the first wheel level is cascaded down
+
+  onceData.fireCnt = 0;
+  startTime = cg_getmonotonicnanotime();
+  BOOST_REQUIRE(cg_scheduler_scheduleonce(sched, onceTimer, 300));
+  BOOST_REQUIRE(cg_scheduler_reschedule(sched, onceTimer, 350));
+  for (int n = 0; n < CG_TEST_SCHEDULER_WAIT_LOOP && onceData.fireCnt == 0; n++) {
+    cg_wait(5);
+    cg_scheduler_poll(sched);
+  }
+  BOOST_CHECK_EQUAL(onceData.fireCnt, 1);
+  BOOST_CHECK((startTime + 350 * 1000000ULL) <= onceData.firedTime);
+
+  // Resolution changes only while nothing is pending
+
+  BOOST_CHECK(!cg_scheduler_setresolution(sched, 10));
+  BOOST_REQUIRE(cg_scheduler_cancel(sched, everyTimer));
+  BOOST_CHECK(cg_scheduler_setresolution(sched, 10));
+  BOOST_CHECK_EQUAL(cg_scheduler_getresolution(sched), 10);
+
+  cg_scheduler_timer_delete(onceTimer);
+  cg_scheduler_timer_delete(everyTimer);
+  cg_scheduler_timer_delete(cancelTimer);
+  cg_scheduler_delete(sched);
+}
+
+BOOST_AUTO_TEST_CASE(SchedulerThreadTest)
+{
+  CGScheduler* sched = cg_scheduler_new();
+  BOOST_REQUIRE(sched);
+  BOOST_REQUIRE(cg_scheduler_start(sched));
+  BOOST_REQUIRE(cg_scheduler_isrunning(sched));
+
+  // Many timers share the scheduler thread and none of them fires early
+
+  static CGTestSchedulerTimerData timerData[CG_TEST_SCHEDULER_TIMER_NUM];
+  static CGSchedulerTimer timers[CG_TEST_SCHEDULER_TIMER_NUM];
+  for (int n = 0; n < CG_TEST_SCHEDULER_TIMER_NUM; n++) {
+    timerData[n].delay = (clock_t)((n * 7919) % CG_TEST_SCHEDULER_MAX_DELAY);
+    timerData[n].fireCnt = 0;
+    cg_scheduler_timer_init(&timers[n], cg_test_scheduler_timer_func, &timerData[n]);
+    timerData[n].scheduledTime = cg_getmonotonicnanotime();
+    BOOST_REQUIRE(cg_scheduler_scheduleonce(sched, &timers[n], timerData[n].delay));
+  }
+
+  for (int n = 0; n < CG_TEST_SCHEDULER_WAIT_LOOP && 0 < cg_scheduler_size(sched); n++)
+    cg_wait(10);
+  BOOST_REQUIRE_EQUAL(cg_scheduler_size(sched), 0);
+
+  for (int n = 0; n < CG_TEST_SCHEDULER_TIMER_NUM; n++) {
+    BOOST_REQUIRE_EQUAL(cg_atomic_load(&timerData[n].fireCnt, CG_ATOMIC_ACQUIRE), 1);
+    BOOST_REQUIRE((timerData[n].scheduledTime + (uint64_t)timerData[n].delay * 1000000ULL) <= timerData[n].firedTime);
+  }
+
+  // A periodic timer runs until it is cancelled and may delete itself
+
+  CGTestSchedulerTimerData everyData = {};
+  CGSchedulerTimer* everyTimer = cg_scheduler_timer_new(cg_test_scheduler_timer_func, &everyData);
+  BOOST_REQUIRE(cg_scheduler_scheduleevery(sched, everyTimer, 0, 5));
+  int selfDeleteCnt = 0;
+  CGSchedulerTimer* selfDeleteTimer = cg_scheduler_timer_new(cg_test_scheduler_selfdelete_func, &selfDeleteCnt);
+  BOOST_REQUIRE(cg_scheduler_scheduleevery(sched, selfDeleteTimer, 5, 5));
+
+  for (int n = 0; n < CG_TEST_SCHEDULER_WAIT_LOOP && cg_atomic_load(&everyData.fireCnt, CG_ATOMIC_ACQUIRE) < 5; n++)
+    cg_wait(10);
+  BOOST_CHECK(5 <= cg_atomic_load(&everyData.fireCnt, CG_ATOMIC_ACQUIRE));
+  BOOST_CHECK_EQUAL(cg_atomic_load(&selfDeleteCnt, CG_ATOMIC_ACQUIRE), 1);
+
+  BOOST_REQUIRE(cg_scheduler_cancel(sched, everyTimer));
+  cg_scheduler_timer_delete(everyTimer);
+
+  BOOST_REQUIRE(cg_scheduler_stop(sched));
+  BOOST_REQUIRE(!cg_scheduler_isrunning(sched));
+  cg_scheduler_delete(sched);
+}
@@ -0,0 +1,108 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/util/scratch.h>
+#include <cgpr/util/thread.h>
+
+#define CG_TEST_SCRATCH_BLOCK_SIZE 256
+#define CG_TEST_SCRATCH_LOOP_NUM 1000
+
+BOOST_AUTO_TEST_CASE(ScratchTest)
+{
+  CGScratch* scratch = cg_scratch_new();
+  BOOST_REQUIRE(scratch);
+  cg_scratch_setblocksize(scratch, CG_TEST_SCRATCH_BLOCK_SIZE);
+  BOOST_REQUIRE_EQUAL(cg_scratch_getcapacity(scratch), 0);
+
+  // Allocations are aligned and do not overlap
+
+  byte* buf1 = (byte*)cg_scratch_alloc(scratch, 3);
+  byte* buf2 = (byte*)cg_scratch_alloc(scratch, 5);
+  BOOST_REQUIRE(buf1 && buf2);
+  BOOST_CHECK_EQUAL(((uintptr_t)buf1 % CG_SCRATCH_ALIGNMENT), 0);
+  BOOST_CHECK_EQUAL(((uintptr_t)buf2 % CG_SCRATCH_ALIGNMENT), 0);
+  BOOST_CHECK(buf1 + 3 <= buf2);
+
+  char* str = cg_scratch_strdup(scratch, "hello");
+  BOOST_REQUIRE(str);
+  BOOST_CHECK_EQUAL(str, "hello");
+
+  // Restoring a mark rewinds, so the same memory is handed out again
+
+  CGScratchMark mark = cg_scratch_mark(scratch);
+  void* buf3 = cg_scratch_alloc(scratch, 16);
+  cg_scratch_restore(scratch, mark);
+  BOOST_CHECK_EQUAL(cg_scratch_alloc(scratch, 16), buf3);
+  cg_scratch_restore(scratch, mark);
+
+  // Requests larger than a block spill into new blocks which are kept after a restore
+
+  void* bigBuf = cg_scratch_alloc(scratch, CG_TEST_SCRATCH_BLOCK_SIZE * 4);
+  BOOST_REQUIRE(bigBuf);
+  memset(bigBuf, 0, CG_TEST_SCRATCH_BLOCK_SIZE * 4);
+  size_t capacity = cg_scratch_getcapacity(scratch);
+  BOOST_CHECK((CG_TEST_SCRATCH_BLOCK_SIZE * 5) <= capacity);
+  BOOST_CHECK_EQUAL(str, "hello");
+  cg_scratch_restore(scratch, mark);
+
+  for (int n = 0; n < CG_TEST_SCRATCH_LOOP_NUM; n++) {
+    CGScratchMark loopMark = cg_scratch_mark(scratch);
+    BOOST_REQUIRE(cg_scratch_alloc(scratch, 100));
+    BOOST_REQUIRE(cg_scratch_alloc(scratch, CG_TEST_SCRATCH_BLOCK_SIZE * 4));
+    cg_scratch_restore(scratch, loopMark);
+  }
+  BOOST_CHECK_EQUAL(cg_scratch_getcapacity(scratch), capacity);
+
+  cg_scratch_reset(scratch);
+  BOOST_CHECK_EQUAL(cg_scratch_alloc(scratch, 3), buf1);
+
+  cg_scratch_delete(scratch);
+}
+
+void cg_test_scratch_thread_func(CGThread* thread)
+{
+  CGScratch** scratch = (CGScratch**)cg_thread_getuserdata(thread);
+  *scratch = cg_scratch_get();
+  cg_scratch_alloc(*scratch, CG_SCRATCH_BLOCK_DEFAULT_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(ScratchThreadTest)
+{
+  CGScratch* scratch = cg_scratch_get();
+  BOOST_REQUIRE(scratch);
+  BOOST_CHECK_EQUAL(cg_scratch_get(), scratch);
+
+  // Every thread has its own arena which is released at exit
+
+  CGScratch* threadScratch = NULL;
+  CGThread* thread = cg_thread_new();
+  cg_thread_setaction(thread, cg_test_scratch_thread_func);
+  cg_thread_setuserdata(thread, &threadScratch);
+  cg_thread_setjoinable(thread, true);
+  BOOST_REQUIRE(cg_thread_start(thread));
+  BOOST_REQUIRE(cg_thread_join(thread, 10000));
+  cg_thread_delete(thread);
+
+  BOOST_CHECK(threadScratch);
+  BOOST_CHECK(threadScratch != scratch);
+}
@@ -0,0 +1,109 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/seqlock.h>
+#include <cgpr/util/thread.h>
+
+#define CG_TEST_SEQLOCK_WRITE_NUM 20000
+#define CG_TEST_SEQLOCK_READER_NUM 2
+
+typedef struct {
+  uint64_t values[4];
+  uint64_t sum;
+} CGTestSeqLockSnapshot;
+
+typedef struct {
+  CGSeqLock lock;
+  CGTestSeqLockSnapshot snapshot;
+  int done;
+  int tornCnt;
+  int readCnt;
+} CGTestSeqLockData;
+
+void cg_test_seqlock_reader_func(CGThread* thread)
+{
+  CGTestSeqLockData* data = (CGTestSeqLockData*)cg_thread_getuserdata(thread);
+  CGTestSeqLockSnapshot snapshot;
+
+  while (!cg_atomic_load(&data->done, CG_ATOMIC_ACQUIRE)) {
+    cg_seqlock_read(&data->lock, &data->snapshot, &snapshot, sizeof(snapshot));
+    if ((snapshot.values[0] + snapshot.values[1] + snapshot.values[2] + snapshot.values[3]) != snapshot.sum)
+      cg_atomic_inc(&data->tornCnt);
+    cg_atomic_inc(&data->readCnt);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SeqLockTest)
+{
+  CGSeqLock* lock = cg_seqlock_new();
+  BOOST_REQUIRE(lock);
+
+  unsigned int seq = cg_seqlock_readbegin(lock);
+  BOOST_REQUIRE(!cg_seqlock_readretry(lock, seq));
+  cg_seqlock_writebegin(lock);
+  BOOST_REQUIRE(cg_seqlock_getsequence(lock) & 1);
+  cg_seqlock_writeend(lock);
+  BOOST_REQUIRE(cg_seqlock_readretry(lock, seq));
+  BOOST_REQUIRE(cg_seqlock_delete(lock));
+
+  // Readers never see a half written snapshot
+
+  static CGTestSeqLockData data;
+  cg_seqlock_init(&data.lock);
+  data.done = 0;
+  data.tornCnt = 0;
+  data.readCnt = 0;
+
+  CGThreadList* readers = cg_threadlist_new();
+  for (int n = 0; n < CG_TEST_SEQLOCK_READER_NUM; n++) {
+    CGThread* thread = cg_thread_new();
+    cg_thread_setaction(thread, cg_test_seqlock_reader_func);
+    cg_thread_setuserdata(thread, &data);
+    cg_thread_setjoinable(thread, true);
+    cg_threadlist_add(readers, thread);
+  }
+  BOOST_REQUIRE(cg_threadlist_start(readers));
+
+  CGTestSeqLockSnapshot snapshot;
+  for (uint64_t n = 1; n <= CG_TEST_SEQLOCK_WRITE_NUM; n++) {
+    snapshot.sum = 0;
+    for (int i = 0; i < 4; i++) {
+      snapshot.values[i] = n * (i + 1);
+      snapshot.sum += snapshot.values[i];
+    }
+    cg_seqlock_write(&data.lock, &data.snapshot, &snapshot, sizeof(snapshot));
+    if ((n % 1000) == 0)
+      cg_wait(1);
+  }
+
+  cg_atomic_store(&data.done, 1, CG_ATOMIC_RELEASE);
+  for (CGThread* thread = cg_threadlist_gets(readers); thread; thread = cg_thread_next(thread))
+    BOOST_REQUIRE(cg_thread_join(thread, 10000));
+  cg_threadlist_delete(readers);
+
+  BOOST_CHECK_EQUAL(data.tornCnt, 0);
+  BOOST_CHECK(0 < data.readCnt);
+
+  cg_seqlock_read(&data.lock, &data.snapshot, &snapshot, sizeof(snapshot));
+  BOOST_CHECK_EQUAL(snapshot.values[0], CG_TEST_SEQLOCK_WRITE_NUM);
+  BOOST_CHECK_EQUAL(snapshot.sum, CG_TEST_SEQLOCK_WRITE_NUM * 10ULL);
+}
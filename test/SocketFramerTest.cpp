@@ -0,0 +1,103 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/net/socket_framer.h>
+
+BOOST_AUTO_TEST_CASE(SocketFramerTest)
+{
+  const char* testAddr = "127.0.0.1";
+  int testPort = 19106;
+  int lengthTypes[] = { CG_NET_SOCKET_FRAMER_UINT16, CG_NET_SOCKET_FRAMER_UINT32, CG_NET_SOCKET_FRAMER_VARINT };
+  const char* testMsgs[] = { "", "a", "hello", "framed message" };
+  const byte* frame;
+  byte bigData[1000];
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocket* clientSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_connect(clientSock, testAddr, testPort));
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+  BOOST_REQUIRE(cg_socket_settimeout(acceptSock, 1));
+
+  memset(bigData, 'x', sizeof(bigData));
+
+  for (size_t i = 0; i < (sizeof(lengthTypes) / sizeof(lengthTypes[0])); i++) {
+    CGSocketFramer* writer = cg_socket_framer_new(clientSock, lengthTypes[i]);
+    CGSocketFramer* reader = cg_socket_framer_new(acceptSock, lengthTypes[i]);
+    BOOST_REQUIRE(writer);
+    BOOST_REQUIRE(reader);
+    BOOST_REQUIRE(cg_socket_framer_setsendbuffersize(writer, 256));
+
+    // Small frames are coalesced until flushed
+
+    for (size_t n = 0; n < (sizeof(testMsgs) / sizeof(testMsgs[0])); n++)
+      BOOST_REQUIRE(cg_socket_framer_write(writer, (const byte*)testMsgs[n], strlen(testMsgs[n])));
+    BOOST_REQUIRE(0 < cg_socket_framer_getpendingsize(writer));
+    cg_socket_resetstats(clientSock);
+    BOOST_REQUIRE(cg_socket_framer_write(writer, bigData, sizeof(bigData)));
+    BOOST_REQUIRE(cg_socket_framer_flush(writer));
+
+    // The pending frames are flushed, then the large frame goes out in one gathered write
+
+    CGSocketStats stats;
+    cg_socket_getstats(clientSock, &stats);
+    BOOST_CHECK_EQUAL(stats.writeCnt, 2);
+    BOOST_REQUIRE_EQUAL(cg_socket_framer_getpendingsize(writer), 0);
+
+    for (size_t n = 0; n < (sizeof(testMsgs) / sizeof(testMsgs[0])); n++) {
+      BOOST_REQUIRE_EQUAL(cg_socket_framer_read(reader, &frame), (ssize_t)strlen(testMsgs[n]));
+      BOOST_CHECK(memcmp(frame, testMsgs[n], strlen(testMsgs[n])) == 0);
+    }
+    BOOST_REQUIRE_EQUAL(cg_socket_framer_read(reader, &frame), (ssize_t)sizeof(bigData));
+    BOOST_CHECK(memcmp(frame, bigData, sizeof(bigData)) == 0);
+
+    // A header split across two segments
+
+    byte header[16];
+    size_t headerLen = cg_socket_framer_encodeheader(writer, header, 300);
+    BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, (const char*)header, 1), 1);
+    BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, (const char*)header + 1, headerLen - 1), headerLen - 1);
+    BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, (const char*)bigData, 300), 300);
+    BOOST_REQUIRE_EQUAL(cg_socket_framer_read(reader, &frame), 300);
+    BOOST_CHECK_EQUAL(cg_socket_framer_getbufferedsize(reader), 0);
+
+    // Oversized frames are rejected
+
+    BOOST_REQUIRE(cg_socket_framer_setmaxframesize(writer, 100));
+    BOOST_REQUIRE(!cg_socket_framer_write(writer, bigData, sizeof(bigData)));
+
+    cg_socket_framer_delete(reader);
+    cg_socket_framer_delete(writer);
+  }
+
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(clientSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
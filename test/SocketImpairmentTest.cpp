@@ -0,0 +1,180 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+#include <sys/socket.h>
+
+#include <cgpr/net/socket_impairment.h>
+#include <cgpr/util/time.h>
+
+#define CG_TEST_IMPAIRMENT_PKT_CNT 100
+
+static void cg_test_impairment_waitpending(CGSocketImpairment* imp)
+{
+  for (int n = 0; (n < 200) && (0 < cg_socket_impairment_getpendingsize(imp)); n++)
+    cg_wait(10);
+}
+
+BOOST_AUTO_TEST_CASE(SocketImpairmentTest)
+{
+  const char* testMsg = "hello impairment";
+  char buf[64];
+
+  CGSocketImpairment* imp = cg_socket_impairment_new();
+  BOOST_REQUIRE(imp);
+  BOOST_REQUIRE(cg_socket_impairment_start(imp));
+  BOOST_REQUIRE(cg_socket_impairment_isrunning(imp));
+
+  // Stream pair with a fixed delay
+
+  CGSocket* sock = cg_socket_stream_new();
+  CGSocket* peerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+  BOOST_REQUIRE(!cg_socket_pair(sock, peerSock));
+  BOOST_REQUIRE(cg_socket_settimeout(peerSock, 5));
+
+  cg_socket_impairment_setdelay(imp, 20000);
+  cg_socket_setimpairment(sock, imp);
+  uint64_t startTime = cg_getmonotonicnanotime();
+  BOOST_REQUIRE_EQUAL(cg_socket_write(sock, testMsg, strlen(testMsg)), strlen(testMsg));
+  BOOST_REQUIRE_EQUAL(cg_socket_read(peerSock, buf, sizeof(buf)), (ssize_t)strlen(testMsg));
+  BOOST_CHECK(20000000ULL <= (cg_getmonotonicnanotime() - startTime));
+  BOOST_CHECK(memcmp(buf, testMsg, strlen(testMsg)) == 0);
+
+  // The peer direction is not impaired
+
+  BOOST_REQUIRE_EQUAL(cg_socket_write(peerSock, testMsg, strlen(testMsg)), strlen(testMsg));
+  BOOST_REQUIRE_EQUAL(cg_socket_read(sock, buf, sizeof(buf)), (ssize_t)strlen(testMsg));
+
+  cg_socket_setimpairment(sock, NULL);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+
+  // Datagram pair with loss and reordering
+
+  sock = cg_socket_dgram_new();
+  peerSock = cg_socket_dgram_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+  BOOST_REQUIRE_EQUAL(cg_socket_getaddress(sock), "127.0.0.1");
+  BOOST_REQUIRE(0 < cg_socket_getport(peerSock));
+  BOOST_REQUIRE(cg_socket_settimeout(peerSock, 1));
+
+  cg_socket_impairment_setdelay(imp, 2000);
+  cg_socket_impairment_setloss(imp, 0.3);
+  cg_socket_impairment_setreorder(imp, 0.2);
+  cg_socket_impairment_setseed(imp, 42);
+  cg_socket_setimpairment(sock, imp);
+
+  for (int n = 0; n < CG_TEST_IMPAIRMENT_PKT_CNT; n++) {
+    byte seq = (byte)n;
+    BOOST_REQUIRE_EQUAL(cg_socket_sendto(sock, "127.0.0.1", cg_socket_getport(peerSock), &seq, 1), 1);
+  }
+  cg_test_impairment_waitpending(imp);
+
+  size_t droppedCnt = cg_socket_impairment_getdroppedcount(imp);
+  BOOST_CHECK(0 < droppedCnt);
+  BOOST_CHECK(droppedCnt < CG_TEST_IMPAIRMENT_PKT_CNT);
+  BOOST_CHECK(0 < cg_socket_impairment_getreorderedcount(imp));
+
+  size_t recvCnt = 0;
+  bool isReordered = false;
+  int lastSeq = -1;
+  while (recvCnt < (CG_TEST_IMPAIRMENT_PKT_CNT - droppedCnt)) {
+    if (cg_socket_read(peerSock, buf, sizeof(buf)) != 1)
+      break;
+    if ((byte)buf[0] < lastSeq)
+      isReordered = true;
+    lastSeq = (byte)buf[0];
+    recvCnt++;
+  }
+  BOOST_CHECK_EQUAL(recvCnt, CG_TEST_IMPAIRMENT_PKT_CNT - droppedCnt);
+  BOOST_CHECK(isReordered);
+
+  cg_socket_setimpairment(sock, NULL);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+
+  // A peer which does not read does not hold back the other sockets
+
+  cg_socket_impairment_setdelay(imp, 0);
+  cg_socket_impairment_setloss(imp, 0.0);
+  cg_socket_impairment_setreorder(imp, 0.0);
+
+  CGSocket* slowSock = cg_socket_stream_new();
+  CGSocket* slowPeerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(slowSock, slowPeerSock));
+  int bufSize = 4096;
+  setsockopt(cg_socket_getid(slowSock), SOL_SOCKET, SO_SNDBUF, &bufSize, sizeof(bufSize));
+  setsockopt(cg_socket_getid(slowPeerSock), SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+  cg_socket_setimpairment(slowSock, imp);
+
+  char slowBuf[64 * 1024];
+  memset(slowBuf, 0, sizeof(slowBuf));
+  for (int n = 0; n < 8; n++)
+    BOOST_REQUIRE_EQUAL(cg_socket_write(slowSock, slowBuf, sizeof(slowBuf)), sizeof(slowBuf));
+
+  sock = cg_socket_stream_new();
+  peerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+  BOOST_REQUIRE(cg_socket_settimeout(peerSock, 1));
+  cg_socket_setimpairment(sock, imp);
+  BOOST_REQUIRE_EQUAL(cg_socket_write(sock, testMsg, strlen(testMsg)), strlen(testMsg));
+  BOOST_REQUIRE_EQUAL(cg_socket_read(peerSock, buf, sizeof(buf)), (ssize_t)strlen(testMsg));
+
+  BOOST_REQUIRE(cg_socket_impairment_stop(imp));
+  cg_socket_setimpairment(sock, NULL);
+  cg_socket_setimpairment(slowSock, NULL);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+  cg_socket_delete(slowPeerSock);
+  cg_socket_delete(slowSock);
+  cg_socket_impairment_delete(imp);
+
+  // The queue limit drops datagrams and holds stream writes back
+
+  imp = cg_socket_impairment_new();
+  BOOST_REQUIRE(imp);
+  cg_socket_impairment_setqueuelimit(imp, 64);
+  BOOST_REQUIRE_EQUAL(cg_socket_impairment_getqueuelimit(imp), 64);
+
+  sock = cg_socket_dgram_new();
+  peerSock = cg_socket_dgram_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+  cg_socket_setimpairment(sock, imp);
+  for (int n = 0; n < 4; n++)
+    BOOST_REQUIRE_EQUAL(cg_socket_sendto(sock, "127.0.0.1", cg_socket_getport(peerSock), (const byte*)slowBuf, 32), 32);
+  BOOST_CHECK_EQUAL(cg_socket_impairment_getpendingsize(imp), 2);
+  BOOST_CHECK_EQUAL(cg_socket_impairment_getdroppedcount(imp), 2);
+  cg_socket_setimpairment(sock, NULL);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+
+  sock = cg_socket_stream_new();
+  peerSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_pair(sock, peerSock));
+  cg_socket_setimpairment(sock, imp);
+  BOOST_REQUIRE(cg_socket_setnonblocking(sock, true));
+  BOOST_CHECK_EQUAL(cg_socket_write(sock, slowBuf, 64), 0);
+  cg_socket_setimpairment(sock, NULL);
+  cg_socket_delete(peerSock);
+  cg_socket_delete(sock);
+  cg_socket_impairment_delete(imp);
+}
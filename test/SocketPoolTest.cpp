@@ -0,0 +1,94 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/net/socket_pool.h>
+#include <cgpr/util/time.h>
+
+BOOST_AUTO_TEST_CASE(SocketPoolTest)
+{
+  const char* testAddr = "127.0.0.1";
+  int testPort = 19108;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocketPool* pool = cg_socket_pool_new();
+  BOOST_REQUIRE(pool);
+  cg_socket_pool_setmaxperhost(pool, 2);
+
+  // Warm connections are reused
+
+  CGSocket* sock = cg_socket_pool_checkout(pool, testAddr, testPort, false);
+  BOOST_REQUIRE(sock);
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getbusysize(pool), 1);
+  BOOST_REQUIRE(cg_socket_pool_checkin(pool, sock, true));
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getidlesize(pool), 1);
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getbusysize(pool), 0);
+
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_checkout(pool, testAddr, testPort, false), sock);
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getidlesize(pool), 0);
+
+  // Per-host limit
+
+  CGSocket* sock2 = cg_socket_pool_checkout(pool, testAddr, testPort, false);
+  BOOST_REQUIRE(sock2);
+  BOOST_REQUIRE(sock2 != sock);
+  BOOST_REQUIRE(!cg_socket_pool_checkout(pool, testAddr, testPort, false));
+  BOOST_REQUIRE(cg_socket_pool_checkin(pool, sock2, false));
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getidlesize(pool), 0);
+  CGSocket* acceptSock2 = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock2));
+  cg_socket_delete(acceptSock2);
+
+  // Connections closed by the peer are not handed out
+
+  BOOST_REQUIRE(cg_socket_pool_checkin(pool, sock, true));
+  cg_socket_delete(acceptSock);
+  cg_sleep(50);
+  CGSocket* sock3 = cg_socket_pool_checkout(pool, testAddr, testPort, false);
+  BOOST_REQUIRE(sock3);
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getidlesize(pool), 0);
+  acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+
+  // Idle expiry
+
+  cg_socket_pool_setidletimeout(pool, 20);
+  BOOST_REQUIRE(cg_socket_pool_checkin(pool, sock3, true));
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getidlesize(pool), 1);
+  cg_sleep(50);
+  CGSocket* sock4 = cg_socket_pool_checkout(pool, testAddr, testPort, false);
+  BOOST_REQUIRE(sock4);
+  BOOST_REQUIRE_EQUAL(cg_socket_pool_getidlesize(pool), 0);
+  BOOST_REQUIRE(!cg_socket_pool_checkin(pool, serverSock, true));
+  BOOST_REQUIRE(cg_socket_pool_checkin(pool, sock4, true));
+
+  cg_socket_pool_delete(pool);
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
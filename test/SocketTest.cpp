@@ -18,8 +18,13 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <string.h>
+#include <time.h>
+
 #include <cgpr/net/interface.h>
+#include <cgpr/net/multicast_sender.h>
 #include <cgpr/net/socket.h>
+#include <cgpr/util/time.h>
 
 BOOST_AUTO_TEST_CASE(BindAddrTest)
 {
@@ -63,3 +68,340 @@ BOOST_AUTO_TEST_CASE(BindAddrTest)
 
   cg_net_interfacelist_delete(netIfList);
 }
+
+BOOST_AUTO_TEST_CASE(MulticastPktInfoTest)
+{
+  const char* mcastAddr = "239.255.255.101";
+  const char* mcastMsg = "hello pktinfo";
+  int mcastPort = 19101;
+
+  CGNetworkInterfaceList* netIfList = cg_net_interfacelist_new();
+  BOOST_REQUIRE(0 < cg_net_gethostinterfaces(netIfList));
+
+  // Single receive socket joined on every interface
+
+  CGSocket* sock = cg_socket_dgram_new();
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setreuseaddress(opt, true);
+  BOOST_REQUIRE(cg_socket_bind(sock, mcastPort, "0.0.0.0", opt));
+  BOOST_REQUIRE(cg_socket_setpktinfo(sock, true));
+  BOOST_REQUIRE_EQUAL(cg_socket_joingroups(sock, mcastAddr, netIfList), cg_net_interfacelist_size(netIfList));
+  BOOST_REQUIRE(cg_socket_settimeout(sock, 1));
+
+  CGMulticastSender* sender = cg_multicast_sender_new();
+  BOOST_REQUIRE(cg_multicast_sender_setloop(sender, true));
+  BOOST_REQUIRE(cg_multicast_sender_addinterface(sender, cg_net_interfacelist_gets(netIfList)));
+  BOOST_REQUIRE_EQUAL(cg_multicast_sender_sendto(sender, mcastAddr, mcastPort, (const byte*)mcastMsg, strlen(mcastMsg)), 1);
+
+  CGDatagramPacket* dgmPkt = cg_socket_datagram_packet_new();
+  BOOST_REQUIRE_EQUAL(cg_socket_recv(sock, dgmPkt), (ssize_t)strlen(mcastMsg));
+  BOOST_CHECK(0 < cg_socket_datagram_packet_getifindex(dgmPkt));
+  BOOST_CHECK(cg_streq(cg_socket_datagram_packet_getdestAddr(dgmPkt), mcastAddr));
+  BOOST_CHECK(0 < cg_strlen(cg_socket_datagram_packet_getlocalAddr(dgmPkt)));
+
+  cg_socket_datagram_packet_delete(dgmPkt);
+  cg_multicast_sender_delete(sender);
+  cg_socket_option_delete(opt);
+  cg_socket_delete(sock);
+  cg_net_interfacelist_delete(netIfList);
+}
+
+static uint64_t cg_test_socket_realtime(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+BOOST_AUTO_TEST_CASE(TimestampTest)
+{
+  const char* testAddr = "127.0.0.1";
+  const char* testMsg = "hello timestamp";
+  int testPort = 19102;
+  char buf[64];
+  uint64_t timestamp;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  // Datagram
+
+  CGSocket* recvSock = cg_socket_dgram_new();
+  BOOST_REQUIRE(cg_socket_bind(recvSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_settimestamp(recvSock, true));
+  BOOST_REQUIRE(cg_socket_settimeout(recvSock, 1));
+
+  uint64_t beforeTime = cg_test_socket_realtime();
+  CGSocket* sendSock = cg_socket_dgram_new();
+  BOOST_REQUIRE_EQUAL(cg_socket_sendto(sendSock, testAddr, testPort, (const byte*)testMsg, strlen(testMsg)), strlen(testMsg));
+
+  CGDatagramPacket* dgmPkt = cg_socket_datagram_packet_new();
+  BOOST_REQUIRE_EQUAL(cg_socket_recv(recvSock, dgmPkt), (ssize_t)strlen(testMsg));
+  uint64_t afterTime = cg_test_socket_realtime();
+  BOOST_CHECK(beforeTime <= cg_socket_datagram_packet_gettimestamp(dgmPkt));
+  BOOST_CHECK(cg_socket_datagram_packet_gettimestamp(dgmPkt) <= afterTime);
+
+  cg_socket_datagram_packet_delete(dgmPkt);
+  cg_socket_delete(sendSock);
+  cg_socket_delete(recvSock);
+
+  // Stream
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocket* clientSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_connect(clientSock, testAddr, testPort));
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+  BOOST_REQUIRE(cg_socket_settimestamp(acceptSock, true));
+
+  // The kernel turns timestamping on asynchronously, so the first segments can arrive without a stamp
+
+  timestamp = 0;
+  for (int n = 0; (n < 100) && (timestamp == 0); n++) {
+    beforeTime = cg_test_socket_realtime();
+    BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, testMsg, strlen(testMsg)), strlen(testMsg));
+    BOOST_REQUIRE_EQUAL(cg_socket_readtimestamp(acceptSock, buf, sizeof(buf), &timestamp), (ssize_t)strlen(testMsg));
+    afterTime = cg_test_socket_realtime();
+    if (timestamp == 0)
+      cg_wait(10);
+  }
+  BOOST_CHECK(beforeTime <= timestamp);
+  BOOST_CHECK(timestamp <= afterTime);
+
+  // Without timestamping no time is reported
+
+  BOOST_REQUIRE(cg_socket_settimestamp(acceptSock, false));
+  BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, testMsg, strlen(testMsg)), strlen(testMsg));
+  BOOST_REQUIRE_EQUAL(cg_socket_readtimestamp(acceptSock, buf, sizeof(buf), &timestamp), (ssize_t)strlen(testMsg));
+  BOOST_CHECK_EQUAL(timestamp, 0);
+
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(clientSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
+
+BOOST_AUTO_TEST_CASE(StatsTest)
+{
+  const char* testAddr = "127.0.0.1";
+  const char* testMsg = "hello stats";
+  int testPort = 19103;
+  char buf[64];
+  CGSocketStats stats;
+
+  cg_socket_resetglobalstats();
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocket* clientSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_connect(clientSock, testAddr, testPort));
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+
+  BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, testMsg, strlen(testMsg)), strlen(testMsg));
+  BOOST_REQUIRE_EQUAL(cg_socket_read(acceptSock, buf, sizeof(buf)), (ssize_t)strlen(testMsg));
+
+  cg_socket_getstats(clientSock, &stats);
+  BOOST_CHECK_EQUAL(stats.connectCnt, 1);
+  BOOST_CHECK_EQUAL(stats.connectErrors, 0);
+  BOOST_CHECK_EQUAL(stats.writeCnt, 1);
+  BOOST_CHECK_EQUAL(stats.writeBytes, strlen(testMsg));
+  BOOST_CHECK_EQUAL(stats.writeShortCnt, 0);
+
+  cg_socket_getstats(serverSock, &stats);
+  BOOST_CHECK_EQUAL(stats.acceptCnt, 1);
+
+  cg_socket_getstats(acceptSock, &stats);
+  BOOST_CHECK_EQUAL(stats.readCnt, 1);
+  BOOST_CHECK_EQUAL(stats.readBytes, strlen(testMsg));
+
+  cg_socket_resetstats(acceptSock);
+  cg_socket_getstats(acceptSock, &stats);
+  BOOST_CHECK_EQUAL(stats.readCnt, 0);
+
+  // Truncated datagrams
+
+  CGSocket* recvSock = cg_socket_dgram_new();
+  BOOST_REQUIRE(cg_socket_bind(recvSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_settimeout(recvSock, 1));
+
+  byte bigData[CG_NET_SOCKET_DGRAM_RECV_BUFSIZE + 16];
+  memset(bigData, 'x', sizeof(bigData));
+  CGSocket* sendSock = cg_socket_dgram_new();
+  BOOST_REQUIRE_EQUAL(cg_socket_sendto(sendSock, testAddr, testPort, bigData, sizeof(bigData)), sizeof(bigData));
+
+  CGDatagramPacket* dgmPkt = cg_socket_datagram_packet_new();
+  BOOST_REQUIRE(0 < cg_socket_recv(recvSock, dgmPkt));
+
+  cg_socket_getstats(sendSock, &stats);
+  BOOST_CHECK_EQUAL(stats.sendtoCnt, 1);
+  BOOST_CHECK_EQUAL(stats.sendtoBytes, sizeof(bigData));
+  cg_socket_getstats(recvSock, &stats);
+  BOOST_CHECK_EQUAL(stats.recvCnt, 1);
+  BOOST_CHECK_EQUAL(stats.recvTruncatedCnt, 1);
+
+  cg_socket_getglobalstats(&stats);
+  BOOST_CHECK_EQUAL(stats.connectCnt, 1);
+  BOOST_CHECK_EQUAL(stats.acceptCnt, 1);
+  BOOST_CHECK_EQUAL(stats.readBytes, strlen(testMsg));
+  BOOST_CHECK_EQUAL(stats.writeBytes, strlen(testMsg));
+  BOOST_CHECK_EQUAL(stats.recvTruncatedCnt, 1);
+
+  cg_socket_datagram_packet_delete(dgmPkt);
+  cg_socket_delete(sendSock);
+  cg_socket_delete(recvSock);
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(clientSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
+
+BOOST_AUTO_TEST_CASE(PacingTest)
+{
+  const char* testAddr = "127.0.0.1";
+  int testPort = 19105;
+  byte data[1000];
+  size_t sendCnt = 11;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* recvSock = cg_socket_dgram_new();
+  BOOST_REQUIRE(cg_socket_bind(recvSock, testPort, testAddr, opt));
+
+  // 100 KB/s with a 1000 byte burst: two datagrams go at once, the rest every 10 ms
+
+  CGSocket* sendSock = cg_socket_dgram_new();
+  BOOST_REQUIRE(cg_socket_setpacingrate(sendSock, 100000, sizeof(data)));
+  BOOST_REQUIRE(cg_socket_ispaced(sendSock));
+  BOOST_REQUIRE_EQUAL(cg_socket_getpacingrate(sendSock), 100000);
+
+  memset(data, 0, sizeof(data));
+  uint64_t startTime = cg_getmonotonicnanotime();
+  for (size_t n = 0; n < sendCnt; n++)
+    BOOST_REQUIRE_EQUAL(cg_socket_sendto(sendSock, testAddr, testPort, data, sizeof(data)), sizeof(data));
+  uint64_t elapsedTime = cg_getmonotonicnanotime() - startTime;
+
+  BOOST_CHECK(90000000ULL <= elapsedTime);
+  BOOST_CHECK(elapsedTime < 500000000ULL);
+
+  BOOST_REQUIRE(cg_socket_setpacingrate(sendSock, 0, 0));
+  BOOST_REQUIRE(!cg_socket_ispaced(sendSock));
+
+  cg_socket_delete(sendSock);
+  cg_socket_delete(recvSock);
+  cg_socket_option_delete(opt);
+}
+
+BOOST_AUTO_TEST_CASE(SocketRecycleTest)
+{
+  char longAddr[CG_NET_ADDRSTRING_MAXSIZE * 2];
+
+  CGSocket* sock = cg_socket_dgram_new();
+  BOOST_REQUIRE(sock);
+  BOOST_CHECK_EQUAL(cg_socket_getaddress(sock), "");
+
+  memset(longAddr, 'a', sizeof(longAddr) - 1);
+  longAddr[sizeof(longAddr) - 1] = '\0';
+  cg_socket_setaddress(sock, longAddr);
+  BOOST_CHECK_EQUAL(strlen(cg_socket_getaddress(sock)), (size_t)(CG_NET_ADDRSTRING_MAXSIZE - 1));
+  cg_socket_setaddress(sock, NULL);
+  BOOST_CHECK_EQUAL(cg_socket_getaddress(sock), "");
+
+  cg_socket_setaddress(sock, "127.0.0.1");
+  cg_socket_setport(sock, 19109);
+  sock->stats.readCnt = 1;
+  BOOST_REQUIRE(cg_socket_setpacingrate(sock, 1000, 100));
+
+  // A deleted socket is reused with every field reset
+
+  BOOST_REQUIRE(cg_socket_delete(sock));
+  CGSocket* recycledSock = cg_socket_stream_new();
+  BOOST_REQUIRE(recycledSock);
+  BOOST_CHECK_EQUAL(recycledSock, sock);
+  BOOST_CHECK(cg_socket_issocketstream(recycledSock));
+  BOOST_CHECK(!cg_socket_isbound(recycledSock));
+  BOOST_CHECK_EQUAL(cg_socket_getaddress(recycledSock), "");
+  BOOST_CHECK_EQUAL(cg_socket_getport(recycledSock), -1);
+  BOOST_CHECK_EQUAL(recycledSock->stats.readCnt, 0);
+  BOOST_CHECK(!cg_socket_ispaced(recycledSock));
+
+  cg_socket_delete(recycledSock);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCopyTest)
+{
+  const char* testAddr = "127.0.0.1";
+  int testPort = 19110;
+  const size_t dataLen = 65536;
+  uint64_t sendId;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocket* dgmSock = cg_socket_dgram_new();
+  BOOST_CHECK(!cg_socket_setzerocopy(dgmSock, true, 0));
+  cg_socket_delete(dgmSock);
+
+  // The option is applied when the socket is created by connect
+
+  CGSocket* clientSock = cg_socket_stream_new();
+  bool isZeroCopy = cg_socket_setzerocopy(clientSock, true, 1024);
+  BOOST_REQUIRE(cg_socket_connect(clientSock, testAddr, testPort));
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+  BOOST_REQUIRE(cg_socket_settimeout(acceptSock, 5));
+
+  byte* data = (byte*)malloc(dataLen);
+  char* buf = (char*)malloc(dataLen);
+  for (size_t n = 0; n < dataLen; n++)
+    data[n] = (byte)n;
+
+  // Below the threshold the payload is copied and reusable at once
+
+  BOOST_REQUIRE_EQUAL(cg_socket_writezerocopy(clientSock, data, 512, &sendId), 512);
+  BOOST_CHECK_EQUAL(sendId, 0);
+  BOOST_CHECK(cg_socket_iszerocopycompleted(clientSock, sendId));
+  for (size_t readLen = 0; readLen < 512;)
+    readLen += cg_socket_read(acceptSock, buf + readLen, 512 - readLen);
+
+  BOOST_REQUIRE_EQUAL(cg_socket_writezerocopy(clientSock, data, dataLen, &sendId), dataLen);
+  size_t readLen = 0;
+  while (readLen < dataLen) {
+    ssize_t n = cg_socket_read(acceptSock, buf + readLen, dataLen - readLen);
+    BOOST_REQUIRE(0 < n);
+    readLen += n;
+  }
+  BOOST_CHECK(memcmp(buf, data, dataLen) == 0);
+
+  if (isZeroCopy) {
+    BOOST_CHECK(0 < sendId);
+    BOOST_CHECK(cg_socket_waitzerocopy(clientSock, sendId, 1000));
+    CGSocketStats stats;
+    cg_socket_getstats(clientSock, &stats);
+    BOOST_CHECK(0 < stats.zerocopyCnt);
+  }
+
+  free(buf);
+  free(data);
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(clientSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
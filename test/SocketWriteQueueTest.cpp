@@ -0,0 +1,114 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/net/socket_write_queue.h>
+
+static void cg_test_socket_write_queue_listener(CGSocketWriteQueue* queue, bool isHigh)
+{
+  int* watermarkCnts = (int*)cg_socket_write_queue_getuserdata(queue);
+  watermarkCnts[isHigh ? 1 : 0]++;
+}
+
+BOOST_AUTO_TEST_CASE(SocketWriteQueueTest)
+{
+  const char* testAddr = "127.0.0.1";
+  int testPort = 19107;
+  byte buf[8192];
+  CGSocketStats stats;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocket* clientSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_connect(clientSock, testAddr, testPort));
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+  BOOST_REQUIRE(cg_socket_settimeout(acceptSock, 1));
+  BOOST_REQUIRE(cg_socket_setnonblocking(clientSock, true));
+
+  int watermarkCnts[2] = { 0, 0 };
+  CGSocketWriteQueue* queue = cg_socket_write_queue_new(clientSock);
+  BOOST_REQUIRE(queue);
+  cg_socket_write_queue_setlistener(queue, cg_test_socket_write_queue_listener);
+  cg_socket_write_queue_setuserdata(queue, watermarkCnts);
+
+  // Small writes are coalesced into one send
+
+  for (int n = 0; n < 100; n++)
+    BOOST_REQUIRE(cg_socket_write_queue_enqueue(queue, (const byte*)"0123456789", 10));
+  BOOST_REQUIRE_EQUAL(cg_socket_write_queue_getsize(queue), 1000);
+
+  cg_socket_resetstats(clientSock);
+  BOOST_REQUIRE_EQUAL(cg_socket_write_queue_flush(queue), 1000);
+  BOOST_REQUIRE(cg_socket_write_queue_isempty(queue));
+  cg_socket_getstats(clientSock, &stats);
+  BOOST_CHECK_EQUAL(stats.writeCnt, 1);
+
+  size_t recvLen = 0;
+  while (recvLen < 1000) {
+    ssize_t readLen = cg_socket_read(acceptSock, (char*)buf, 1000 - recvLen);
+    BOOST_REQUIRE(0 < readLen);
+    recvLen += readLen;
+  }
+
+  // Watermarks with more data than the socket buffer takes
+
+  BOOST_REQUIRE(cg_socket_write_queue_setwatermarks(queue, 64 * 1024, 256 * 1024));
+  size_t totalLen = 8 * 1024 * 1024;
+  for (size_t n = 0; n < totalLen; n += sizeof(buf)) {
+    for (size_t i = 0; i < sizeof(buf); i++)
+      buf[i] = (byte)((n + i) % 251);
+    BOOST_REQUIRE(cg_socket_write_queue_enqueue(queue, buf, sizeof(buf)));
+  }
+  BOOST_REQUIRE(cg_socket_write_queue_ishigh(queue));
+  BOOST_REQUIRE_EQUAL(watermarkCnts[1], 1);
+  BOOST_REQUIRE_EQUAL(watermarkCnts[0], 0);
+
+  recvLen = 0;
+  bool isOrdered = true;
+  while (recvLen < totalLen) {
+    BOOST_REQUIRE(0 <= cg_socket_write_queue_flush(queue));
+    ssize_t readLen = cg_socket_read(acceptSock, (char*)buf, sizeof(buf));
+    BOOST_REQUIRE(0 < readLen);
+    for (ssize_t i = 0; i < readLen; i++) {
+      if (buf[i] != (byte)((recvLen + i) % 251))
+        isOrdered = false;
+    }
+    recvLen += readLen;
+  }
+
+  BOOST_CHECK(isOrdered);
+  BOOST_CHECK(cg_socket_write_queue_isempty(queue));
+  BOOST_CHECK(!cg_socket_write_queue_ishigh(queue));
+  BOOST_CHECK_EQUAL(watermarkCnts[0], 1);
+
+  cg_socket_write_queue_delete(queue);
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(clientSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
@@ -0,0 +1,86 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/net/stream_server.h>
+
+#define CG_TEST_STREAM_SERVER_CLIENTS 8
+
+static void cg_test_stream_server_listener(CGStreamServer* server, CGSocket* clientSock)
+{
+  int* handledCnt = (int*)cg_stream_server_getuserdata(server);
+  char buf[64];
+
+  ssize_t readLen = cg_socket_read(clientSock, buf, sizeof(buf));
+  if (0 < readLen)
+    cg_socket_write(clientSock, buf, readLen);
+  __atomic_fetch_add(handledCnt, 1, __ATOMIC_RELAXED);
+}
+
+BOOST_AUTO_TEST_CASE(StreamServerTest)
+{
+  const char* testAddr = "127.0.0.1";
+  const char* testMsg = "hello stream server";
+  int testPort = 19109;
+  CGSocket* clientSocks[CG_TEST_STREAM_SERVER_CLIENTS];
+  char buf[64];
+  int handledCnt = 0;
+
+  CGStreamServer* server = cg_stream_server_new();
+  BOOST_REQUIRE(server);
+  BOOST_REQUIRE(!cg_stream_server_start(server));
+
+  BOOST_REQUIRE(cg_stream_server_open(server, testPort, testAddr));
+  BOOST_REQUIRE_EQUAL(cg_stream_server_getport(server), testPort);
+  cg_stream_server_setworkercount(server, 2);
+  cg_stream_server_setacceptbatch(server, 4);
+  cg_stream_server_setlistener(server, cg_test_stream_server_listener);
+  cg_stream_server_setuserdata(server, &handledCnt);
+  BOOST_REQUIRE(cg_stream_server_start(server));
+  BOOST_REQUIRE(cg_stream_server_isrunning(server));
+
+  // Connect all clients first so that the listener backlog is drained in batches
+
+  for (int n = 0; n < CG_TEST_STREAM_SERVER_CLIENTS; n++) {
+    clientSocks[n] = cg_socket_stream_new();
+    BOOST_REQUIRE(cg_socket_connect(clientSocks[n], testAddr, testPort));
+    BOOST_REQUIRE(cg_socket_settimeout(clientSocks[n], 5));
+  }
+
+  for (int n = 0; n < CG_TEST_STREAM_SERVER_CLIENTS; n++) {
+    BOOST_REQUIRE_EQUAL(cg_socket_write(clientSocks[n], testMsg, strlen(testMsg)), strlen(testMsg));
+    BOOST_REQUIRE_EQUAL(cg_socket_read(clientSocks[n], buf, sizeof(buf)), (ssize_t)strlen(testMsg));
+    BOOST_CHECK(memcmp(buf, testMsg, strlen(testMsg)) == 0);
+  }
+
+  BOOST_REQUIRE(cg_stream_server_stop(server));
+  BOOST_REQUIRE(!cg_stream_server_isrunning(server));
+  BOOST_CHECK_EQUAL(handledCnt, CG_TEST_STREAM_SERVER_CLIENTS);
+
+  CGSocketStats stats;
+  cg_socket_getstats(cg_stream_server_getsocket(server), &stats);
+  BOOST_CHECK_EQUAL(stats.acceptCnt - stats.acceptErrors, (uint64_t)CG_TEST_STREAM_SERVER_CLIENTS);
+
+  for (int n = 0; n < CG_TEST_STREAM_SERVER_CLIENTS; n++)
+    cg_socket_delete(clientSocks[n]);
+  cg_stream_server_delete(server);
+}
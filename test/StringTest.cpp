@@ -68,3 +68,23 @@ BOOST_AUTO_TEST_CASE(StringTest)
   cg_ssizet2str(CG_TESTCASE_UINTVALUE, buf, sizeof(buf));
   BOOST_REQUIRE(cg_streq(buf, CG_TESTCASE_UINTVALUE_STRING));
 }
+
+BOOST_AUTO_TEST_CASE(StringReplaceTest)
+{
+  char* fromStr[] = { (char*)"&", (char*)"<" };
+  char* toStr[] = { (char*)"&amp;", (char*)"&lt;" };
+
+  CGString* str = cg_string_new();
+  cg_string_setvalue(str, "a<b & c<d");
+  BOOST_REQUIRE(cg_streq(cg_string_replace(str, fromStr, toStr, 2), "a&lt;b &amp; c&lt;d"));
+  BOOST_REQUIRE_EQUAL(cg_string_length(str), cg_strlen("a&lt;b &amp; c&lt;d"));
+
+  // A shorter value reuses the current buffer
+
+  char* value = cg_string_getvalue(str);
+  cg_string_setvalue(str, "x<y");
+  BOOST_REQUIRE_EQUAL(cg_string_getvalue(str), value);
+  BOOST_REQUIRE(cg_streq(cg_string_replace(str, fromStr, toStr, 2), "x&lt;y"));
+
+  cg_string_delete(str);
+}
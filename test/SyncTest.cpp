@@ -0,0 +1,197 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/sync.h>
+#include <cgpr/util/thread.h>
+
+#define CG_TEST_SYNC_THREAD_NUM 4
+#define CG_TEST_SYNC_ROUND_NUM 100
+#define CG_TEST_SYNC_WAIT 10000
+
+typedef struct {
+  CGEvent* startEvent;
+  CGSemaphore* sem;
+  CGBarrier* barrier;
+  CGWaitGroup* wg;
+  int counter;
+  int serialCnt;
+  int roundErrors;
+} CGTestSyncData;
+
+static CGThreadList* cg_test_sync_startthreads(CG_THREAD_FUNC func, CGTestSyncData* data)
+{
+  CGThreadList* threads = cg_threadlist_new();
+  for (int n = 0; n < CG_TEST_SYNC_THREAD_NUM; n++) {
+    CGThread* thread = cg_thread_new();
+    cg_thread_setaction(thread, func);
+    cg_thread_setuserdata(thread, data);
+    cg_thread_setjoinable(thread, true);
+    cg_threadlist_add(threads, thread);
+  }
+  BOOST_REQUIRE(cg_threadlist_start(threads));
+  return threads;
+}
+
+static void cg_test_sync_jointhreads(CGThreadList* threads)
+{
+  for (CGThread* thread = cg_threadlist_gets(threads); thread; thread = cg_thread_next(thread))
+    BOOST_REQUIRE(cg_thread_join(thread, CG_TEST_SYNC_WAIT));
+  cg_threadlist_delete(threads);
+}
+
+void cg_test_sync_event_func(CGThread* thread)
+{
+  CGTestSyncData* data = (CGTestSyncData*)cg_thread_getuserdata(thread);
+  if (cg_event_timedwait(data->startEvent, CG_TEST_SYNC_WAIT))
+    cg_atomic_inc(&data->counter);
+  cg_waitgroup_done(data->wg);
+}
+
+void cg_test_sync_semaphore_func(CGThread* thread)
+{
+  CGTestSyncData* data = (CGTestSyncData*)cg_thread_getuserdata(thread);
+  if (cg_semaphore_timedwait(data->sem, CG_TEST_SYNC_WAIT))
+    cg_atomic_inc(&data->counter);
+  cg_waitgroup_done(data->wg);
+}
+
+void cg_test_sync_barrier_func(CGThread* thread)
+{
+  CGTestSyncData* data = (CGTestSyncData*)cg_thread_getuserdata(thread);
+  for (int n = 0; n < CG_TEST_SYNC_ROUND_NUM; n++) {
+    cg_atomic_inc(&data->counter);
+    if (cg_barrier_wait(data->barrier))
+      cg_atomic_inc(&data->serialCnt);
+    // Every thread of the round has arrived once the barrier opens
+    if (cg_atomic_load(&data->counter, CG_ATOMIC_SEQ_CST) < ((n + 1) * CG_TEST_SYNC_THREAD_NUM))
+      cg_atomic_inc(&data->roundErrors);
+    cg_barrier_wait(data->barrier);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(EventTest)
+{
+  CGEvent* ev = cg_event_new(false);
+  BOOST_REQUIRE(ev);
+  BOOST_REQUIRE(!cg_event_ismanualreset(ev));
+  BOOST_REQUIRE(!cg_event_timedwait(ev, 10));
+
+  // An auto reset event releases one waiter
+
+  BOOST_REQUIRE(cg_event_set(ev));
+  BOOST_REQUIRE(cg_event_isset(ev));
+  BOOST_REQUIRE(cg_event_timedwait(ev, 10));
+  BOOST_REQUIRE(!cg_event_isset(ev));
+  BOOST_REQUIRE(!cg_event_timedwait(ev, 10));
+  BOOST_REQUIRE(cg_event_delete(ev));
+
+  // A manual reset event releases every waiter until it is reset
+
+  CGTestSyncData data = {};
+  data.startEvent = cg_event_new(true);
+  data.wg = cg_waitgroup_new();
+  BOOST_REQUIRE(cg_waitgroup_add(data.wg, CG_TEST_SYNC_THREAD_NUM));
+  CGThreadList* threads = cg_test_sync_startthreads(cg_test_sync_event_func, &data);
+  cg_wait(20);
+  BOOST_REQUIRE_EQUAL(cg_atomic_load(&data.counter, CG_ATOMIC_ACQUIRE), 0);
+  BOOST_REQUIRE(cg_event_set(data.startEvent));
+  BOOST_REQUIRE(cg_waitgroup_timedwait(data.wg, CG_TEST_SYNC_WAIT));
+  BOOST_REQUIRE_EQUAL(cg_atomic_load(&data.counter, CG_ATOMIC_ACQUIRE), CG_TEST_SYNC_THREAD_NUM);
+  cg_test_sync_jointhreads(threads);
+
+  BOOST_REQUIRE(cg_event_wait(data.startEvent));
+  BOOST_REQUIRE(cg_event_reset(data.startEvent));
+  BOOST_REQUIRE(!cg_event_timedwait(data.startEvent, 10));
+
+  cg_event_delete(data.startEvent);
+  cg_waitgroup_delete(data.wg);
+}
+
+BOOST_AUTO_TEST_CASE(SemaphoreTest)
+{
+  CGSemaphore* sem = cg_semaphore_new(2);
+  BOOST_REQUIRE(sem);
+  BOOST_REQUIRE(cg_semaphore_trywait(sem));
+  BOOST_REQUIRE(cg_semaphore_wait(sem));
+  BOOST_REQUIRE(!cg_semaphore_trywait(sem));
+  BOOST_REQUIRE(!cg_semaphore_timedwait(sem, 10));
+  BOOST_REQUIRE(!cg_semaphore_post(sem, 0));
+  BOOST_REQUIRE(cg_semaphore_delete(sem));
+
+  // Every post releases one waiter
+
+  CGTestSyncData data = {};
+  data.sem = cg_semaphore_new(0);
+  data.wg = cg_waitgroup_new();
+  BOOST_REQUIRE(cg_waitgroup_add(data.wg, CG_TEST_SYNC_THREAD_NUM));
+  CGThreadList* threads = cg_test_sync_startthreads(cg_test_sync_semaphore_func, &data);
+  BOOST_REQUIRE(cg_semaphore_post(data.sem, 1));
+  BOOST_REQUIRE(cg_semaphore_post(data.sem, CG_TEST_SYNC_THREAD_NUM - 1));
+  BOOST_REQUIRE(cg_waitgroup_wait(data.wg));
+  BOOST_REQUIRE_EQUAL(cg_atomic_load(&data.counter, CG_ATOMIC_ACQUIRE), CG_TEST_SYNC_THREAD_NUM);
+  BOOST_REQUIRE_EQUAL(cg_semaphore_getcount(data.sem), 0);
+  cg_test_sync_jointhreads(threads);
+
+  cg_semaphore_delete(data.sem);
+  cg_waitgroup_delete(data.wg);
+}
+
+BOOST_AUTO_TEST_CASE(BarrierTest)
+{
+  BOOST_REQUIRE(!cg_barrier_new(0));
+
+  CGBarrier* barrier = cg_barrier_new(1);
+  BOOST_REQUIRE(barrier);
+  BOOST_REQUIRE(cg_barrier_wait(barrier));
+  BOOST_REQUIRE(cg_barrier_wait(barrier));
+  BOOST_REQUIRE(cg_barrier_delete(barrier));
+
+  // The barrier is reused for many rounds with one serial thread per round
+
+  CGTestSyncData data = {};
+  data.barrier = cg_barrier_new(CG_TEST_SYNC_THREAD_NUM);
+  BOOST_REQUIRE_EQUAL(cg_barrier_getthreshold(data.barrier), CG_TEST_SYNC_THREAD_NUM);
+  CGThreadList* threads = cg_test_sync_startthreads(cg_test_sync_barrier_func, &data);
+  cg_test_sync_jointhreads(threads);
+
+  BOOST_REQUIRE_EQUAL(data.counter, CG_TEST_SYNC_THREAD_NUM * CG_TEST_SYNC_ROUND_NUM);
+  BOOST_REQUIRE_EQUAL(data.serialCnt, CG_TEST_SYNC_ROUND_NUM);
+  BOOST_REQUIRE_EQUAL(data.roundErrors, 0);
+
+  cg_barrier_delete(data.barrier);
+}
+
+BOOST_AUTO_TEST_CASE(WaitGroupTest)
+{
+  CGWaitGroup* wg = cg_waitgroup_new();
+  BOOST_REQUIRE(wg);
+  BOOST_REQUIRE(cg_waitgroup_wait(wg));
+  BOOST_REQUIRE(!cg_waitgroup_done(wg));
+
+  BOOST_REQUIRE(cg_waitgroup_add(wg, 2));
+  BOOST_REQUIRE_EQUAL(cg_waitgroup_getcount(wg), 2);
+  BOOST_REQUIRE(!cg_waitgroup_timedwait(wg, 10));
+  BOOST_REQUIRE(cg_waitgroup_done(wg));
+  BOOST_REQUIRE(cg_waitgroup_done(wg));
+  BOOST_REQUIRE(cg_waitgroup_timedwait(wg, 10));
+  BOOST_REQUIRE(cg_waitgroup_delete(wg));
+}
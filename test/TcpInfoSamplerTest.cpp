@@ -0,0 +1,102 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+#include <cgpr/net/tcpinfo_sampler.h>
+#include <cgpr/util/_atomic.h>
+#include <cgpr/util/time.h>
+
+static void cg_test_tcpinfo_sampler_listener(CGTcpInfoSampler* sampler, CGSocket* sock, CGSocketTcpInfo* info)
+{
+  int* sampledCnt = (int*)cg_tcpinfo_sampler_getuserdata(sampler);
+  cg_atomic_inc(sampledCnt);
+}
+
+BOOST_AUTO_TEST_CASE(TcpInfoSamplerTest)
+{
+  const char* testAddr = "127.0.0.1";
+  const char* testMsg = "hello tcpinfo";
+  int testPort = 19104;
+  char buf[64];
+  CGSocketTcpInfo info;
+
+  CGSocketOption* opt = cg_socket_option_new();
+  cg_socket_option_setbindinterface(opt, true);
+  cg_socket_option_setreuseaddress(opt, true);
+
+  CGSocket* serverSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_bind(serverSock, testPort, testAddr, opt));
+  BOOST_REQUIRE(cg_socket_listen(serverSock));
+
+  CGSocket* clientSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_connect(clientSock, testAddr, testPort));
+  CGSocket* acceptSock = cg_socket_stream_new();
+  BOOST_REQUIRE(cg_socket_accept(serverSock, acceptSock));
+
+  BOOST_REQUIRE_EQUAL(cg_socket_write(clientSock, testMsg, strlen(testMsg)), strlen(testMsg));
+  BOOST_REQUIRE_EQUAL(cg_socket_read(acceptSock, buf, sizeof(buf)), (ssize_t)strlen(testMsg));
+
+#if defined(__linux__)
+  BOOST_REQUIRE(cg_socket_gettcpinfo(clientSock, &info));
+  BOOST_CHECK(0 < info.sndCwnd);
+  BOOST_CHECK(0 < info.sndMss);
+  BOOST_CHECK_EQUAL(info.unacked, 0);
+  BOOST_CHECK_EQUAL(info.totalRetrans, 0);
+#endif
+
+  CGSocket* dgmSock = cg_socket_dgram_new();
+  BOOST_CHECK(!cg_socket_gettcpinfo(dgmSock, &info));
+  cg_socket_delete(dgmSock);
+
+  // Sampler
+
+  int sampledCnt = 0;
+  CGTcpInfoSampler* sampler = cg_tcpinfo_sampler_new();
+  cg_tcpinfo_sampler_setlistener(sampler, cg_test_tcpinfo_sampler_listener);
+  cg_tcpinfo_sampler_setuserdata(sampler, &sampledCnt);
+  cg_tcpinfo_sampler_setinterval(sampler, 50);
+  BOOST_REQUIRE(cg_tcpinfo_sampler_addsocket(sampler, clientSock));
+  BOOST_REQUIRE(cg_tcpinfo_sampler_addsocket(sampler, acceptSock));
+  BOOST_REQUIRE(cg_tcpinfo_sampler_addsocket(sampler, acceptSock));
+  BOOST_REQUIRE_EQUAL(cg_tcpinfo_sampler_size(sampler), 2);
+
+#if defined(__linux__)
+  BOOST_REQUIRE_EQUAL(cg_tcpinfo_sampler_sample(sampler), 2);
+  BOOST_REQUIRE_EQUAL(cg_atomic_load(&sampledCnt, CG_ATOMIC_ACQUIRE), 2);
+
+  BOOST_REQUIRE(cg_tcpinfo_sampler_start(sampler));
+  BOOST_REQUIRE(cg_tcpinfo_sampler_isrunning(sampler));
+  for (int n = 0; (n < 100) && (cg_atomic_load(&sampledCnt, CG_ATOMIC_ACQUIRE) < 8); n++)
+    cg_sleep(20);
+  BOOST_REQUIRE(cg_tcpinfo_sampler_stop(sampler));
+  BOOST_CHECK(8 <= cg_atomic_load(&sampledCnt, CG_ATOMIC_ACQUIRE));
+#endif
+
+  BOOST_REQUIRE(cg_tcpinfo_sampler_removesocket(sampler, clientSock));
+  BOOST_REQUIRE(!cg_tcpinfo_sampler_removesocket(sampler, clientSock));
+  BOOST_REQUIRE_EQUAL(cg_tcpinfo_sampler_size(sampler), 1);
+
+  cg_tcpinfo_sampler_delete(sampler);
+  cg_socket_delete(acceptSock);
+  cg_socket_delete(clientSock);
+  cg_socket_delete(serverSock);
+  cg_socket_option_delete(opt);
+}
@@ -0,0 +1,121 @@
+/******************************************************************
+ *
+ * Copyright (C) 2025 The Cyber Garage Portable Runtime for C Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cgpr/util/thread_pool.h>
+
+#define CG_TEST_THREAD_POOL_TASK_CNT 10000
+#define CG_TEST_THREAD_POOL_CHILD_CNT 300
+#define CG_TEST_THREAD_POOL_MANY_WORKER_CNT 100
+
+typedef struct {
+  CGThreadPool* pool;
+  int counter;
+} CGTestThreadPoolContext;
+
+static void cg_test_thread_pool_inc(void* userData)
+{
+  CGTestThreadPoolContext* ctx = (CGTestThreadPoolContext*)userData;
+  __atomic_fetch_add(&ctx->counter, 1, __ATOMIC_RELAXED);
+}
+
+static void cg_test_thread_pool_spawn(void* userData)
+{
+  CGTestThreadPoolContext* ctx = (CGTestThreadPoolContext*)userData;
+  for (int n = 0; n < CG_TEST_THREAD_POOL_CHILD_CNT; n++)
+    cg_thread_pool_submit(ctx->pool, cg_test_thread_pool_inc, ctx);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolTest)
+{
+  CGThreadPool* pool = cg_thread_pool_new(0);
+  BOOST_REQUIRE(pool);
+  BOOST_REQUIRE(0 < cg_thread_pool_getworkercount(pool));
+  cg_thread_pool_delete(pool);
+
+  pool = cg_thread_pool_new(4);
+  BOOST_REQUIRE(pool);
+  BOOST_REQUIRE_EQUAL(cg_thread_pool_getworkercount(pool), 4);
+
+  CGTestThreadPoolContext ctx;
+  ctx.pool = pool;
+  ctx.counter = 0;
+  BOOST_REQUIRE(!cg_thread_pool_submit(pool, cg_test_thread_pool_inc, &ctx));
+
+  BOOST_REQUIRE(cg_thread_pool_start(pool));
+  BOOST_REQUIRE(cg_thread_pool_isrunning(pool));
+
+  // Tasks from an external thread
+
+  for (int n = 0; n < CG_TEST_THREAD_POOL_TASK_CNT; n++)
+    BOOST_REQUIRE(cg_thread_pool_submit(pool, cg_test_thread_pool_inc, &ctx));
+  cg_thread_pool_wait(pool);
+  BOOST_REQUIRE_EQUAL(ctx.counter, CG_TEST_THREAD_POOL_TASK_CNT);
+  BOOST_REQUIRE_EQUAL(cg_thread_pool_getpendingcount(pool), 0);
+
+  // Tasks from workers go to their own deques and are stolen by the others
+
+  ctx.counter = 0;
+  for (int n = 0; n < CG_TEST_THREAD_POOL_CHILD_CNT; n++)
+    BOOST_REQUIRE(cg_thread_pool_submit(pool, cg_test_thread_pool_spawn, &ctx));
+  cg_thread_pool_wait(pool);
+  BOOST_REQUIRE_EQUAL(ctx.counter, CG_TEST_THREAD_POOL_CHILD_CNT * CG_TEST_THREAD_POOL_CHILD_CNT);
+
+  // Stop drains the queued tasks
+
+  ctx.counter = 0;
+  for (int n = 0; n < CG_TEST_THREAD_POOL_TASK_CNT; n++)
+    BOOST_REQUIRE(cg_thread_pool_submit(pool, cg_test_thread_pool_inc, &ctx));
+  BOOST_REQUIRE(cg_thread_pool_stop(pool));
+  BOOST_REQUIRE(!cg_thread_pool_isrunning(pool));
+  BOOST_REQUIRE_EQUAL(ctx.counter, CG_TEST_THREAD_POOL_TASK_CNT);
+  BOOST_REQUIRE(!cg_thread_pool_submit(pool, cg_test_thread_pool_inc, &ctx));
+
+  // The pool can be restarted with the workers pinned one per core
+
+  cg_thread_pool_setcorepinned(pool, true);
+  BOOST_REQUIRE(cg_thread_pool_iscorepinned(pool));
+  BOOST_REQUIRE(cg_thread_pool_start(pool));
+  BOOST_REQUIRE(cg_thread_pool_submit(pool, cg_test_thread_pool_inc, &ctx));
+  cg_thread_pool_wait(pool);
+  BOOST_REQUIRE_EQUAL(ctx.counter, CG_TEST_THREAD_POOL_TASK_CNT + 1);
+
+  cg_thread_pool_delete(pool);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolManyWorkersTest)
+{
+  // More sleeping workers than the wake bytes written at once
+
+  CGThreadPool* pool = cg_thread_pool_new(CG_TEST_THREAD_POOL_MANY_WORKER_CNT);
+  BOOST_REQUIRE(pool);
+  BOOST_REQUIRE(cg_thread_pool_start(pool));
+
+  CGTestThreadPoolContext ctx;
+  ctx.pool = pool;
+  ctx.counter = 0;
+  for (int n = 0; n < CG_TEST_THREAD_POOL_TASK_CNT; n++)
+    BOOST_REQUIRE(cg_thread_pool_submit(pool, cg_test_thread_pool_inc, &ctx));
+  cg_thread_pool_wait(pool);
+  BOOST_REQUIRE_EQUAL(ctx.counter, CG_TEST_THREAD_POOL_TASK_CNT);
+
+  BOOST_REQUIRE(cg_thread_pool_stop(pool));
+  cg_thread_pool_delete(pool);
+}
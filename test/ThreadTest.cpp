@@ -49,3 +49,156 @@ BOOST_AUTO_TEST_CASE(ThreadTest)
 
   cg_thread_delete(thread);
 }
+
+#define CG_THREAD_TEST_STOP_WAIT 10000
+#define CG_THREAD_TEST_STOP_MAX_NSEC 1000000000
+#define CG_THREAD_TEST_LIST_SIZE 8
+
+void cg_test_thread_waitstop_func(CGThread* thread)
+{
+  while (!cg_thread_waitstop(thread, CG_THREAD_TEST_STOP_WAIT))
+    ;
+}
+
+BOOST_AUTO_TEST_CASE(ThreadJoinTest)
+{
+  CGThread* thread = cg_thread_new();
+  cg_thread_setaction(thread, cg_test_thread_waitstop_func);
+  cg_thread_setjoinable(thread, true);
+  BOOST_REQUIRE(cg_thread_isjoinable(thread));
+
+  // A sleeping thread is woken by its stop token
+
+  for (int n = 0; n < 2; n++) {
+    BOOST_REQUIRE(cg_thread_start(thread));
+    cg_wait(50);
+    uint64_t startTime = cg_getmonotonicnanotime();
+    BOOST_REQUIRE(cg_thread_stop(thread));
+    BOOST_CHECK((cg_getmonotonicnanotime() - startTime) < CG_THREAD_TEST_STOP_MAX_NSEC);
+  }
+
+  cg_thread_delete(thread);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadListStopTest)
+{
+  CGThreadList* threadList = cg_threadlist_new();
+  for (int n = 0; n < CG_THREAD_TEST_LIST_SIZE; n++) {
+    CGThread* thread = cg_thread_new();
+    cg_thread_setaction(thread, cg_test_thread_waitstop_func);
+    cg_thread_setjoinable(thread, (n % 2) ? true : false);
+    cg_threadlist_add(threadList, thread);
+  }
+
+  BOOST_REQUIRE(cg_threadlist_start(threadList));
+  cg_wait(50);
+
+  // All threads are stopped together instead of one after another
+
+  uint64_t startTime = cg_getmonotonicnanotime();
+  BOOST_REQUIRE(cg_threadlist_stop(threadList));
+  BOOST_CHECK((cg_getmonotonicnanotime() - startTime) < CG_THREAD_TEST_STOP_MAX_NSEC);
+
+  cg_threadlist_delete(threadList);
+}
+
+void cg_test_thread_cpu_func(CGThread* thread)
+{
+  int* cpu = (int*)cg_thread_getuserdata(thread);
+  *cpu = cg_cpu_getcurrent();
+}
+
+BOOST_AUTO_TEST_CASE(ThreadAffinityTest)
+{
+  CGCpuTopology* topology = cg_cpu_topology_new();
+  BOOST_REQUIRE(topology);
+  int pinnedCpu = cg_cpu_topology_getcpu(topology, cg_cpu_topology_size(topology) - 1)->cpu;
+  cg_cpu_topology_delete(topology);
+
+  // Placement set before the start is applied on creation
+
+  int currentCpu = -1;
+  CGThread* thread = cg_thread_new();
+  cg_thread_setaction(thread, cg_test_thread_cpu_func);
+  cg_thread_setuserdata(thread, &currentCpu);
+  cg_thread_setjoinable(thread, true);
+  BOOST_REQUIRE(cg_thread_setcpu(thread, pinnedCpu));
+  BOOST_REQUIRE(cg_thread_setnice(thread, 1));
+  BOOST_REQUIRE_EQUAL(cg_thread_getnice(thread), 1);
+  BOOST_REQUIRE(!cg_thread_setschedpolicy(thread, CG_THREAD_SCHED_FIFO, 1000));
+  BOOST_REQUIRE_EQUAL(cg_thread_getschedpolicy(thread), CG_THREAD_SCHED_OTHER);
+
+  BOOST_REQUIRE(cg_thread_start(thread));
+  BOOST_REQUIRE(cg_thread_join(thread, CG_THREAD_MIN_SLEEP));
+  BOOST_REQUIRE_EQUAL(currentCpu, pinnedCpu);
+
+  CGCpuSet cpuSet;
+  BOOST_REQUIRE(cg_thread_getaffinity(thread, &cpuSet));
+  BOOST_REQUIRE_EQUAL(cg_cpuset_size(&cpuSet), 1);
+  BOOST_REQUIRE(cg_cpuset_contains(&cpuSet, pinnedCpu));
+
+  BOOST_REQUIRE(cg_thread_setaffinity(thread, NULL));
+  BOOST_REQUIRE(cg_thread_getaffinity(thread, &cpuSet));
+  BOOST_REQUIRE(0 < cg_cpuset_size(&cpuSet));
+
+  cg_thread_delete(thread);
+
+  // Placement can also be changed while the thread runs
+
+  thread = cg_thread_new();
+  cg_thread_setaction(thread, cg_test_thread_waitstop_func);
+  cg_thread_setjoinable(thread, true);
+  BOOST_REQUIRE(cg_thread_start(thread));
+  BOOST_REQUIRE(cg_thread_setcpu(thread, pinnedCpu));
+  BOOST_REQUIRE(cg_thread_getaffinity(thread, &cpuSet));
+  BOOST_REQUIRE_EQUAL(cg_cpuset_size(&cpuSet), 1);
+  BOOST_REQUIRE(cg_thread_setnice(thread, 2));
+  BOOST_REQUIRE(cg_thread_setschedpolicy(thread, CG_THREAD_SCHED_OTHER, 0));
+  BOOST_REQUIRE(cg_thread_stop(thread));
+  cg_thread_delete(thread);
+}
+
+static int cg_test_thread_key_destructor_cnt = 0;
+
+static void cg_test_thread_key_destructor(void* value)
+{
+  cg_test_thread_key_destructor_cnt += *(int*)value;
+}
+
+void cg_test_thread_key_func(CGThread* thread)
+{
+  CGThreadKey* key = (CGThreadKey*)cg_thread_getuserdata(thread);
+  static int threadValue = 1;
+  if (cg_thread_key_getvalue(key) == NULL)
+    cg_thread_key_setvalue(key, &threadValue);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadKeyTest)
+{
+  CGThreadKey* key = cg_thread_key_new(cg_test_thread_key_destructor);
+  BOOST_REQUIRE(key);
+
+  int mainValue = 100;
+  BOOST_REQUIRE(!cg_thread_key_getvalue(key));
+  BOOST_REQUIRE(cg_thread_key_setvalue(key, &mainValue));
+  BOOST_REQUIRE_EQUAL(cg_thread_key_getvalue(key), &mainValue);
+
+  // Every exiting thread runs the destructor with its own value
+
+  cg_test_thread_key_destructor_cnt = 0;
+  for (int n = 0; n < 2; n++) {
+    CGThread* thread = cg_thread_new();
+    cg_thread_setaction(thread, cg_test_thread_key_func);
+    cg_thread_setuserdata(thread, key);
+    cg_thread_setjoinable(thread, true);
+    BOOST_REQUIRE(cg_thread_start(thread));
+    BOOST_REQUIRE(cg_thread_join(thread, CG_THREAD_TEST_STOP_WAIT));
+    cg_thread_delete(thread);
+  }
+  BOOST_CHECK_EQUAL(cg_test_thread_key_destructor_cnt, 2);
+
+  BOOST_REQUIRE_EQUAL(cg_thread_key_getvalue(key), &mainValue);
+  BOOST_REQUIRE(cg_thread_key_setvalue(key, NULL));
+
+  cg_thread_key_delete(key);
+}